@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "utils/ArrayExpressions.h"
+#include "utils/ArrayUtils.h"
+
+namespace {
+using Vector = std::array<double, 3>;
+constexpr double dt = 0.0005;
+
+/**
+ * @brief Positions, velocities, forces and masses of a 22^3 lattice, stored as in Particle
+ */
+struct Arrays {
+  std::vector<Vector> x, v, f;
+  std::vector<double> m;
+
+  Arrays() {
+    for (const auto& p : benchmarkUtils::makeLattice(22)) {
+      x.push_back(p.getX());
+      v.push_back(p.getV());
+      f.push_back({p.getX()[1], p.getX()[2], p.getX()[0]});
+      m.push_back(p.getM());
+    }
+  }
+};
+}  // namespace
+
+// Störmer-Verlet position update x + dt * v + dt^2 / 2m * f, each operator returns a new array
+static void BM_PositionUpdateOperators(benchmark::State& state) {
+  Arrays arrays;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < arrays.x.size(); i++) {
+      arrays.x[i] = arrays.x[i] + dt * arrays.v[i] + (dt * dt / (2 * arrays.m[i])) * arrays.f[i];
+    }
+    benchmark::DoNotOptimize(arrays.x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays.x.size()));
+}
+
+// The same update as one fused expression
+static void BM_PositionUpdateExpressions(benchmark::State& state) {
+  using ArrayUtils::view;
+  Arrays arrays;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < arrays.x.size(); i++) {
+      const double scale = dt * dt / (2 * arrays.m[i]);
+      ArrayUtils::assign(arrays.x[i], view(arrays.x[i]) + dt * view(arrays.v[i]) + scale * view(arrays.f[i]));
+    }
+    benchmark::DoNotOptimize(arrays.x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays.x.size()));
+}
+
+// The same update as hand-written loop, the expressions should match its time
+static void BM_PositionUpdateLoop(benchmark::State& state) {
+  Arrays arrays;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < arrays.x.size(); i++) {
+      const double scale = dt * dt / (2 * arrays.m[i]);
+      for (std::size_t d = 0; d < 3; d++) {
+        arrays.x[i][d] = arrays.x[i][d] + dt * arrays.v[i][d] + scale * arrays.f[i][d];
+      }
+    }
+    benchmark::DoNotOptimize(arrays.x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays.x.size()));
+}
+
+BENCHMARK(BM_PositionUpdateOperators)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PositionUpdateExpressions)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PositionUpdateLoop)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,38 @@
+/**
+ * @file BenchmarkUtils.h
+ *
+ * Shared particle setups for the micro benchmarks.
+ */
+
+#pragma once
+
+#include <random>
+
+#include "ParticleContainer.h"
+
+namespace benchmarkUtils {
+
+/**
+ * @brief Creates a cubic lattice of n^3 unit mass particles with a small random displacement.
+ * @param n Number of particles per dimension
+ * @param h Lattice spacing, 1.1225 is the Lennard-Jones equilibrium distance for sigma = 1
+ * @param nz Number of particles in z direction, n if negative
+ */
+inline ParticleContainer makeLattice(int n, double h = 1.1225, int nz = -1) {
+  std::default_random_engine engine(42);
+  std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+  ParticleContainer particles;
+  nz = nz < 0 ? n : nz;
+  particles.reserve(static_cast<std::size_t>(n) * n * nz);
+  for (int x = 0; x < n; x++) {
+    for (int y = 0; y < n; y++) {
+      for (int z = 0; z < nz; z++) {
+        particles.addParticle({h * x + jitter(engine), h * y + jitter(engine), h * z + jitter(engine)},
+                              {jitter(engine), jitter(engine), jitter(engine)}, 1.0);
+      }
+    }
+  }
+  return particles;
+}
+
+}  // namespace benchmarkUtils
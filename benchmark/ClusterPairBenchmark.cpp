@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkUtils.h"
+#include "ForceCalc.h"
+#include "LennardJonesForceClusterPair.h"
+
+namespace {
+constexpr double epsilon = 5.0;
+constexpr double sigma = 1.0;
+constexpr double cutoffRadius = 2.5;
+}  // namespace
+
+// Reference: the plain pair loop, argument: lattice edge length
+static void BM_PairLoop(benchmark::State& state) {
+  auto particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  LennardJonesForce force(particles, epsilon, sigma, cutoffRadius);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  state.counters["particles"] = static_cast<double>(particles.size());
+}
+BENCHMARK(BM_PairLoop)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMillisecond);
+
+// Cluster pair kernel with a cluster pair list that stays valid, argument: lattice edge length
+template <std::size_t ClusterSize>
+static void BM_ClusterPair(benchmark::State& state) {
+  auto particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  LennardJonesForceClusterPair<ClusterSize> force(particles, MixingTable(epsilon, sigma), cutoffRadius);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  state.counters["particles"] = static_cast<double>(particles.size());
+  state.counters["rebuilds"] = static_cast<double>(force.getRebuilds());
+}
+BENCHMARK(BM_ClusterPair<4>)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClusterPair<8>)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "BenchmarkUtils.h"
+#include "ForceCalc.h"
+#include "Integrator.h"
+#include "LennardJonesForceClusterPair.h"
+
+// One time step of a planar lattice with the kernels instantiated for 2 or 3 dimensions,
+// arguments: dimensions, kernel (0 = pair loop, 4 = clusters of 4)
+static void BM_PlanarStep(benchmark::State& state) {
+  auto particles = benchmarkUtils::makeLattice(40, 1.1225, 1);
+  for (auto& p : particles) {
+    p.setX({p.getX()[0], p.getX()[1], 0.0});
+    p.setV({p.getV()[0], p.getV()[1], 0.0});
+  }
+  std::unique_ptr<ForceCalc> force;
+  if (state.range(1) == 4) {
+    force = std::make_unique<LennardJonesForceClusterPair<4>>(particles, MixingTable(5.0, 1.0), 2.5);
+  } else {
+    force = std::make_unique<LennardJonesForce>(particles, 5.0, 1.0, 2.5);
+  }
+  force->setDimensions(static_cast<int>(state.range(0)));
+  VelocityVerlet integrator;
+  integrator.setDimensions(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    integrator.step(particles, 1e-4, [&force](bool) { force->calculateF(); });
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_PlanarStep)
+    ->ArgsProduct({{2, 3}, {0, 4}})
+    ->ArgNames({"dimensions", "cluster"})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "ForceCalc.h"
+#include "Integrator.h"
+#include "ParticleContainer.h"
+
+namespace {
+constexpr double simulatedTime = 20.0;
+
+/**
+ * @brief Sun, earth, jupiter and Halley's comet as in input/eingabe-sonne.txt
+ */
+ParticleContainer makeSolarSystem() {
+  ParticleContainer particles;
+  particles.addParticle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0);
+  particles.addParticle({0.0, 1.0, 0.0}, {-1.0, 0.0, 0.0}, 3.0e-6);
+  particles.addParticle({0.0, 5.36, 0.0}, {-0.425, 0.0, 0.0}, 9.55e-4);
+  particles.addParticle({34.75, 0.0, 0.0}, {0.0, 0.0296, 0.0}, 1.0e-14);
+  return particles;
+}
+
+double totalEnergy(ParticleContainer& particles, GravityForce& force) {
+  ForceObservables observables;
+  force.calculateF(observables);
+  double energy = observables.potentialEnergy;
+  for (const auto& p : particles) {
+    const auto& v = p.getV();
+    energy += 0.5 * p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  }
+  return energy;
+}
+
+/**
+ * @brief Largest relative energy error while integrating the solar system over simulatedTime
+ */
+double energyError(const Integrator& integrator, const double dt) {
+  auto particles = makeSolarSystem();
+  GravityForce force(particles);
+  const double initial = totalEnergy(particles, force);
+  double maxError = 0;
+  const auto steps = static_cast<long>(std::lround(simulatedTime / dt));
+  for (long step = 0; step < steps; step++) {
+    integrator.step(particles, dt, [&force](bool) { force.calculateF(); });
+    if (step % 16 == 15) {
+      maxError = std::max(maxError, std::abs(totalEnergy(particles, force) - initial) / std::abs(initial));
+    }
+  }
+  return maxError;
+}
+}  // namespace
+
+// Integrates the solar system with the largest time step 2^-k whose relative energy error stays below 10^-target,
+// arguments: scheme (0 = Verlet, 1 = Forest-Ruth), target. force_evals_per_time is the cost at that accuracy.
+static void BM_IntegratorAtFixedError(benchmark::State& state) {
+  const auto integrator =
+      createIntegrator(state.range(0) == 0 ? IntegrationScheme::VERLET : IntegrationScheme::FOREST_RUTH);
+  const double target = std::pow(10.0, -static_cast<double>(state.range(1)));
+  double dt = 1.0;
+  double error = energyError(*integrator, dt);
+  while (error > target and dt > 1e-6) {
+    dt /= 2;
+    error = energyError(*integrator, dt);
+  }
+
+  const auto steps = static_cast<long>(std::lround(simulatedTime / dt));
+  for (auto _ : state) {
+    auto particles = makeSolarSystem();
+    GravityForce force(particles);
+    force.calculateF();
+    for (long step = 0; step < steps; step++) {
+      integrator->step(particles, dt, [&force](bool) { force.calculateF(); });
+    }
+    benchmark::DoNotOptimize(particles[0].getX());
+  }
+  state.counters["dt"] = dt;
+  state.counters["rel_error"] = error;
+  state.counters["force_evals_per_time"] = static_cast<double>(integrator->forceEvaluations()) / dt;
+}
+BENCHMARK(BM_IntegratorAtFixedError)
+    ->ArgsProduct({{0, 1}, {5, 7, 9}})
+    ->ArgNames({"scheme", "target"})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "io/VTUWriter.h"
+#include "io/XYZWriter.h"
+
+namespace {
+const std::string outputFile = (std::filesystem::temp_directory_path() / "molsim_output_benchmark.vtu").string();
+
+/**
+ * Human readable .vtu output, formatting every value as text.
+ */
+void BM_VTUAscii(benchmark::State& state) {
+  ParticleContainer particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(outputWriter::VTUWriter::writeAscii(&particles[0], particles.size(), outputFile));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(outputFile)));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * particles.size()));
+}
+
+/**
+ * Binary .vtu output with raw appended blocks written by a single writev.
+ */
+void BM_VTUAppended(benchmark::State& state) {
+  ParticleContainer particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(outputWriter::VTUWriter::writeAppended(&particles[0], particles.size(), outputFile));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(outputFile)));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * particles.size()));
+}
+
+/**
+ * XYZ output as formatted before the buffered writer: std::ofstream, and std::endl flushing every line.
+ */
+void BM_XYZStream(benchmark::State& state) {
+  ParticleContainer particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  const std::string filename = (std::filesystem::temp_directory_path() / "molsim_output_benchmark.xyz").string();
+  for (auto _ : state) {
+    std::ofstream file(filename);
+    file << particles.size() << std::endl;
+    file << "Generated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for file format doku." << std::endl;
+    for (const auto& p : particles) {
+      file << "Ar ";
+      file.setf(std::ios_base::showpoint);
+      for (const auto& xi : p.getX()) {
+        file << xi << " ";
+      }
+      file << std::endl;
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(filename)));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * particles.size()));
+}
+
+/**
+ * Buffered XYZ output formatted with std::to_chars, appending one frame per iteration to a trajectory file.
+ */
+void BM_XYZBuffered(benchmark::State& state) {
+  ParticleContainer particles = benchmarkUtils::makeLattice(static_cast<int>(state.range(0)));
+  const std::string filename = (std::filesystem::temp_directory_path() / "molsim_output_benchmark.xyz").string();
+  outputWriter::XYZWriter writer(filename);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(writer.appendFrame(particles, 0));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(std::filesystem::file_size(filename)));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * particles.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_VTUAscii)->Arg(10)->Arg(40)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VTUAppended)->Arg(10)->Arg(40)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_XYZStream)->Arg(10)->Arg(40)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_XYZBuffered)->Arg(10)->Arg(40)->Unit(benchmark::kMillisecond);
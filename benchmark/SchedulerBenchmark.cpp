@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "ForceCalc.h"
+
+namespace {
+/**
+ * Reports the busy and idle time per force calculation of every thread, and the share of the total thread time spent
+ * idle, i.e. waiting for the slowest thread.
+ */
+void setLoadCounters(benchmark::State& state, const std::vector<utils::ThreadLoad>& loads) {
+  const auto iterations = static_cast<double>(state.iterations());
+  double busy = 0;
+  double idle = 0;
+  double maxBusy = 0;
+  for (std::size_t t = 0; t < loads.size(); t++) {
+    state.counters["busy_ms_" + std::to_string(t)] = 1e3 * loads[t].busySeconds / iterations;
+    state.counters["idle_ms_" + std::to_string(t)] = 1e3 * loads[t].idleSeconds / iterations;
+    busy += loads[t].busySeconds;
+    idle += loads[t].idleSeconds;
+    maxBusy = std::max(maxBusy, loads[t].busySeconds);
+  }
+  state.counters["idle_share"] = idle / (busy + idle);
+  state.counters["imbalance"] = maxBusy * static_cast<double>(loads.size()) / busy;
+}
+
+/**
+ * Lattice with a dense cluster in one corner, like the impact region after a collision, so that the rows of the pair
+ * loop differ in cost beyond the triangular shape.
+ */
+ParticleContainer makeIrregular() {
+  ParticleContainer particles = benchmarkUtils::makeLattice(12);
+  const ParticleContainer cluster = benchmarkUtils::makeLattice(8, 0.9);
+  for (const auto& p : cluster) {
+    particles.addParticle({p.getX()[0] - 8.0, p.getX()[1] - 8.0, p.getX()[2]}, p.getV(), p.getM());
+  }
+  return particles;
+}
+
+void BM_LennardJonesParallel(benchmark::State& state, const Schedule schedule) {
+  ParticleContainer particles = makeIrregular();
+  LennardJonesForceParallel force(particles, MixingTable(5.0, 1.0), 2.5, schedule);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  setLoadCounters(state, force.getThreadLoads());
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_LennardJonesParallel, Guided, Schedule::GUIDED)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_LennardJonesParallel, WorkStealing, Schedule::WORK_STEALING)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
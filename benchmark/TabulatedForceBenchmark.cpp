@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "BenchmarkUtils.h"
+#include "ForceCalc.h"
+#include "PairPotentials.h"
+#include "TabulatedForce.h"
+
+namespace {
+constexpr double epsilon = 5.0;
+constexpr double sigma = 1.0;
+constexpr double cutoffRadius = 2.5;
+constexpr int latticeSize = 10;
+
+/**
+ * Pair loop evaluating the potential inline, i.e. what a dedicated analytic kernel for it would cost.
+ */
+template <typename Potential>
+void inlinePairLoop(ParticleContainer& particles, const Potential& potential) {
+  for (auto& p : particles) {
+    p.setF({});
+  }
+  const double r2Cutoff = cutoffRadius * cutoffRadius;
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    for (std::size_t j = i + 1; j < particles.size(); j++) {
+      const auto& x_i = particles[i].getX();
+      const auto& x_j = particles[j].getX();
+      const std::array<double, 3> dist = {x_j[0] - x_i[0], x_j[1] - x_i[1], x_j[2] - x_i[2]};
+      const double r2 = dist[0] * dist[0] + dist[1] * dist[1] + dist[2] * dist[2];
+      if (r2 >= r2Cutoff) {
+        continue;
+      }
+      const double factor = potential.forceFactor(r2);
+      auto& F_i = particles[i].getF();
+      auto& F_j = particles[j].getF();
+      for (std::size_t d = 0; d < 3; d++) {
+        F_i[d] += factor * dist[d];
+        F_j[d] -= factor * dist[d];
+      }
+    }
+  }
+}
+
+void setCounters(benchmark::State& state, std::size_t n) {
+  state.counters["pairs/s"] =
+      benchmark::Counter(static_cast<double>(n * (n - 1) / 2), benchmark::Counter::kIsIterationInvariantRate);
+}
+}  // namespace
+
+// Reference: the analytic Lennard-Jones kernel
+static void BM_LennardJonesAnalytic(benchmark::State& state) {
+  auto particles = benchmarkUtils::makeLattice(latticeSize);
+  LennardJonesForce force(particles, epsilon, sigma, cutoffRadius);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, particles.size());
+}
+BENCHMARK(BM_LennardJonesAnalytic)->Unit(benchmark::kMillisecond);
+
+// Tabulated Lennard-Jones, arguments: table size, interpolation (0 = linear, 1 = cubic).
+// Reports the largest force error relative to the largest force of the analytic kernel.
+static void BM_LennardJonesTabulated(benchmark::State& state) {
+  auto particles = benchmarkUtils::makeLattice(latticeSize);
+  auto reference = particles;
+  LennardJonesForce(reference, epsilon, sigma, cutoffRadius).calculateF();
+
+  const auto interpolation = state.range(1) == 0 ? Interpolation::LINEAR : Interpolation::CUBIC;
+  TabulatedForce force(particles, potentials::LennardJones{epsilon, sigma}, 0.7 * sigma, cutoffRadius,
+                       static_cast<std::size_t>(state.range(0)), interpolation);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, particles.size());
+
+  double maxError = 0;
+  double maxForce = 0;
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    for (std::size_t d = 0; d < 3; d++) {
+      maxError = std::max(maxError, std::abs(particles[i].getF()[d] - reference[i].getF()[d]));
+      maxForce = std::max(maxForce, std::abs(reference[i].getF()[d]));
+    }
+  }
+  state.counters["rel_error"] = maxError / maxForce;
+}
+BENCHMARK(BM_LennardJonesTabulated)
+    ->ArgsProduct({{256, 1024, 4096, 16384}, {0, 1}})
+    ->ArgNames({"size", "cubic"})
+    ->Unit(benchmark::kMillisecond);
+
+// Expensive potentials evaluated inline per pair versus tabulated
+template <typename Potential>
+static void BM_Inline(benchmark::State& state, Potential potential) {
+  auto particles = benchmarkUtils::makeLattice(latticeSize);
+  for (auto _ : state) {
+    inlinePairLoop(particles, potential);
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, particles.size());
+}
+
+template <typename Potential>
+static void BM_Tabulated(benchmark::State& state, Potential potential) {
+  auto particles = benchmarkUtils::makeLattice(latticeSize);
+  TabulatedForce force(particles, potential, 0.7 * sigma, cutoffRadius, 4096);
+  for (auto _ : state) {
+    force.calculateF();
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, particles.size());
+}
+
+BENCHMARK_CAPTURE(BM_Inline, SmoothedLJ, potentials::SmoothedLennardJones{epsilon, sigma, 1.9, cutoffRadius})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Tabulated, SmoothedLJ, potentials::SmoothedLennardJones{epsilon, sigma, 1.9, cutoffRadius})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Inline, Morse, potentials::Morse{epsilon, 2.0, 1.1225})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Tabulated, Morse, potentials::Morse{epsilon, 2.0, 1.1225})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Inline, Buckingham, potentials::Buckingham{1000., 0.2, 1.})->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Tabulated, Buckingham, potentials::Buckingham{1000., 0.2, 1.})->Unit(benchmark::kMillisecond);
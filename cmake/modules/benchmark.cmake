@@ -0,0 +1,32 @@
+option(BUILD_BENCHMARKS "Build the micro benchmarks using Google Benchmark" OFF)
+include(FetchContent)
+
+function(molsim_enable_benchmarks)
+    if(NOT BUILD_BENCHMARKS)
+        return()
+    endif()
+    message(STATUS "Google Benchmark enabled")
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    FetchContent_Declare(
+            benchmark
+            GIT_REPOSITORY https://github.com/google/benchmark.git
+            GIT_TAG v1.9.1
+    )
+    FetchContent_MakeAvailable(benchmark)
+
+    file(GLOB_RECURSE BENCHMARK_FILES "${CMAKE_SOURCE_DIR}/benchmark/*.cpp")
+
+    add_executable(MolSimBenchmarks
+            ${BENCHMARK_FILES}
+    )
+
+    # Define custom macro for project source directory
+    target_compile_definitions(MolSimBenchmarks PRIVATE PROJ_SRC_DIR="${CMAKE_SOURCE_DIR}")
+
+    target_link_libraries(MolSimBenchmarks PRIVATE
+            molsim_core
+            benchmark::benchmark_main
+    )
+    message(STATUS "Benchmark executable 'MolSimBenchmarks' created.")
+endfunction()
@@ -0,0 +1,10 @@
+# cmake/modules/tracing.cmake
+option(ENABLE_TRACING "Record a Chrome trace of the simulation phases" OFF)
+
+function(molsim_enable_tracing tgt)
+    if(ENABLE_TRACING)
+        message(STATUS "Tracing enabled")
+        # Propagate the feature macro to consumers, without it TRACE_SCOPE expands to nothing
+        target_compile_definitions(${tgt} PUBLIC ENABLE_TRACING)
+    endif()
+endfunction()
@@ -0,0 +1,107 @@
+/**
+ * @file AutoTunedForce.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ForceCalc.h"
+
+/**
+ * @class AutoTunedForce
+ * @brief Force calculation that measures several equivalent force calculations at runtime and uses the fastest.
+ *
+ * Every retuneInterval force calculations, each candidate computes the forces of trialSteps consecutive time steps
+ * and its fastest call is recorded. The trials are regular steps of the simulation, so tuning costs only the time
+ * the slower candidates take. Afterwards the fastest candidate is used until the next trial, unless it is less than
+ * 5 % faster than the one selected before. This lets the choice follow the workload, e.g. from dense cuboids to a
+ * sparse cloud after a collision. Every decision is logged together with the command line options that pin it for
+ * reproducible runs.
+ */
+class AutoTunedForce final : public ForceCalc {
+ public:
+  /**
+   * @brief A force calculation that can be selected
+   */
+  struct Candidate {
+    /**
+     * @brief Command line options selecting this force calculation, e.g. "P:ON SCHEDULE:STEAL"
+     */
+    std::string name;
+    std::unique_ptr<ForceCalc> force;
+  };
+
+ private:
+  std::vector<Candidate> candidates;
+  const std::size_t retuneInterval;
+  const std::size_t trialSteps;
+  const std::function<double()> clock;
+
+  /**
+   * @brief Relative speedup a candidate needs in a trial to replace the selected one
+   */
+  static constexpr double switchMargin = 0.05;
+
+  /**
+   * @brief Candidate used outside of trials
+   */
+  std::size_t selected = 0;
+
+  /**
+   * @brief Number of calls of calculateF() so far
+   */
+  std::size_t calls = 0;
+
+  /**
+   * @brief Fastest time in seconds of every candidate during the current trial
+   */
+  std::vector<double> trialTimes;
+
+  /**
+   * @brief Runs one force calculation with the selected candidate or the one on trial
+   */
+  void step(const std::function<void(ForceCalc&)>& calculate);
+
+ public:
+  /**
+   * @brief Seconds on std::chrono::steady_clock, the default clock
+   */
+  static double steadySeconds();
+
+  /**
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param candidates Force calculations on the same particles computing the same forces
+   * @param retuneInterval Number of force calculations from the start of one trial to the next
+   * @param trialSteps Number of force calculations measured per candidate and trial
+   * @param clock Current wall time in seconds, replaced by tests to control the measured durations
+   * @throws std::invalid_argument if there are no candidates or the trials take longer than the interval
+   */
+  AutoTunedForce(ParticleContainer& particles, std::vector<Candidate> candidates, std::size_t retuneInterval = 1000,
+                 std::size_t trialSteps = 3, std::function<double()> clock = steadySeconds);
+
+  /**
+   * @brief Calculates the forces with the selected candidate, or the one on trial
+   */
+  void calculateF() override;
+
+  /**
+   * @brief Calculates forces, potential energy and virial with the selected candidate, or the one on trial
+   */
+  void calculateF(ForceObservables& observables) override;
+
+  /**
+   * @brief Sets the dimensionality of the integration and of all candidates
+   */
+  void setDimensions(int newDimensions) override;
+
+  /**
+   * @brief Name of the candidate used outside of trials
+   */
+  [[nodiscard]] const std::string& getSelected() const { return candidates[selected].name; }
+};
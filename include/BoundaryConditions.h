@@ -0,0 +1,131 @@
+/**
+ * @file BoundaryConditions.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ParticleContainer.h"
+
+/**
+ * @enum BoundaryType
+ * @brief Behaviour of a single face of the simulation domain.
+ */
+enum class BoundaryType {
+  /** Particles leaving the domain are deleted */
+  OUTFLOW,
+  /** Particles are repelled by the face (and mirrored back should they cross it) */
+  REFLECTING,
+  /** Particles leaving the domain re-enter on the opposite face and interact across it */
+  PERIODIC
+};
+
+/**
+ * @struct BoundaryConfig
+ * @brief Box shaped domain and the boundary type of each of its faces.
+ *
+ * Faces are ordered as x-min, x-max, y-min, y-max, z-min, z-max. Periodic faces must come in pairs.
+ */
+struct BoundaryConfig {
+  /** @brief Lower left front corner of the domain */
+  std::array<double, 3> lowerCorner;
+  /** @brief Upper right back corner of the domain */
+  std::array<double, 3> upperCorner;
+  /** @brief Boundary type of each face */
+  std::array<BoundaryType, 6> faces;
+
+  /**
+   * @brief Creates a configuration from its command line representation.
+   * @param faces Six characters out of o (outflow), r (reflecting) and p (periodic), e.g. "rroopp"
+   * @param domain Comma separated corners "x0,y0,z0,x1,y1,z1"
+   * @throws std::invalid_argument if either string is malformed
+   */
+  static BoundaryConfig parse(const std::string& faces, const std::string& domain);
+};
+
+/**
+ * @class BoundaryConditions
+ * @brief Applies the boundary conditions of a \ref BoundaryConfig "BoundaryConfig" to a ParticleContainer.
+ *
+ * All faces are handled in a single pass over the particles after the position update, which removes outflowing
+ * particles, wraps periodic ones, creates the halo copies for periodic faces and records the particles close to
+ * reflecting faces. After the force calculation only the recorded particles receive the wall force and the halo
+ * copies are dropped again.
+ *
+ * Reflecting faces use the analytic Lennard-Jones force of a mirror particle behind the wall. It is only applied
+ * while the mirror particle is closer than 2^(1/6) sigma, where it is purely repulsive. Periodic faces use
+ * minimum-image halo copies, which requires the cutoff radius to be at most half the domain extent.
+ */
+class BoundaryConditions {
+ private:
+  const BoundaryConfig config;
+  const double epsilon, sigma, cutoffRadius;
+
+  /**
+   * @brief Extent of the domain in every dimension
+   */
+  std::array<double, 3> domainSize;
+
+  /**
+   * @brief Distance to a reflecting face below which the wall force acts (2^(1/6) sigma / 2)
+   */
+  double reflectDistance;
+
+  /**
+   * @brief Storage index of the first halo particle, equal to the container size if there are none
+   */
+  std::size_t firstHalo = 0;
+
+  /**
+   * @brief Storage indices of particles within the reach of a reflecting face
+   */
+  std::vector<std::size_t> nearReflectingFace;
+
+  [[nodiscard]] BoundaryType lower(std::size_t dim) const { return config.faces[2 * dim]; }
+  [[nodiscard]] BoundaryType upper(std::size_t dim) const { return config.faces[2 * dim + 1]; }
+
+  /**
+   * @brief Magnitude of the force of a mirror particle at distance 2 * wallDistance
+   */
+  [[nodiscard]] double wallForce(double wallDistance) const;
+
+ public:
+  /**
+   * @param config Domain and boundary types
+   * @param epsilon Epsilon of the Lennard-Jones wall force
+   * @param sigma Sigma of the Lennard-Jones wall force
+   * @param cutoffRadius Interaction range, determines the width of the periodic halo
+   */
+  BoundaryConditions(const BoundaryConfig& config, double epsilon, double sigma, double cutoffRadius);
+
+  /**
+   * @brief Applies outflow and periodic conditions and inserts the halo particles.
+   *
+   * Must be called after the position update and before the force calculation.
+   * @param particles Particles of the simulation
+   */
+  void applyAfterPositionUpdate(ParticleContainer& particles);
+
+  /**
+   * @brief Adds the reflecting wall forces and removes the halo particles.
+   *
+   * Must be called after the force calculation and before the velocity update.
+   * @param particles Particles of the simulation
+   */
+  void applyAfterForceUpdate(ParticleContainer& particles);
+
+  /**
+   * @brief Domain and boundary types
+   */
+  [[nodiscard]] const BoundaryConfig& getConfig() const { return config; }
+
+  /**
+   * @brief Storage index of the first halo particle inserted by the last position update
+   */
+  [[nodiscard]] std::size_t getFirstHalo() const { return firstHalo; }
+};
@@ -0,0 +1,99 @@
+/**
+ * @file Ensemble.h
+ *
+ */
+
+#pragma once
+
+#include "Simulation.h"
+#include "SimulationOptions.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct EnsembleMember
+ * @brief One independent simulation of an ensemble, as given by one line of the manifest.
+ */
+struct EnsembleMember {
+  /**
+   * @brief Unique name of the member, also the name of its output directory.
+   */
+  std::string name;
+  std::string inputFilename;
+  double end_time;
+  double dt;
+  SimulationOptions options;
+};
+
+/**
+ * @struct EnsembleResult
+ * @brief Outcome of running one ensemble member.
+ */
+struct EnsembleResult {
+  std::size_t particles = 0;
+  /**
+   * @brief Force calculation the member ran with, always the one of its options
+   */
+  Parallelization parallelization = Parallelization::OFF;
+  int threads = 0;
+  double seconds = 0;
+  bool succeeded = false;
+};
+
+/**
+ * @class EnsembleRunner
+ * @brief Runs many independent collision simulations inside one process, e.g. for parameter sweeps.
+ *
+ * Members are scheduled by their particle count. Members with at least `largeParticles` particles run one after
+ * another on all threads, all smaller members run concurrently with one member per thread, longest first. Every
+ * member keeps the force calculation of its options: a parallel one of a small member runs on its single thread, and
+ * a large member with P:OFF on one thread, both with a warning.
+ * Every member writes to its own directory below the output root, and a summary of all members is written to
+ * ensemble.csv in the output root.
+ */
+class EnsembleRunner {
+ private:
+  const std::vector<EnsembleMember> members;
+  const SimulationMode simulationMode;
+  const std::string outputRoot;
+  const std::size_t largeParticles;
+
+  std::vector<EnsembleResult> results;
+
+  void runMember(std::size_t index, bool allThreads);
+  void writeSummary() const;
+
+ public:
+  /**
+   * @param members Simulations to run
+   * @param simulationMode Mode every member runs in
+   * @param outputRoot Directory containing the output directories of the members
+   * @param largeParticles Particle count from which a member runs on all threads
+   */
+  EnsembleRunner(std::vector<EnsembleMember> members, SimulationMode simulationMode, std::string outputRoot = "output",
+                 std::size_t largeParticles = 2000);
+
+  /**
+   * @brief Reads an ensemble manifest.
+   *
+   * Every line that is neither empty nor starts with '#' describes one member:
+   * `name input_file t_end delta_t [KEY:VALUE options]`, with the same options as the command line.
+   * @param filename Path to the manifest
+   * @return All members in the order of the manifest
+   * @throws std::invalid_argument if a line is malformed or a name is used twice
+   */
+  static std::vector<EnsembleMember> readManifest(const std::string& filename);
+
+  /**
+   * @brief Runs all members and writes the summary.
+   * @return Whether every member succeeded
+   */
+  bool run();
+
+  /**
+   * @brief Results of the last \ref run "run()", in the order of the members
+   */
+  [[nodiscard]] const std::vector<EnsembleResult>& getResults() const { return results; }
+};
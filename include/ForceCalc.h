@@ -5,7 +5,55 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "MixingTable.h"
 #include "ParticleContainer.h"
+#include "utils/WorkStealingScheduler.h"
+
+/**
+ * @enum Schedule
+ * @brief Distribution of the pair loop of \ref LennardJonesForceParallel "LennardJonesForceParallel" over the threads.
+ */
+enum class Schedule {
+  /** OpenMP guided schedule over the particle indices */
+  GUIDED,
+  /** Blocks of particles as tasks of a \ref utils::WorkStealingScheduler "WorkStealingScheduler" */
+  WORK_STEALING
+};
+
+/**
+ * @struct ForceObservables
+ * @brief Potential energy and virial tensor accumulated by a force calculation in the same pair loop as the forces.
+ *
+ * Pairs are weighted by the fraction of their particles that are owned by the simulation, so that pairs with
+ * periodic halo copies count once per crossing pair and pairs of two halo copies not at all.
+ */
+struct ForceObservables {
+  /**
+   * @brief Particles with a storage index of at least this value are halo copies. Set by the caller.
+   */
+  std::size_t ownedParticles = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Total potential energy of all pairs
+   */
+  double potentialEnergy = 0;
+
+  /**
+   * @brief Virial tensor W_ab = sum over pairs of r_ij,a * F_ij,b with r_ij = x_i - x_j and F_ij the force on i
+   */
+  std::array<std::array<double, 3>, 3> virial{};
+
+  /**
+   * @brief Whether the force calculation supports the accumulation and filled in the values
+   */
+  bool valid = false;
+};
+
 /**
  * @class ForceCalc
  * @brief Virtual class used as a base for different calculation methods for simulation
@@ -15,6 +63,11 @@ class ForceCalc {
  protected:
   ParticleContainer& particles;
 
+  /**
+   * @brief Number of position components that change, 2 if all particles move in a plane of constant z
+   */
+  int dimensions = 3;
+
  public:
   /**
   * @brief Constructor
@@ -24,19 +77,31 @@ class ForceCalc {
   virtual ~ForceCalc();
 
   /**
-  * @brief Calculates the new x-coordinate of the particle based on the Störmer-Verlet method
-  * @param dt double representing the Velocity-Störmer-Verlet time step (delta t)
+  * @brief Calculates the new force that acts on the particles
   */
-  virtual void calculateX(double dt);
+  virtual void calculateF() = 0;
   /**
-  * @brief Calculates the new velocity of the particle based on the Störmer-Verlet method
-  * @param dt double representing the Velocity-Störmer-Verlet time step (delta t)
+  * @brief Calculates the new force and also accumulates potential energy and virial.
+  *
+  * The default calculates the forces only and marks the observables as invalid.
+  * @param observables Receives the potential energy and virial; ownedParticles must be set by the caller
   */
-  virtual void calculateV(double dt);
+  virtual void calculateF(ForceObservables& observables);
+
   /**
-  * @brief Calculates the new force that acts on the particles
+  * @brief Restricts the force calculation to the x and y components, or lifts the restriction.
+  *
+  * Kernels are instantiated for both dimensionalities, so in 2D they neither load nor compute z. The z components
+  * of the particles keep their values, which requires all particles to have the same z and no velocity or force
+  * in z.
+  * @param newDimensions 2 or 3
+  * @throws std::invalid_argument for other values
   */
-  virtual void calculateF() = 0;
+  virtual void setDimensions(int newDimensions);
+  /**
+  * @brief Number of components the force calculation considers
+  */
+  [[nodiscard]] int getDimensions() const { return dimensions; }
 };
 
 /**
@@ -44,6 +109,10 @@ class ForceCalc {
  * @brief Models gravity forces between particles
  */
 class GravityForce final : public ForceCalc {
+private:
+  template <bool withObservables>
+  void computeForces(ForceObservables* observables);
+
 public:
   using ForceCalc::ForceCalc;
 
@@ -51,15 +120,25 @@ public:
   * @brief Calculates the gravity forces acting on the particles
   */
   void calculateF() override;
+  /**
+  * @brief Calculates the gravity forces and the gravitational potential energy and virial
+  */
+  void calculateF(ForceObservables& observables) override;
 };
 
 /**
  * @class LennardJonesForce
  * @brief Models the Lennard-Jones potential
+ *
+ * Particles of different types interact with the parameters of a \ref MixingTable "MixingTable".
  */
 class LennardJonesForce final : public ForceCalc {
 private:
-  const double epsilon, sigma, cutoffRadius;
+  const MixingTable mixing;
+  const double cutoffRadius;
+
+  template <bool withObservables, std::size_t Dimensions>
+  void computeForces(ForceObservables* observables);
 
 public:
   /**
@@ -67,23 +146,60 @@ public:
    * @param particles ParticleContainer that stores the particles used by the calculation method
    * @param epsilon Epsilon in the Lennard-Jones potential formula
    * @param sigma Sigma in the Lennard-Jones potential formula
-   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated (ignored)
+   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
    */
   LennardJonesForce(ParticleContainer& particles, double epsilon, double sigma, double cutoffRadius);
 
+  /**
+   *
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param mixing Lennard-Jones parameters for every pair of particle types
+   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
+   */
+  LennardJonesForce(ParticleContainer& particles, MixingTable mixing, double cutoffRadius);
+
   /**
   * @brief Calculates the Lennard-Jones forces acting on the particles
   */
   void calculateF() override;
+  /**
+  * @brief Calculates the Lennard-Jones forces and the potential energy and virial of all pairs within the cutoff
+  */
+  void calculateF(ForceObservables& observables) override;
 };
 
 /**
  * @class LennardJonesForceParallel
  * @brief Models the Lennard-Jones potential with parallelization
+ *
+ * The pair loop of a particle gets shorter the larger its index, so the rows of the triangular pair matrix differ
+ * in cost. They are either distributed by OpenMP's guided schedule, or as blocks of rows by work stealing.
  */
 class LennardJonesForceParallel final : public ForceCalc {
 private:
-  const double epsilon, sigma, cutoffRadius;
+  const MixingTable mixing;
+  const double cutoffRadius;
+  const Schedule schedule;
+  utils::WorkStealingScheduler scheduler;
+
+  /**
+   * @brief Busy and idle time of every thread in all force calculations so far
+   */
+  std::vector<utils::ThreadLoad> threadLoads;
+
+  /**
+   * @brief Number of particles whose pairs form one task of the work stealing schedule
+   */
+  static constexpr std::size_t rowsPerTask = 16;
+
+  template <bool withObservables, std::size_t Dimensions>
+  void computeForces(ForceObservables* observables);
+
+  /**
+   * @brief Adds the forces of all pairs (i, j > i) to both particles
+   */
+  template <bool withObservables, std::size_t Dimensions>
+  void computeRow(std::size_t i, ForceObservables& partial);
 
 public:
   /**
@@ -91,13 +207,74 @@ public:
  * @param particles ParticleContainer that stores the particles used by the calculation method
  * @param epsilon Epsilon in the Lennard-Jones potential formula
  * @param sigma Sigma in the Lennard-Jones potential formula
- * @param cutoffRadius Distance beyond which interactions between the particles are not calculated (ignored)
+ * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
  */
   LennardJonesForceParallel(ParticleContainer& particles, double epsilon, double sigma, double cutoffRadius);
 
+  /**
+   *
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param mixing Lennard-Jones parameters for every pair of particle types
+   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
+   * @param schedule Distribution of the pair loop over the threads
+   */
+  LennardJonesForceParallel(ParticleContainer& particles, MixingTable mixing, double cutoffRadius,
+                            Schedule schedule = Schedule::GUIDED);
+
+  /**
+   * @brief Busy and idle time of every thread, accumulated over all force calculations since the last reset
+   */
+  [[nodiscard]] const std::vector<utils::ThreadLoad>& getThreadLoads() const { return threadLoads; }
+
+  void resetThreadLoads() { threadLoads.clear(); }
+
   /**
   * @brief Calculates the Lennard-Jones forces acting on the particles using OpenMP
   */
   void calculateF() override;
+  /**
+  * @brief Calculates the Lennard-Jones forces, potential energy and virial using OpenMP
+  *
+  * Every thread accumulates its own partial sums, which are added up once at the end of the pair loop.
+  */
+  void calculateF(ForceObservables& observables) override;
 };
 
+
+/**
+ * @class LennardJonesForceDeterministic
+ * @brief Models the Lennard-Jones potential with a parallelization that is bitwise reproducible
+ *
+ * Every thread computes the total force of its own particles by visiting all partners in ascending index order,
+ * evaluating each pair exactly like \ref LennardJonesForce "LennardJonesForce" does. The forces are therefore
+ * bitwise identical to the serial calculation for any number of threads, at the price of evaluating every pair
+ * twice instead of using Newton's third law. Potential energy and virial are summed per particle and reduced in
+ * index order, so they also do not depend on the number of threads.
+ */
+class LennardJonesForceDeterministic final : public ForceCalc {
+private:
+  const MixingTable mixing;
+  const double cutoffRadius;
+
+  template <bool withObservables, std::size_t Dimensions>
+  void computeForces(ForceObservables* observables);
+
+public:
+  /**
+   *
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param mixing Lennard-Jones parameters for every pair of particle types
+   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
+   */
+  LennardJonesForceDeterministic(ParticleContainer& particles, MixingTable mixing, double cutoffRadius);
+
+  /**
+  * @brief Calculates the Lennard-Jones forces acting on the particles using OpenMP, independent of the thread count
+  */
+  void calculateF() override;
+  /**
+  * @brief Calculates the Lennard-Jones forces, potential energy and virial using OpenMP, independent of the thread
+  * count
+  */
+  void calculateF(ForceObservables& observables) override;
+};
@@ -0,0 +1,114 @@
+/**
+ * @file Integrator.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "ParticleContainer.h"
+
+/**
+ * @enum IntegrationScheme
+ * @brief Time integration scheme selected by the INTEGRATOR option.
+ */
+enum class IntegrationScheme {
+  /** Velocity Störmer-Verlet, see \ref VelocityVerlet "VelocityVerlet" */
+  VERLET,
+  /** Fourth order Forest-Ruth, see \ref ForestRuth "ForestRuth" */
+  FOREST_RUTH
+};
+
+/**
+ * @class Integrator
+ * @brief Time integration scheme that advances positions and velocities using the forces of a force calculation.
+ *
+ * Integrators only move the particles. Whenever the positions have changed they call back into the simulation,
+ * which applies the boundary conditions and calculates the forces at the new positions, so the same integrator
+ * works with every \ref ForceCalc "ForceCalc" and boundary. At the end of a step the forces belong to the final
+ * positions.
+ */
+class Integrator {
+ protected:
+  /**
+   * @brief Number of position and velocity components that change, 2 if all particles move in a plane of constant z
+   */
+  int dimensions = 3;
+
+  /**
+   * @brief One velocity Störmer-Verlet step of length h
+   */
+  void verletStep(ParticleContainer& particles, double h, const std::function<void(bool)>& updateForces,
+                  bool last) const;
+
+ public:
+  /**
+   * @brief Callback that calculates the forces at the current positions, including the boundary conditions.
+   *
+   * Its argument is true for the last force calculation of the step, e.g. to accumulate observables only there.
+   */
+  using ForceUpdate = std::function<void(bool)>;
+
+  virtual ~Integrator();
+
+  /**
+   * @brief Advances the particles by one time step
+   * @param particles Particles with forces that belong to their current positions
+   * @param dt Time step
+   * @param updateForces Calculates the forces after every change of the positions
+   */
+  virtual void step(ParticleContainer& particles, double dt, const ForceUpdate& updateForces) const = 0;
+
+  /**
+   * @brief Number of force calculations per step
+   */
+  [[nodiscard]] virtual std::size_t forceEvaluations() const = 0;
+
+  /**
+   * @brief Name of the scheme as accepted by the INTEGRATOR option
+   */
+  [[nodiscard]] virtual std::string name() const = 0;
+
+  /**
+   * @brief Restricts the integration to the x and y components, or lifts the restriction
+   * @param newDimensions 2 or 3
+   * @throws std::invalid_argument for other values
+   */
+  void setDimensions(int newDimensions);
+};
+
+/**
+ * @class VelocityVerlet
+ * @brief Second order velocity Störmer-Verlet scheme with one force calculation per step.
+ */
+class VelocityVerlet final : public Integrator {
+ public:
+  void step(ParticleContainer& particles, double dt, const ForceUpdate& updateForces) const override;
+  [[nodiscard]] std::size_t forceEvaluations() const override { return 1; }
+  [[nodiscard]] std::string name() const override { return "VERLET"; }
+};
+
+/**
+ * @class ForestRuth
+ * @brief Fourth order symplectic scheme of Forest and Ruth with three force calculations per step.
+ *
+ * Composes three velocity Verlet steps of lengths theta dt, (1 - 2 theta) dt and theta dt with
+ * theta = 1 / (2 - 2^(1/3)) (Yoshida's triple jump). The error per unit time drops with the fourth power of the time
+ * step instead of the second, so for a small energy error it needs far fewer force calculations than velocity
+ * Verlet, although each step costs three.
+ */
+class ForestRuth final : public Integrator {
+ public:
+  void step(ParticleContainer& particles, double dt, const ForceUpdate& updateForces) const override;
+  [[nodiscard]] std::size_t forceEvaluations() const override { return 3; }
+  [[nodiscard]] std::string name() const override { return "FOREST_RUTH"; }
+};
+
+/**
+ * @brief Creates the integrator of a scheme
+ */
+std::unique_ptr<Integrator> createIntegrator(IntegrationScheme scheme);
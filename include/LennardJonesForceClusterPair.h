@@ -0,0 +1,275 @@
+/**
+ * @file LennardJonesForceClusterPair.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ForceCalc.h"
+
+/**
+ * @struct SleepSettings
+ * @brief When clusters of a \ref LennardJonesForceClusterPair "LennardJonesForceClusterPair" fall asleep and wake up.
+ *
+ * A particle is quiet while it stays within displacementTolerance of the position and within forceTolerance of the
+ * force it had when it became quiet. A cluster whose particles have all been quiet for quietSteps steps is asleep:
+ * the forces between sleeping clusters are computed once and reused until a cluster falls asleep or wakes up.
+ * Pairs with at least one awake cluster are evaluated every step, so an approaching particle changes the force on
+ * a sleeping one and wakes its cluster.
+ *
+ * The quiet steps belong to particle ids, so they survive outflow moving particles to other storage indices. Halo
+ * copies of periodic boundaries share the id of their particle and are told apart by their order, so clusters
+ * containing them fall asleep as well.
+ */
+struct SleepSettings {
+  /** @brief Steps that all particles of a cluster have to be quiet before it falls asleep */
+  std::size_t quietSteps = 50;
+  /** @brief Largest distance from the position at which a particle became quiet */
+  double displacementTolerance = 0.01;
+  /** @brief Largest change of the force since a particle became quiet */
+  double forceTolerance = 0.5;
+  /**
+   * @brief Whether the forces are compared with a full calculation every verifyInterval steps. If any component
+   * differs by more than maxForceError, all clusters wake up and the exact forces are used for that step.
+   *
+   * This only checks the steps it verifies: in between, the cached forces may drift further than maxForceError
+   * until the next verification catches it.
+   */
+  bool verifyPeriodically = false;
+  /** @brief Steps between two verifications */
+  std::size_t verifyInterval = 100;
+  /**
+   * @brief Whether every step bounds the error of the cached forces and wakes the clusters whose bound exceeds
+   * maxForceError before the forces are used.
+   *
+   * The bound multiplies the displacements since the forces were cached with a Lipschitz constant of the
+   * Lennard-Jones force at the closest distance the particles can have reached, and a pair that may have crossed the
+   * cutoff radius wakes its clusters. Only clusters that barely moved stay asleep.
+   */
+  bool strict = false;
+  /** @brief Largest force error accepted by a verification, and bound of every force component in strict mode */
+  double maxForceError = 0.1;
+};
+
+/**
+ * @class LennardJonesForceClusterPair
+ * @brief Models the Lennard-Jones potential by evaluating all interactions between pairs of small particle clusters.
+ *
+ * Spatially close particles are grouped into clusters of ClusterSize particles by sorting them along a Morton curve.
+ * A cluster pair list contains every pair of clusters whose bounding boxes are closer than the cutoff radius plus a
+ * buffer, found by binning the clusters into cells of at least that width, so building it takes O(N log N) for the
+ * Morton sort instead of testing all pairs of clusters. The kernel evaluates all ClusterSize x ClusterSize
+ * interactions of a listed pair in a fixed-length loop without branches: pairs beyond the cutoff, padding slots and
+ * the lower triangle of a cluster with itself are multiplied by a zero mask, so the compiler can vectorize the loop.
+ *
+ * Clusters and pair list refer to storage indices and are reused until the number of particles changes or the
+ * particle at some index is more than half the buffer away from the position it had when they were built. This also
+ * covers particles that are moved to another index by outflow and periodic halo copies that appear or disappear.
+ *
+ * Optionally, clusters at rest fall asleep and the forces between them are cached, see \ref SleepSettings
+ * "SleepSettings". Steps that accumulate potential energy and virial always evaluate all pairs.
+ *
+ * @tparam ClusterSize Number of particles per cluster, 4 or 8
+ */
+template <std::size_t ClusterSize>
+class LennardJonesForceClusterPair final : public ForceCalc {
+private:
+  const double cutoffRadius;
+  const double buffer;
+  const std::size_t numTypes;
+
+  /**
+   * @brief 24 epsilon and sigma^6 of all type pairs, row-major
+   */
+  std::vector<double> epsilon24Table, sigma6Table;
+
+  /**
+   * @brief Particle index of every cluster slot, particles.size() for padding slots
+   */
+  std::vector<std::size_t> slotParticle;
+
+  /**
+   * @brief Positions, 1 for particles and 0 for padding, and forces of all cluster slots
+   */
+  std::vector<double> x, y, z, present, fx, fy, fz;
+
+  /**
+   * @brief Type of the particle in every cluster slot as an index into the parameter tables
+   */
+  std::vector<std::size_t> typeIndex;
+
+  /**
+   * @brief Pairs of clusters (I, J) with I <= J whose particles may interact
+   */
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> clusterPairs;
+
+  /**
+   * @brief Positions of the particles when the clusters were built
+   */
+  std::vector<std::array<double, 3>> referencePositions;
+
+  std::size_t rebuilds = 0;
+
+  /**
+   * @brief Sleep criteria, std::nullopt if all pairs are evaluated every step
+   */
+  std::optional<SleepSettings> sleepSettings;
+
+  /**
+   * @brief Consecutive quiet steps of every storage index, and the position and force when it became quiet
+   */
+  std::vector<std::size_t> quietSteps;
+  std::vector<std::array<double, 3>> quietPosition, quietForce;
+
+  /**
+   * @brief Key of the particle the quiet state of every storage index belongs to, and the current keys. A key is
+   * the id times 256 plus the number of earlier particles with that id, which tells halo copies apart.
+   */
+  std::vector<std::size_t> quietKey, particleKey;
+
+  /**
+   * @brief Particles seen so far of every id while the keys are computed
+   */
+  std::vector<std::uint8_t> copiesOfId;
+
+  /**
+   * @brief Whether each cluster is asleep, and whether it was when the cached forces were computed
+   */
+  std::vector<char> asleep, cachedAsleep;
+
+  /**
+   * @brief Forces between sleeping clusters of all cluster slots, valid if cacheValid
+   */
+  std::vector<double> cachedX, cachedY, cachedZ;
+  bool cacheValid = false;
+
+  /**
+   * @brief Strict mode: positions of all cluster slots when the forces were cached, the sum of the Lipschitz
+   * constants of their cached interactions and the smallest distance of such a pair from the cutoff radius
+   */
+  std::vector<double> cachedPositionX, cachedPositionY, cachedPositionZ, errorSlope, cutoffMargin;
+
+  /**
+   * @brief Whether a particle of each slot is owned, used for the weights of the observables
+   */
+  std::vector<double> ownedSlot;
+
+  std::size_t stepsSinceVerification = 0;
+  std::size_t skippedPairs = 0;
+  std::size_t totalPairs = 0;
+  double largestVerifiedError = 0;
+
+  /**
+   * @brief Whether the pair list may miss pairs within the cutoff
+   */
+  [[nodiscard]] bool needsRebuild() const;
+
+  /**
+   * @brief Groups the particles into clusters and builds the cluster pair list
+   */
+  void rebuild();
+
+  template <bool withObservables, std::size_t Dimensions>
+  void computeForces(ForceObservables* observables);
+
+  /**
+   * @brief Adds the forces of all interactions between clusters ci and cj to the given slot arrays
+   * @return Number of pairs of particles at the same position
+   */
+  template <bool withObservables, std::size_t Dimensions>
+  std::size_t interactClusters(std::size_t ci, std::size_t cj, double* forceX, double* forceY, double* forceZ,
+                               ForceObservables* observables);
+
+  /**
+   * @brief Moves the quiet state of every particle to its current storage index, particles without one start over
+   */
+  void matchQuietState();
+
+  /**
+   * @brief Ends the quiet steps of particles that moved too far, marks the clusters whose particles are all quiet
+   * as asleep and invalidates the cached forces if that changed
+   */
+  void updateSleeping();
+
+  /**
+   * @brief Counts the quiet steps of every particle whose force has not changed too much
+   */
+  void updateQuietSteps();
+
+  /**
+   * @brief Adds the Lipschitz constants and cutoff distances of the interactions between the sleeping clusters ci
+   * and cj to errorSlope and cutoffMargin
+   */
+  template <std::size_t Dimensions>
+  void boundCachedError(std::size_t ci, std::size_t cj);
+
+  /**
+   * @brief Wakes the sleeping clusters whose cached forces may be off by more than maxForceError
+   */
+  template <std::size_t Dimensions>
+  void wakeUnboundedClusters();
+
+  /**
+   * @brief Compares the forces with a full calculation and wakes all clusters if they differ too much
+   */
+  template <std::size_t Dimensions>
+  void verify();
+
+public:
+  /**
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param mixing Lennard-Jones parameters for every pair of particle types
+   * @param cutoffRadius Distance beyond which interactions between the particles are not calculated
+   * @param buffer Extra distance of the cluster pair list, trading masked interactions for fewer rebuilds
+   */
+  LennardJonesForceClusterPair(ParticleContainer& particles, const MixingTable& mixing, double cutoffRadius,
+                               double buffer = 0.3);
+
+  /**
+   * @brief Calculates the Lennard-Jones forces acting on the particles
+   */
+  void calculateF() override;
+  /**
+   * @brief Calculates the Lennard-Jones forces and the potential energy and virial of all pairs within the cutoff
+   */
+  void calculateF(ForceObservables& observables) override;
+
+  /**
+   * @brief Number of times the clusters have been built
+   */
+  [[nodiscard]] std::size_t getRebuilds() const { return rebuilds; }
+
+  /**
+   * @brief Lets clusters at rest fall asleep and reuses the forces between them
+   */
+  void enableSleeping(const SleepSettings& settings);
+
+  /**
+   * @brief Fraction of the cluster pairs skipped because both clusters were asleep, over all steps so far
+   */
+  [[nodiscard]] double getSkippedFraction() const {
+    return totalPairs == 0 ? 0.0 : static_cast<double>(skippedPairs) / static_cast<double>(totalPairs);
+  }
+
+  /**
+   * @brief Largest force component error found by the periodic verifications
+   */
+  [[nodiscard]] double getLargestVerifiedError() const { return largestVerifiedError; }
+
+  /**
+   * @brief Number of clusters that are currently asleep
+   */
+  [[nodiscard]] std::size_t getSleepingClusters() const;
+
+  ~LennardJonesForceClusterPair() override;
+};
+
+extern template class LennardJonesForceClusterPair<4>;
+extern template class LennardJonesForceClusterPair<8>;
@@ -0,0 +1,77 @@
+/**
+ * @file MixingTable.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct Species
+ * @brief Lennard-Jones parameters of a single particle type.
+ */
+struct Species {
+  double epsilon;
+  double sigma;
+};
+
+/**
+ * @class MixingTable
+ * @brief Precomputed Lennard-Jones parameters for every pair of particle types.
+ *
+ * Mixed parameters follow the Lorentz-Berthelot rules sigma_ij = (sigma_i + sigma_j) / 2 and
+ * epsilon_ij = sqrt(epsilon_i epsilon_j). The table stores exactly the two factors the force kernels need,
+ * 24 epsilon_ij and sigma_ij^6, as one 16 byte entry per type pair in a dense row-major matrix, so a lookup in the
+ * pair loop is a single cache line access.
+ */
+class MixingTable {
+ public:
+  /**
+   * @struct Entry
+   * @brief Parameters of one pair of types in the form used by the force kernels.
+   */
+  struct Entry {
+    /** @brief 24 epsilon_ij */
+    double epsilon24;
+    /** @brief sigma_ij^6 */
+    double sigma6;
+  };
+
+ private:
+  std::size_t numTypes;
+  std::vector<Entry> entries;
+  std::vector<Species> species;
+
+ public:
+  /**
+   * @brief Creates the table for a single species, used for every particle regardless of its type.
+   * @param epsilon Epsilon in the Lennard-Jones potential formula
+   * @param sigma Sigma in the Lennard-Jones potential formula
+   */
+  MixingTable(double epsilon, double sigma);
+
+  /**
+   * @brief Creates the table for particle types 0 to species.size() - 1.
+   * @param species Parameters of each type, indexed by type
+   */
+  explicit MixingTable(std::vector<Species> species);
+
+  /**
+   * @brief Parameters for the interaction of particle types ti and tj.
+   */
+  [[nodiscard]] const Entry& operator()(int ti, int tj) const {
+    return numTypes == 1 ? entries[0] : entries[static_cast<std::size_t>(ti) * numTypes + tj];
+  }
+
+  /**
+   * @brief Number of particle types in the table
+   */
+  [[nodiscard]] std::size_t size() const { return numTypes; }
+
+  /**
+   * @brief Unmixed parameters of a particle type
+   */
+  [[nodiscard]] const Species& getSpecies(int type) const { return species[numTypes == 1 ? 0 : type]; }
+};
@@ -0,0 +1,184 @@
+/**
+ * @file OutputSchedule.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ParticleContainer.h"
+
+/**
+ * @enum OutputTrigger
+ * @brief Policy deciding when the file output mode writes a snapshot, selected by the FRAMES option.
+ */
+enum class OutputTrigger {
+  /** Every n iterations, see \ref IterationInterval "IterationInterval" */
+  ITERATIONS,
+  /** Every interval of simulated time, see \ref TimeInterval "TimeInterval" */
+  TIME,
+  /** As often as a share of the runtime allows, see \ref WallTimeBudget "WallTimeBudget" */
+  WALL_TIME_BUDGET,
+  /** Once the particles moved enough, see \ref DisplacementTrigger "DisplacementTrigger" */
+  DISPLACEMENT
+};
+
+/**
+ * @struct OutputScheduleSettings
+ * @brief Policy and its parameter, the default writes every 10 iterations.
+ */
+struct OutputScheduleSettings {
+  OutputTrigger trigger = OutputTrigger::ITERATIONS;
+  /**
+   * @brief Iterations, simulated time, percent of the runtime or RMS displacement, depending on the trigger
+   */
+  double value = 10;
+  /**
+   * @brief Extent of the domain along periodic dimensions and 0 along all others, used by the displacement trigger
+   */
+  std::array<double, 3> periodicSize{};
+};
+
+/**
+ * @class OutputSchedule
+ * @brief Decides after every time step whether the file output mode writes a snapshot.
+ */
+class OutputSchedule {
+ public:
+  virtual ~OutputSchedule();
+
+  /**
+   * @brief Called once before the first time step
+   * @param particles Initial particles
+   */
+  virtual void start(const ParticleContainer& particles);
+
+  /**
+   * @brief Whether a snapshot is written after this time step
+   * @param iteration Iteration reached by the step
+   * @param time Simulated time reached by the step
+   * @param particles Particles after the step
+   */
+  virtual bool isDue(int iteration, double time, const ParticleContainer& particles) = 0;
+
+  /**
+   * @brief Called after a snapshot was written
+   * @param particles Particles in the snapshot
+   * @param seconds Wall time it took to write the snapshot
+   */
+  virtual void written(const ParticleContainer& particles, double seconds);
+
+  /**
+   * @brief Description for the log, e.g. "every 10 iterations"
+   */
+  [[nodiscard]] virtual std::string describe() const = 0;
+};
+
+/**
+ * @class IterationInterval
+ * @brief Writes every n-th iteration.
+ */
+class IterationInterval final : public OutputSchedule {
+ private:
+  const int iterations;
+
+ public:
+  explicit IterationInterval(int iterations);
+  bool isDue(int iteration, double time, const ParticleContainer& particles) override;
+  [[nodiscard]] std::string describe() const override;
+};
+
+/**
+ * @class TimeInterval
+ * @brief Writes whenever the simulated time passed a multiple of the interval, independent of the time step.
+ */
+class TimeInterval final : public OutputSchedule {
+ private:
+  const double interval;
+  long lastMultiple = 0;
+
+ public:
+  explicit TimeInterval(double interval);
+  bool isDue(int iteration, double time, const ParticleContainer& particles) override;
+  [[nodiscard]] std::string describe() const override;
+};
+
+/**
+ * @class WallTimeBudget
+ * @brief Writes as often as possible while writing takes at most a share of the wall time since the start.
+ *
+ * A snapshot is due once the time spent writing, plus the duration of the last write as estimate for the next one,
+ * stays within the budget. Slow file systems or large systems therefore get fewer frames instead of a slower run.
+ */
+class WallTimeBudget final : public OutputSchedule {
+ private:
+  const double share;
+  const std::function<double()> clock;
+  double startTime = 0;
+  double outputSeconds = 0;
+  double lastWriteSeconds = 0;
+
+ public:
+  /**
+   * @brief Seconds on std::chrono::steady_clock, the default clock
+   */
+  static double steadySeconds();
+
+  /**
+   * @param percent Share of the wall time that may be spent writing, in percent
+   * @param clock Current wall time in seconds, replaced by tests to control the elapsed time
+   */
+  explicit WallTimeBudget(double percent, std::function<double()> clock = steadySeconds);
+  void start(const ParticleContainer& particles) override;
+  bool isDue(int iteration, double time, const ParticleContainer& particles) override;
+  void written(const ParticleContainer& particles, double seconds) override;
+  [[nodiscard]] std::string describe() const override;
+};
+
+/**
+ * @class DisplacementTrigger
+ * @brief Writes once the root mean square displacement of the particles since the last snapshot exceeds a threshold.
+ *
+ * Quiet phases produce few frames and fast events such as impacts many. Particles are matched by id, so particles
+ * removed or added since the last snapshot do not count. Along periodic dimensions the displacement is that of the
+ * nearest image, so particles wrapping across a periodic face do not count as moving a whole box length.
+ */
+class DisplacementTrigger final : public OutputSchedule {
+ private:
+  const double threshold;
+  const std::array<double, 3> periodicSize;
+  /**
+   * @brief Positions in the last snapshot, indexed by particle id
+   */
+  std::vector<std::array<double, 3>> reference;
+  std::vector<bool> present;
+
+  void remember(const ParticleContainer& particles);
+
+ public:
+  /**
+   * @param threshold RMS displacement that triggers a snapshot
+   * @param periodicSize Extent of the domain along periodic dimensions, 0 along all others
+   */
+  explicit DisplacementTrigger(double threshold, std::array<double, 3> periodicSize = {});
+  void start(const ParticleContainer& particles) override;
+  bool isDue(int iteration, double time, const ParticleContainer& particles) override;
+  void written(const ParticleContainer& particles, double seconds) override;
+  [[nodiscard]] std::string describe() const override;
+
+  /**
+   * @brief Root mean square displacement of the particles since the last snapshot
+   */
+  [[nodiscard]] double rmsDisplacement(const ParticleContainer& particles) const;
+};
+
+/**
+ * @brief Creates the output schedule of a policy
+ * @throws std::invalid_argument if the parameter is not positive, or above 100 percent for the wall time budget
+ */
+std::unique_ptr<OutputSchedule> createOutputSchedule(const OutputScheduleSettings& settings);
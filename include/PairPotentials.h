@@ -0,0 +1,98 @@
+/**
+ * @file PairPotentials.h
+ *
+ * Radial pair potentials that can be evaluated analytically or tabulated by \ref TabulatedForce "TabulatedForce".
+ */
+
+#pragma once
+
+#include <cmath>
+
+/**
+ * @namespace potentials
+ * @brief Radial pair potentials U(r).
+ *
+ * Every potential provides forceFactor(r2) = U'(r) / r as a function of the squared distance r2. The force acting
+ * on particle i due to particle j then is forceFactor(|x_j - x_i|^2) * (x_j - x_i).
+ */
+namespace potentials {
+
+/**
+ * @struct LennardJones
+ * @brief U(r) = 4 epsilon ((sigma / r)^12 - (sigma / r)^6)
+ */
+struct LennardJones {
+  double epsilon;
+  double sigma;
+
+  [[nodiscard]] double forceFactor(const double r2) const {
+    const double sigma_r2 = (sigma * sigma) / r2;
+    const double sigma_r6 = sigma_r2 * sigma_r2 * sigma_r2;
+    return 24.0 * epsilon / r2 * (sigma_r6 - 2.0 * sigma_r6 * sigma_r6);
+  }
+};
+
+/**
+ * @struct SmoothedLennardJones
+ * @brief Lennard-Jones potential smoothly switched off between r_l and r_c.
+ *
+ * U_s(r) = U(r) S(r) with S(r) = 1 for r <= r_l, S(r) = 0 for r >= r_c and
+ * S(r) = 1 - (r - r_l)^2 (3 r_c - r_l - 2 r) / (r_c - r_l)^3 in between, so that forces vanish continuously at r_c.
+ */
+struct SmoothedLennardJones {
+  double epsilon;
+  double sigma;
+  double r_l;
+  double r_c;
+
+  [[nodiscard]] double forceFactor(const double r2) const {
+    const LennardJones lj{epsilon, sigma};
+    if (r2 <= r_l * r_l) {
+      return lj.forceFactor(r2);
+    }
+    if (r2 >= r_c * r_c) {
+      return 0.0;
+    }
+    const double r = std::sqrt(r2);
+    const double sigma_r6 = std::pow(sigma * sigma / r2, 3);
+    const double u = 4.0 * epsilon * (sigma_r6 * sigma_r6 - sigma_r6);
+    const double width3 = std::pow(r_c - r_l, 3);
+    const double s = 1.0 - (r - r_l) * (r - r_l) * (3.0 * r_c - r_l - 2.0 * r) / width3;
+    const double ds = -6.0 * (r - r_l) * (r_c - r) / width3;
+    return lj.forceFactor(r2) * s + u * ds / r;
+  }
+};
+
+/**
+ * @struct Morse
+ * @brief U(r) = D (1 - exp(-a (r - r0)))^2
+ */
+struct Morse {
+  double depth;
+  double width;
+  double r0;
+
+  [[nodiscard]] double forceFactor(const double r2) const {
+    const double r = std::sqrt(r2);
+    const double e = std::exp(-width * (r - r0));
+    return 2.0 * depth * width * e * (1.0 - e) / r;
+  }
+};
+
+/**
+ * @struct Buckingham
+ * @brief U(r) = A exp(-r / rho) - C / r^6
+ */
+struct Buckingham {
+  double a;
+  double rho;
+  double c;
+
+  [[nodiscard]] double forceFactor(const double r2) const {
+    const double r = std::sqrt(r2);
+    const double r6 = r2 * r2 * r2;
+    return (-a / rho * std::exp(-r / rho) + 6.0 * c / (r6 * r)) / r;
+  }
+};
+
+}  // namespace potentials
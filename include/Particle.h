@@ -8,6 +8,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <ostream>
 #include <string>
 
@@ -61,6 +62,13 @@ class Particle {
    *
    */
   int type;
+
+  /**
+   * @brief Identifier of the particle
+   *
+   *  Assigned by the ParticleContainer on insertion and independent of the particle's storage index
+   */
+  std::size_t id = 0;
   ///@}
  public:
   /**@name Constructors */
@@ -111,6 +119,8 @@ class Particle {
   [[nodiscard]] double getM() const;
   /** @brief get type of particle */
   [[nodiscard]] int getType() const;
+  /** @brief get id of particle */
+  [[nodiscard]] std::size_t getId() const { return id; }
   ///@}
 
   /** @name Setter methods */
@@ -131,6 +141,10 @@ class Particle {
    *  @param val force vector as 3 element array
    */
   void setOldF(const std::array<double, 3>& val) { this->old_f = val; }
+  /** @brief set id of particle
+   *  @param val identifier, unique within a ParticleContainer
+   */
+  void setId(std::size_t val) { this->id = val; }
   ///@}
 
   /** @name Operators + Utilities */
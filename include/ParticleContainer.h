@@ -6,24 +6,46 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <utility>
 #include <vector>
 
 #include "Particle.h"
+#include "utils/HugePageAllocator.h"
 /**
  * @class ParticleContainer
  * @brief Iterable container class used for storing particles for a simulation.
  * It offers methods for adding, accessing particles and iterating through a set of particles
  * in an easy and efficient manner.
  *
+ * Every inserted particle receives an id that stays valid for its lifetime, independent of its storage index,
+ * which may change when other particles are removed.
+ *
+ * Particles are stored contiguously in a buffer obtained from \ref utils::HugePageAllocator "HugePageAllocator",
+ * which is cache-line aligned and backed by huge pages for large simulations.
  */
 class ParticleContainer {
+ public:
+  /**
+   * @brief Allocator used for the particle storage
+   *
+   * A type alias instead of a template parameter: the force calculations, integrators, boundary conditions and
+   * writers all take a ParticleContainer&, and a container template would turn all of them into templates. Swapping
+   * the allocator only requires changing this alias.
+   */
+  using allocator_type = utils::HugePageAllocator<Particle>;
+
  private:
   /**
    * @brief A set of particles
    */
-  std::vector<Particle> particles;
+  std::vector<Particle, allocator_type> particles;
+
+  /**
+   * @brief Id assigned to the next inserted particle
+   */
+  std::size_t nextId = 0;
 
  public:
   ParticleContainer() = default;
@@ -32,18 +54,78 @@ class ParticleContainer {
    * @brief Returns number of particles in the container
    */
   [[nodiscard]] std::size_t size() const;
+  /**
+   * @brief Returns number of particles the container can hold without reallocating
+   */
+  [[nodiscard]] std::size_t capacity() const;
+  /**
+   * @brief Pre-sizes the storage so that n particles can be added without reallocation
+   * @param n expected total number of particles
+   */
+  void reserve(std::size_t n);
   /**
    * @brief Adds a particle to the container
    * @param x position vector as a 3 element array
    * @param v velocity vector as a 3 element array
    * @param m mass
+   * @param type particle type
    */
-  void addParticle(std::array<double, 3> x, std::array<double, 3> v,
-                   double m);  // function called in FileReader
+  void addParticle(std::array<double, 3> x, std::array<double, 3> v, double m,
+                   int type = 0);  // function called in FileReader
   void addParticle(const Particle* p);
+  /**
+   * @brief Adds a batch of particles to the container, assigning each a new id
+   * @param batch particles to copy into the container
+   */
+  void addParticles(const std::vector<Particle>& batch);
+  /**
+   * @brief Appends copies of particles in the container, such as periodic halo copies, keeping their ids
+   *
+   * The copies share the id of the particle they copy and use up no new ids. They are meant to be removed with
+   * \ref truncate "truncate()" before particles are added again.
+   * @param halos copies to append
+   */
+  void addHalos(const std::vector<Particle>& halos);
+
+  /**
+   * @brief Removes the particle at the given storage index in O(1)
+   *
+   * The last particle is moved into the freed slot, so storage indices of other particles may change while their
+   * ids do not. Must not be called while iterating over the container.
+   * @param index storage index of the particle to remove
+   * @throws std::out_of_range if there is no particle at the index
+   */
+  void removeParticle(std::size_t index);
+  /**
+   * @brief Removes all particles matching a predicate in a single compacting pass
+   *
+   * The relative order of the remaining particles is preserved. Intended to be called between time steps,
+   * e.g. to delete particles which left the domain.
+   * @param predicate unary predicate returning true for particles to remove
+   * @return number of removed particles
+   */
+  template <typename Predicate>
+  std::size_t removeParticles(Predicate predicate) {
+    const auto newEnd = std::remove_if(particles.begin(), particles.end(), predicate);
+    const auto removed = static_cast<std::size_t>(particles.end() - newEnd);
+    particles.erase(newEnd, particles.end());
+    return removed;
+  }
+  /**
+   * @brief Removes all particles from storage index first onwards
+   * @param first storage index of the first particle to remove
+   */
+  void truncate(std::size_t first);
+
+  /**
+   * @brief Orders the particles by type, keeping the relative order within each type
+   *
+   * With sorted storage, consecutive pairs in the force kernels mostly share the same Lennard-Jones parameters.
+   */
+  void sortByType();
 
-  using iterator = std::vector<Particle>::iterator;
-  using const_iterator = std::vector<Particle>::const_iterator;
+  using iterator = std::vector<Particle, allocator_type>::iterator;
+  using const_iterator = std::vector<Particle, allocator_type>::const_iterator;
 
   // Iteration over single particles
   iterator begin();
@@ -1,8 +1,18 @@
 #pragma once
 
+#include "BoundaryConditions.h"
 #include "ForceCalc.h"
+#include "Integrator.h"
+#include "LennardJonesForceClusterPair.h"
+#include "OutputSchedule.h"
+#include "analysis/AnalysisPipeline.h"
+#include "io/CompressedWriter.h"
+#include "io/InitialStateCache.h"
+#include "io/SharedMemoryWriter.h"
+#include "io/XYZWriter.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 /**
@@ -15,6 +25,27 @@ enum class SimulationMode {
   FILE_OUTPUT
 };
 
+/**
+ * @enum OutputFormat
+ * @brief File format of the particle snapshots written in file output mode.
+ */
+enum class OutputFormat {
+  /** One binary .vtu file per snapshot, written without the VTK library, see outputWriter::VTUWriter */
+  VTU,
+  /** One .vtu file per snapshot, written with the VTK library (requires ENABLE_VTK_OUTPUT) */
+  VTK,
+  /** One .xyz file per snapshot with the positions only */
+  XYZ,
+  /** All snapshots appended to a single .xyz file with the positions only */
+  XYZ_TRAJECTORY,
+  /** A single quantized and delta-compressed file with all snapshots, see outputWriter::CompressedWriter */
+  COMPRESSED,
+  /** Several .vtu pieces per snapshot written in parallel and a .pvtu master file */
+  PVTU,
+  /** Snapshots published to a shared memory ring buffer for live viewers, see outputWriter::SharedMemoryWriter */
+  LIVE
+};
+
 /**
  * @class BaseSimulation
  * Abstract base class providing the core structure for building particle simulations.
@@ -46,16 +77,109 @@ protected:
    */
   std::unique_ptr<ForceCalc> forceCalc;
 
+  /**
+   * @brief Scheme that advances positions and velocities, velocity Störmer-Verlet by default.
+   */
+  std::unique_ptr<Integrator> integrator;
+
+  /**
+   * @brief Boundary conditions of the domain, nullptr for an unbounded domain.
+   */
+  std::unique_ptr<BoundaryConditions> boundaryConditions;
+
   /**
    * @brief Chosen simulation execution mode (benchmark/file output).
    */
   SimulationMode simulationMode;
 
   /**
-   * @brief Outputs the state of the particles for visualization in ParaView.
+   * @brief Directory that all output files of the simulation are written to.
+   */
+  std::string outputDirectory = "output";
+
+  /**
+   * @brief File format of the snapshots.
+   */
+  OutputFormat outputFormat = OutputFormat::VTU;
+
+  /**
+   * @brief Quantization of the compressed output.
+   */
+  outputWriter::CompressionSettings compressionSettings;
+
+  /**
+   * @brief Number of pieces per snapshot of the partitioned output, the number of threads if not positive.
+   */
+  int outputPieces = 0;
+
+  /**
+   * @brief Name of the shared memory segment of the live output.
+   */
+  std::string streamName = "molsim";
+
+  /**
+   * @brief Writer of the compressed output, created with the first snapshot.
+   */
+  std::unique_ptr<outputWriter::CompressedWriter> compressedWriter;
+
+  /**
+   * @brief Writer of the single file XYZ output, created with the first snapshot.
+   */
+  std::unique_ptr<outputWriter::XYZWriter> xyzWriter;
+
+  /**
+   * @brief Writer of the live output, created with the first snapshot.
+   */
+  std::unique_ptr<outputWriter::SharedMemoryWriter> liveWriter;
+
+  /**
+   * @brief Decides after which time steps the file output mode writes a snapshot, every 10 iterations by default.
+   */
+  std::unique_ptr<OutputSchedule> outputSchedule;
+
+  /**
+   * @brief Number of iterations between in-situ analyses, 0 if disabled.
+   */
+  int analysisInterval = 0;
+
+  /**
+   * @brief File format of the in-situ analysis time series.
+   */
+  analysis::SeriesFormat analysisFormat = analysis::SeriesFormat::CSV;
+
+  /**
+   * @brief In-situ analysis of the particle state, nullptr if disabled.
+   *
+   * Created and populated with observables by the scenario in \ref setupSimulation "setupSimulation()".
+   */
+  std::unique_ptr<analysis::AnalysisPipeline> analysis;
+
+  /**
+   * @brief Outputs the state of the particles in the selected \ref OutputFormat "OutputFormat".
+   * @param iteration Current simulation step in ticks.
+   */
+  void plotParticles(int iteration);
+
+  /**
+   * @brief Hands the state of the particles to the in-situ analysis if it is due at this iteration.
    * @param iteration Current simulation step in ticks.
+   * @param time Current simulated time.
+   * @param forces Potential energy and virial of the last force calculation, nullptr if not accumulated.
+   */
+  void analyse(int iteration, double time, const ForceObservables* forces = nullptr) const;
+
+  /**
+   * @brief Advances the particles by one time step, including the boundary conditions.
+   * @param forces If not nullptr, the force calculation also accumulates potential energy and virial into it.
+   */
+  void step(ForceObservables* forces = nullptr) const;
+
+  /**
+   * @brief Runs one time step, accumulating potential energy and virial only if the analysis is due afterwards.
+   * @param iteration Iteration reached by this step.
+   * @param time Simulated time reached by this step.
    */
-  void plotParticles(int iteration) const;
+  void stepAndAnalyse(int iteration, double time) const;
 
   /**
    * @brief Creates/loads the particles in the simulation.
@@ -67,15 +191,17 @@ protected:
   /**
    * @name Simulation run methods
    * @{
-   * @brief Runs the simulation in benchmark mode (no file output).
+   * @brief Runs the simulation with file output.
    */
-  void runFileOutput() const;
+  void runFileOutput();
 
   /**
-   * @brief Runs the simulation in benchmark mode (no file output).
+   * @brief Sets up and runs the simulation in benchmark mode (no file output).
+   *
+   * Besides the elapsed time, page faults and dTLB misses of the setup and of the time integration are reported.
    * @}
    */
-  void runBenchmark() const;
+  void runBenchmark();
 public:
   /**
    * @brief Constructor for \ref Simulation.
@@ -86,6 +212,40 @@ public:
   BaseSimulation(double end_time, double dt, SimulationMode simulationMode);
   virtual ~BaseSimulation();
 
+  /**
+   * @brief Enables the in-situ analysis of energies, temperature, momentum and radial distribution.
+   * @param interval Number of iterations between two analysed states.
+   * @param format File format of the resulting time series.
+   */
+  void enableAnalysis(int interval, analysis::SeriesFormat format = analysis::SeriesFormat::CSV);
+
+  /**
+   * @brief Sets the directory that all output files are written to, "output" by default.
+   * @param directory Output directory, created on first use.
+   */
+  void setOutputDirectory(std::string directory);
+
+  /**
+   * @brief Selects the file format of the snapshots written in file output mode, VTU by default.
+   * @param format File format.
+   * @param settings Quantization, only used by the compressed format.
+   * @param pieces Pieces per snapshot, only used by the partitioned format; the number of threads if not positive.
+   * @param stream Name of the shared memory segment, only used by the live output.
+   */
+  void setOutputFormat(OutputFormat format, outputWriter::CompressionSettings settings = {}, int pieces = 0,
+                       std::string stream = "molsim");
+
+  /**
+   * @brief Selects when the file output mode writes snapshots, every 10 iterations by default.
+   * @throws std::invalid_argument if the parameter of the policy is invalid
+   */
+  void setOutputSchedule(const OutputScheduleSettings& settings);
+
+  /**
+   * @brief Selects the time integration scheme, velocity Störmer-Verlet by default.
+   */
+  void setIntegrator(IntegrationScheme scheme);
+
   /**
    * @brief The entry-point of the simulation.
    */
@@ -97,6 +257,7 @@ public:
  * @brief Simulation setup for a collision scenario using cuboids from an input file.
  *
  * Implements the initialization of particles for the collision experiments in Assignment 2.
+ * Particle types without parameters in the input file use epsilon = 5 and sigma = 1.
  */
 class CollisionSimulation : public BaseSimulation {
 private:
@@ -104,6 +265,31 @@ private:
    * @brief Path to the input file containing the cuboids.
    */
   std::string inputFilename;
+
+  /**
+   * @brief Domain and boundary conditions, std::nullopt for an unbounded domain.
+   */
+  std::optional<BoundaryConfig> boundaryConfig;
+
+  /**
+   * @brief Whether the particles are ordered by type after loading them.
+   */
+  bool sortByType;
+
+  /**
+   * @brief Cache of generated initial states, std::nullopt to always generate the particles.
+   */
+  std::optional<InitialStateCache> initialStateCache;
+protected:
+  /**
+   * @brief Particles per cluster of the cluster pair force calculation, 0 for the plain pair loop.
+   */
+  std::size_t clusterSize = 0;
+
+  /**
+   * @brief Sleep criteria of the clusters, std::nullopt if all pairs are evaluated every step.
+   */
+  std::optional<SleepSettings> sleepSettings;
 public:
   /**
    * @brief Constructor for \ref CollisionSimulation.
@@ -111,20 +297,98 @@ public:
    * @param end_time Total simulation time.
    * @param dt Time step size.
    * @param simulationMode Selected simulation mode.
+   * @param boundaryConfig Domain and boundary conditions, std::nullopt for an unbounded domain.
+   * @param sortByType Order the particles by type so that neighbouring pairs share their parameters.
+   */
+  CollisionSimulation(std::string inputFilename, double end_time, double dt, SimulationMode simulationMode,
+                      std::optional<BoundaryConfig> boundaryConfig = std::nullopt, bool sortByType = false);
+
+  /**
+   * @brief Selects the serial cluster pair force calculation, see
+   * \ref LennardJonesForceClusterPair "LennardJonesForceClusterPair".
+   * @param size Particles per cluster, 4 or 8, or 0 for the plain pair loop (default).
+   * @throws std::invalid_argument for other cluster sizes
+   */
+  void setClusterSize(std::size_t size);
+
+  /**
+   * @brief Lets clusters of the cluster pair force calculation at rest fall asleep, see
+   * \ref SleepSettings "SleepSettings".
+   * @param settings Sleep criteria, std::nullopt to evaluate all pairs every step (default).
+   */
+  void setSleeping(std::optional<SleepSettings> settings);
+
+  /**
+   * @brief Takes the initial particles from a cache of generated states instead of generating them, see
+   * \ref InitialStateCache "InitialStateCache".
+   * @param cache Cache to use, std::nullopt to always generate the particles (default).
    */
-  CollisionSimulation(std::string inputFilename, double end_time, double dt, SimulationMode simulationMode);
+  void setInitialStateCache(std::optional<InitialStateCache> cache);
 protected:
   /**
-   * @brief Loads the cuboids from the input file and populates the particle container.
+   * @brief Loads the cuboids from the input file, populates the particle container and sets up the forces.
    */
   void setupSimulation() override;
+
+  /**
+   * @brief Creates the Lennard-Jones force calculation used by the scenario.
+   * @param mixing Lennard-Jones parameters of all particle types.
+   * @param cutoffRadius Cutoff radius of the interactions.
+   */
+  virtual std::unique_ptr<ForceCalc> createForceCalc(MixingTable mixing, double cutoffRadius);
 };
 
-class CollisionSimulationParallel : public BaseSimulation {
+/**
+ * @class CollisionSimulationParallel
+ * @brief Collision scenario using the OpenMP parallel Lennard-Jones force calculation.
+ */
+class CollisionSimulationParallel : public CollisionSimulation {
 private:
-  std::string inputFilename;
+  /**
+   * @brief Distribution of the pair loop over the threads.
+   */
+  Schedule schedule = Schedule::GUIDED;
 public:
-  CollisionSimulationParallel(std::string inputFilename, double end_time, double dt, SimulationMode simulationMode);
+  using CollisionSimulation::CollisionSimulation;
+
+  /**
+   * @brief Selects the distribution of the pair loop over the threads, guided by default.
+   */
+  void setSchedule(Schedule newSchedule);
 protected:
-  void setupSimulation() override;
-};
\ No newline at end of file
+  std::unique_ptr<ForceCalc> createForceCalc(MixingTable mixing, double cutoffRadius) override;
+};
+
+/**
+ * @class CollisionSimulationAutoTuned
+ * @brief Collision scenario that selects the fastest Lennard-Jones force calculation at runtime, see
+ * \ref AutoTunedForce "AutoTunedForce".
+ */
+class CollisionSimulationAutoTuned : public CollisionSimulation {
+private:
+  /**
+   * @brief Number of time steps from one trial of all force calculations to the next.
+   */
+  std::size_t retuneInterval = 1000;
+public:
+  using CollisionSimulation::CollisionSimulation;
+
+  /**
+   * @brief Sets the number of time steps from one trial of all force calculations to the next, 1000 by default.
+   */
+  void setRetuneInterval(std::size_t interval);
+protected:
+  std::unique_ptr<ForceCalc> createForceCalc(MixingTable mixing, double cutoffRadius) override;
+};
+
+/**
+ * @class CollisionSimulationDeterministic
+ * @brief Collision scenario using the OpenMP parallel Lennard-Jones force calculation whose trajectories are bitwise
+ * identical to \ref CollisionSimulation "CollisionSimulation" for any number of threads.
+ */
+class CollisionSimulationDeterministic : public CollisionSimulation {
+public:
+  using CollisionSimulation::CollisionSimulation;
+protected:
+  std::unique_ptr<ForceCalc> createForceCalc(MixingTable mixing, double cutoffRadius) override;
+};
@@ -0,0 +1,145 @@
+/**
+ * @file SimulationOptions.h
+ *
+ */
+
+#pragma once
+
+#include "BoundaryConditions.h"
+#include "Simulation.h"
+#include "analysis/AnalysisPipeline.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @enum Parallelization
+ * @brief Force calculation selected by the P:OFF, P:ON, P:DET and P:AUTO options.
+ */
+enum class Parallelization {
+  /** Serial force calculation */
+  OFF,
+  /** OpenMP parallel force calculation with atomic updates, fastest but not reproducible */
+  ON,
+  /** OpenMP parallel force calculation with results bitwise identical to OFF for any number of threads */
+  DETERMINISTIC,
+  /** The fastest of the above, measured periodically at runtime */
+  AUTO
+};
+
+/**
+ * @struct SimulationOptions
+ * @brief Optional settings of a collision simulation, given as KEY:VALUE arguments on the command line or in an
+ * ensemble manifest.
+ */
+struct SimulationOptions {
+  /**
+   * @brief Force calculation to use (P:OFF, P:ON, P:DET or P:AUTO).
+   */
+  Parallelization parallelization = Parallelization::OFF;
+
+  /**
+   * @brief Time steps between two trials of all force calculations with P:AUTO (AUTOTUNE:<interval>).
+   */
+  std::size_t retuneInterval = 1000;
+
+  /**
+   * @brief Distribution of the pair loop of P:ON over the threads (SCHEDULE:GUIDED or SCHEDULE:STEAL).
+   */
+  Schedule schedule = Schedule::GUIDED;
+
+  /**
+   * @brief Time integration scheme (INTEGRATOR:VERLET or INTEGRATOR:FOREST_RUTH).
+   */
+  IntegrationScheme integrator = IntegrationScheme::VERLET;
+
+  /**
+   * @brief Particles per cluster of the serial cluster pair force calculation (CLUSTER:4 or CLUSTER:8), 0 for the
+   * plain pair loop.
+   */
+  std::size_t clusterSize = 0;
+
+  /**
+   * @brief Sleep criteria of the clusters (SLEEP:<quiet steps>[,<displacement>,<force change>][,verify][,strict]),
+   * std::nullopt if all pairs are evaluated.
+   */
+  std::optional<SleepSettings> sleepSettings;
+
+  /**
+   * @brief Domain and boundary conditions (BC:<faces> DOMAIN:<x0,y0,z0,x1,y1,z1>), std::nullopt if unbounded.
+   */
+  std::optional<BoundaryConfig> boundaryConfig;
+
+  /**
+   * @brief Order the particles by type after loading them (SORT:TYPE).
+   */
+  bool sortByType = false;
+
+  /**
+   * @brief Directory of the cache of generated initial states (CACHE:<directory>[,refresh]), empty if disabled.
+   */
+  std::string cacheDirectory;
+
+  /**
+   * @brief Regenerate and overwrite cached initial states instead of loading them (CACHE:<directory>,refresh).
+   */
+  bool refreshCache = false;
+
+  /**
+   * @brief Iterations between in-situ analyses (ANALYSIS:<interval>[,csv|,bin]), 0 if disabled.
+   */
+  int analysisInterval = 0;
+
+  /**
+   * @brief File format of the in-situ analysis time series.
+   */
+  analysis::SeriesFormat analysisFormat = analysis::SeriesFormat::CSV;
+
+  /**
+   * @brief File format of the snapshots
+   * (OUTPUT:vtu|vtk|xyz[,single]|compressed[,<position precision>]|pvtu[,<pieces>]|live[,<name>]).
+   */
+  OutputFormat outputFormat = OutputFormat::VTU;
+
+  /**
+   * @brief When snapshots are written (FRAMES:iterations|time|budget|change,<value>), every 10 iterations by default.
+   */
+  OutputScheduleSettings outputSchedule;
+
+  /**
+   * @brief Quantization of the compressed output.
+   */
+  outputWriter::CompressionSettings compressionSettings;
+
+  /**
+   * @brief Pieces per snapshot of the partitioned output, the number of threads if 0.
+   */
+  int outputPieces = 0;
+
+  /**
+   * @brief Name of the shared memory segment of the live output.
+   */
+  std::string streamName = "molsim";
+
+  /**
+   * @brief Parses a list of KEY:VALUE arguments.
+   * @param arguments Arguments such as P:DET, BC:oopprr, DOMAIN:0,0,0,10,10,1, SORT:TYPE, ANALYSIS:100,bin or
+   * OUTPUT:compressed,1e-4
+   * @return The parsed options, with defaults for all arguments that are not given
+   * @throws std::invalid_argument if an argument is unknown or malformed, or selects OUTPUT:vtk in a build without VTK
+   */
+  static SimulationOptions parse(const std::vector<std::string>& arguments);
+
+  /**
+   * @brief Creates the collision simulation configured by these options.
+   * @param inputFilename Path to the input cuboid file.
+   * @param end_time Total simulation time.
+   * @param dt Time step size.
+   * @param simulationMode Selected simulation mode.
+   */
+  [[nodiscard]] std::unique_ptr<CollisionSimulation> createSimulation(const std::string& inputFilename,
+                                                                      double end_time, double dt,
+                                                                      SimulationMode simulationMode) const;
+};
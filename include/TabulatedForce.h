@@ -0,0 +1,87 @@
+/**
+ * @file TabulatedForce.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "ForceCalc.h"
+
+/**
+ * @enum Interpolation
+ * @brief Interpolation scheme used between the grid points of a \ref TabulatedForce "TabulatedForce".
+ */
+enum class Interpolation {
+  /** Piecewise linear, second order accurate */
+  LINEAR,
+  /** Catmull-Rom cubic, third order accurate */
+  CUBIC
+};
+
+/**
+ * @class TabulatedForce
+ * @brief Pair force evaluated by interpolation in a table precomputed at startup.
+ *
+ * The force factor U'(r) / r of an arbitrary radial potential (see \ref PairPotentials.h) is sampled on a uniform
+ * grid in r^2 between minRadius and the cutoff radius. The pair loop then only needs the squared distance, no square
+ * root and no potential specific arithmetic, so smoothed or otherwise expensive potentials cost the same as plain
+ * Lennard-Jones. Distances below minRadius fall back to evaluating the potential directly.
+ */
+class TabulatedForce final : public ForceCalc {
+ private:
+  /**
+   * @brief Exact force factor as a function of r^2, used to fill the table and below minRadius
+   */
+  std::function<double(double)> forceFactor;
+  const double r2Min, r2Cutoff;
+  const Interpolation interpolation;
+
+  /**
+   * @brief Inverse grid spacing in r^2
+   */
+  double invSpacing;
+
+  /**
+   * @brief Force factors at r2Min + (i - 1) / invSpacing, padded by one point in front and two at the end
+   */
+  std::vector<double> table;
+
+ public:
+  /**
+   * @param particles ParticleContainer that stores the particles used by the calculation method
+   * @param forceFactor Force factor U'(r) / r of the potential as a function of r^2
+   * @param minRadius Smallest tabulated distance
+   * @param cutoffRadius Largest tabulated distance, pairs at or beyond it are not calculated
+   * @param tableSize Number of grid points, the interpolation error decreases with its square (linear) or cube (cubic)
+   * @param interpolation Interpolation scheme between grid points
+   */
+  TabulatedForce(ParticleContainer& particles, std::function<double(double)> forceFactor, double minRadius,
+                 double cutoffRadius, std::size_t tableSize, Interpolation interpolation = Interpolation::CUBIC);
+
+  /**
+   * @brief Convenience constructor for the potentials from \ref PairPotentials.h
+   */
+  template <typename Potential>
+  TabulatedForce(ParticleContainer& particles, const Potential& potential, double minRadius, double cutoffRadius,
+                 std::size_t tableSize, Interpolation interpolation = Interpolation::CUBIC)
+      : TabulatedForce(particles,
+                       std::function<double(double)>([potential](double r2) { return potential.forceFactor(r2); }),
+                       minRadius, cutoffRadius, tableSize, interpolation) {}
+
+  /**
+   * @brief Interpolated force factor for a squared distance within the cutoff radius
+   * @param r2 Squared distance between two particles
+   */
+  [[nodiscard]] double interpolate(double r2) const;
+
+  using ForceCalc::calculateF;
+
+  /**
+   * @brief Calculates the tabulated pair forces acting on the particles
+   */
+  void calculateF() override;
+};
@@ -0,0 +1,106 @@
+/**
+ * @file AnalysisPipeline.h
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParticleContainer.h"
+#include "analysis/Observables.h"
+
+namespace analysis {
+
+/**
+ * @enum SeriesFormat
+ * @brief File format of the observable time series.
+ */
+enum class SeriesFormat {
+  /** One text line per snapshot with a header line */
+  CSV,
+  /** Raw native-endian doubles, one record of (iteration, time, values...) per snapshot */
+  BINARY
+};
+
+/**
+ * @class AnalysisPipeline
+ * @brief Evaluates registered \ref Observable "Observables" on a background thread every N iterations.
+ *
+ * The simulation thread only copies the particle state into a \ref Snapshot "Snapshot" and queues it. A worker thread
+ * evaluates all observables on the snapshot and appends one record per observable to
+ * output/<observable name>.csv (or .bin, with the column names in a .header file next to it).
+ * At most a few snapshots are queued; should the analysis fall behind, submit() waits for the worker.
+ */
+class AnalysisPipeline {
+ private:
+  const std::string outputDirectory;
+  const int interval;
+  const SeriesFormat format;
+
+  std::vector<std::unique_ptr<Observable>> observables;
+  std::vector<std::ofstream> outputs;
+
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable queueChanged;
+  std::deque<Snapshot> queue;
+  bool stopping = false;
+
+  /**
+   * @brief Largest number of snapshots waiting for the worker
+   */
+  static constexpr std::size_t maxQueued = 4;
+
+  void openOutputs();
+  void process(const Snapshot& snapshot);
+  void workerLoop();
+
+ public:
+  /**
+   * @param outputDirectory Directory the time series are written to
+   * @param interval Number of iterations between two analysed snapshots
+   * @param format File format of the time series
+   */
+  AnalysisPipeline(std::string outputDirectory, int interval, SeriesFormat format = SeriesFormat::CSV);
+  ~AnalysisPipeline();
+
+  AnalysisPipeline(const AnalysisPipeline&) = delete;
+  AnalysisPipeline& operator=(const AnalysisPipeline&) = delete;
+
+  /**
+   * @brief Registers an analysis plugin. All plugins must be registered before the first snapshot is submitted.
+   * @param observable Plugin to evaluate on every snapshot
+   */
+  void addObservable(std::unique_ptr<Observable> observable);
+
+  /**
+   * @brief Whether a snapshot should be taken at the given iteration
+   */
+  [[nodiscard]] bool isDue(int iteration) const { return iteration % interval == 0; }
+
+  /**
+   * @brief Copies the particle state and queues it for analysis
+   * @param iteration Current iteration
+   * @param time Current simulated time
+   * @param particles Particles of the simulation
+   * @param forces Potential energy and virial accumulated by the last force calculation, nullptr if not available
+   */
+  void submit(int iteration, double time, const ParticleContainer& particles,
+              const ForceObservables* forces = nullptr);
+
+  /**
+   * @brief Processes all queued snapshots and stops the worker thread
+   */
+  void finish();
+};
+
+}  // namespace analysis
@@ -0,0 +1,180 @@
+/**
+ * @file Observables.h
+ *
+ * Analysis plugins evaluated in-situ by the \ref analysis::AnalysisPipeline "AnalysisPipeline".
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ForceCalc.h"
+#include "MixingTable.h"
+#include "Particle.h"
+
+namespace analysis {
+
+/**
+ * @struct Snapshot
+ * @brief Copy of the particle state at one iteration, owned by the analysis thread.
+ */
+struct Snapshot {
+  int iteration;
+  double time;
+  std::vector<Particle> particles;
+  /**
+   * @brief Potential energy and virial accumulated by the force calculation, if valid
+   */
+  ForceObservables forces;
+};
+
+/**
+ * @class Observable
+ * @brief Base class of all analysis plugins.
+ *
+ * An observable reduces a \ref Snapshot "Snapshot" to a fixed number of values, which the pipeline appends as one
+ * row to the observable's time series.
+ */
+class Observable {
+ public:
+  virtual ~Observable();
+
+  /**
+   * @brief Name of the observable, used as the name of its output file
+   */
+  [[nodiscard]] virtual std::string name() const = 0;
+
+  /**
+   * @brief Names of the values returned by \ref evaluate "evaluate()"
+   */
+  [[nodiscard]] virtual std::vector<std::string> columns() const = 0;
+
+  /**
+   * @brief Computes the observable for a snapshot
+   * @param snapshot Particle state to analyse
+   * @return One value per column
+   */
+  virtual std::vector<double> evaluate(const Snapshot& snapshot) = 0;
+};
+
+/**
+ * @class KineticEnergy
+ * @brief Total kinetic energy sum_i m_i v_i^2 / 2
+ */
+class KineticEnergy final : public Observable {
+ public:
+  [[nodiscard]] std::string name() const override { return "kinetic_energy"; }
+  [[nodiscard]] std::vector<std::string> columns() const override { return {"E_kin"}; }
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+/**
+ * @class PotentialEnergy
+ * @brief Total Lennard-Jones potential energy of all pairs within the cutoff radius
+ *
+ * Uses the energy accumulated by the force calculation if the snapshot carries it, which also includes pairs across
+ * periodic boundaries. Otherwise, the pairs of the snapshot are summed up once more.
+ */
+class PotentialEnergy final : public Observable {
+ private:
+  const MixingTable mixing;
+  const double cutoffRadius;
+
+ public:
+  /**
+   * @param mixing Lennard-Jones parameters of all particle types
+   * @param cutoffRadius Distance beyond which pairs do not contribute
+   */
+  PotentialEnergy(MixingTable mixing, double cutoffRadius);
+  [[nodiscard]] std::string name() const override { return "potential_energy"; }
+  [[nodiscard]] std::vector<std::string> columns() const override { return {"E_pot"}; }
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+/**
+ * @class Temperature
+ * @brief Kinetic temperature T = 2 E_kin / (d N) in units with k_B = 1
+ */
+class Temperature final : public Observable {
+ private:
+  const int dimensions;
+
+ public:
+  /**
+   * @param dimensions Number of degrees of freedom per particle (2 or 3)
+   */
+  explicit Temperature(int dimensions);
+  [[nodiscard]] std::string name() const override { return "temperature"; }
+  [[nodiscard]] std::vector<std::string> columns() const override { return {"T"}; }
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+/**
+ * @class Momentum
+ * @brief Total linear momentum sum_i m_i v_i
+ */
+class Momentum final : public Observable {
+ public:
+  [[nodiscard]] std::string name() const override { return "momentum"; }
+  [[nodiscard]] std::vector<std::string> columns() const override { return {"p_x", "p_y", "p_z"}; }
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+/**
+ * @class Pressure
+ * @brief Virial pressure P = (2 E_kin + tr W) / (d V) and the virial tensor W of the force calculation
+ *
+ * The volume is that of the simulation domain if there is one, otherwise the bounding box of the particles. Requires
+ * the virial accumulated by the force calculation; all values are NaN for snapshots without it, e.g. the initial
+ * state.
+ */
+class Pressure final : public Observable {
+ private:
+  const int dimensions;
+  const std::optional<std::array<double, 3>> domainSize;
+
+ public:
+  /**
+   * @param dimensions Dimensionality of the system (2 or 3)
+   * @param domainSize Extent of the simulation domain, std::nullopt to use the bounding box of the particles
+   */
+  explicit Pressure(int dimensions, std::optional<std::array<double, 3>> domainSize = std::nullopt);
+  [[nodiscard]] std::string name() const override { return "pressure"; }
+  [[nodiscard]] std::vector<std::string> columns() const override;
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+/**
+ * @class RadialDistribution
+ * @brief Histogram of the radial distribution function g(r) up to a maximum distance
+ *
+ * The pair counts of each shell are normalized by the count expected for an ideal gas of the same density, where the
+ * density is taken from the simulation domain if there is one, otherwise from the bounding box of the particles. In
+ * 2D, shells are rings and the volume is an area.
+ */
+class RadialDistribution final : public Observable {
+ private:
+  const double rMax;
+  const std::size_t bins;
+  const int dimensions;
+  const std::optional<std::array<double, 3>> domainSize;
+
+ public:
+  /**
+   * @param rMax Largest distance in the histogram
+   * @param bins Number of histogram bins
+   * @param dimensions Dimensionality of the system (2 or 3)
+   * @param domainSize Extent of the simulation domain, std::nullopt to use the bounding box of the particles
+   */
+  RadialDistribution(double rMax, std::size_t bins, int dimensions,
+                     std::optional<std::array<double, 3>> domainSize = std::nullopt);
+  [[nodiscard]] std::string name() const override { return "rdf"; }
+  [[nodiscard]] std::vector<std::string> columns() const override;
+  std::vector<double> evaluate(const Snapshot& snapshot) override;
+};
+
+}  // namespace analysis
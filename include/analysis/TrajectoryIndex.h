@@ -0,0 +1,143 @@
+/**
+ * @file TrajectoryIndex.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace analysis {
+
+/**
+ * @struct FrameSummary
+ * @brief Location and summary statistics of one snapshot file of a run.
+ */
+struct FrameSummary {
+  int iteration = 0;
+  double time = 0;
+  /**
+   * @brief Path of the snapshot, relative to the directory of the run
+   */
+  std::string file;
+  /**
+   * @brief Size and modification time of the snapshot file, to detect rewritten files
+   */
+  std::uint64_t fileBytes = 0;
+  std::int64_t fileTime = 0;
+  std::uint64_t particles = 0;
+  /**
+   * @brief Byte offsets of the positions, velocities and ids in the file, 0 if the file has no ids
+   */
+  std::uint64_t pointsOffset = 0;
+  std::uint64_t velocityOffset = 0;
+  std::uint64_t idOffset = 0;
+  /**
+   * @brief Bounding box of the particles
+   */
+  std::array<double, 3> lower{};
+  std::array<double, 3> upper{};
+  double kineticEnergy = 0;
+  double maxSpeed = 0;
+};
+
+/**
+ * @class TrajectoryIndex
+ * @brief Sidecar index over the binary .vtu snapshots of a run for queries without reading the snapshots.
+ *
+ * Building the index reads every snapshot once and records where its arrays are and a few summary statistics.
+ * Queries on the statistics, such as all frames whose fastest particle exceeds a speed, are then answered from the
+ * index alone, and the track of a single particle only reads its position from each snapshot.
+ *
+ * The index is stored as a tab separated text file with one line per frame, so scripts can use it directly.
+ */
+class TrajectoryIndex {
+ private:
+  std::string directory;
+  double dt = 1.0;
+  std::vector<FrameSummary> frames;
+
+ public:
+  /**
+   * @brief Name of the index file in the directory of the run
+   */
+  static constexpr const char* filename = "trajectory.index";
+
+  /**
+   * @brief Indexes the snapshots <prefix>_<iteration>.vtu in a directory
+   *
+   * Frames of a previous index whose files are unchanged are taken over without reading them again, so a growing run
+   * can be indexed repeatedly at little cost.
+   * @param directory Directory of the run
+   * @param dt Time step of the run, to convert iterations to time
+   * @param prefix File name prefix of the snapshots
+   * @param previous Index built before, if any
+   * @throws std::runtime_error if a snapshot cannot be read
+   */
+  static TrajectoryIndex build(const std::string& directory, double dt, const std::string& prefix = "MD_vtu",
+                               const TrajectoryIndex* previous = nullptr);
+
+  /**
+   * @brief Loads the index stored in the directory of a run
+   * @return The index, or std::nullopt if there is none
+   * @throws std::runtime_error if the index file is corrupt
+   */
+  static std::optional<TrajectoryIndex> load(const std::string& directory);
+
+  /**
+   * @brief Stores the index in the directory of the run
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save() const;
+
+  [[nodiscard]] const std::vector<FrameSummary>& getFrames() const { return frames; }
+  [[nodiscard]] double getTimeStep() const { return dt; }
+
+  /**
+   * @brief Names of the statistics that \ref select "select()" accepts
+   */
+  static const std::vector<std::string>& fields();
+
+  /**
+   * @brief Value of a statistic of a frame
+   * @param frame Frame to evaluate
+   * @param field One of \ref fields "fields()"
+   * @throws std::invalid_argument for unknown fields
+   */
+  static double value(const FrameSummary& frame, const std::string& field);
+
+  /**
+   * @brief Frames whose statistic compares to a threshold, in time order
+   * @param field One of \ref fields "fields()"
+   * @param comparison One of <, <=, >, >=
+   * @param threshold Value compared with
+   * @throws std::invalid_argument for unknown fields or comparisons
+   */
+  [[nodiscard]] std::vector<FrameSummary> select(const std::string& field, const std::string& comparison,
+                                                 double threshold) const;
+
+  /**
+   * @brief Position and velocity of one particle in a frame
+   */
+  struct TrackPoint {
+    int iteration;
+    double time;
+    std::array<double, 3> x;
+    std::array<double, 3> v;
+  };
+
+  /**
+   * @brief Follows one particle through all frames, reading only its values from each snapshot
+   * @param id Id of the particle, its storage index for snapshots without ids
+   * @return One point per frame that contains the particle
+   * @throws std::runtime_error if a snapshot cannot be read
+   */
+  [[nodiscard]] std::vector<TrackPoint> track(std::size_t id) const;
+};
+
+}  // namespace analysis
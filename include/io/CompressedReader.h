@@ -0,0 +1,66 @@
+/**
+ * @file CompressedReader.h
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+#include "io/CompressedWriter.h"
+
+/**
+ * @class CompressedReader
+ * @brief Decodes the snapshot files written by \ref outputWriter::CompressedWriter "CompressedWriter" frame by frame.
+ *
+ * Decoded particles carry their id, position, velocity, force, mass and type, rounded to the resolution of the file.
+ */
+class CompressedReader {
+ private:
+  /**
+   * @brief Quantized state and constant properties of a particle, indexed by id
+   */
+  struct State {
+    std::array<std::int64_t, 9> q{};
+    double m = 0;
+    int type = 0;
+    std::uint64_t frame = 0;
+  };
+
+  std::ifstream file;
+  outputWriter::CompressedHeader header{};
+  std::vector<State> states;
+  std::uint64_t frames = 0;
+
+ public:
+  /**
+   * @brief A decoded snapshot
+   */
+  struct Frame {
+    int iteration;
+    std::vector<Particle> particles;
+  };
+
+  /**
+   * @param filename Path of a compressed snapshot file
+   * @throws std::runtime_error if the file cannot be opened or is not a compressed snapshot file
+   */
+  explicit CompressedReader(const std::string& filename);
+
+  /**
+   * @brief Quantization parameters of the file
+   */
+  [[nodiscard]] const outputWriter::CompressedHeader& getHeader() const { return header; }
+
+  /**
+   * @brief Decodes the next frame
+   * @return The frame, or std::nullopt at the end of the file
+   * @throws std::runtime_error if the file is truncated or corrupt
+   */
+  std::optional<Frame> nextFrame();
+};
@@ -0,0 +1,118 @@
+/**
+ * @file CompressedWriter.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @struct CompressionSettings
+ * @brief Quantization of the compressed snapshot output.
+ */
+struct CompressionSettings {
+  /**
+   * @brief Position resolution as a fraction of the domain extent in every dimension
+   */
+  double positionPrecision = 1e-5;
+  /**
+   * @brief Absolute velocity resolution
+   */
+  double velocityStep = 1e-4;
+  /**
+   * @brief Absolute force resolution
+   */
+  double forceStep = 1e-3;
+};
+
+/**
+ * @struct CompressedHeader
+ * @brief Quantization parameters stored at the start of a compressed snapshot file.
+ */
+struct CompressedHeader {
+  std::array<double, 3> origin;
+  std::array<double, 3> positionStep;
+  double velocityStep;
+  double forceStep;
+};
+
+/**
+ * @brief Identifies compressed snapshot files, "MDC" followed by the format version
+ */
+inline constexpr std::array<char, 4> compressedMagic = {'M', 'D', 'C', '1'};
+
+/**
+ * @class CompressedWriter
+ * @brief Writes all snapshots of a simulation into a single quantized, delta-encoded and entropy-coded file.
+ *
+ * Positions, velocities and forces are rounded to integer multiples of the steps given by the
+ * \ref CompressionSettings "CompressionSettings", the position grid being anchored at the lower domain corner.
+ * Each frame stores, per particle, the difference of its id to the previous particle's id and the difference of its
+ * quantized values to those of the same particle in the previous frame, as zigzag varints. Mass and type are only
+ * stored when a particle first appears. The bytes of every frame are then packed with a Huffman code of their own.
+ * Since the deltas are taken between quantized values, the error does not accumulate over frames.
+ *
+ * File layout: magic, \ref CompressedHeader "CompressedHeader", then per frame the raw and the encoded size (two
+ * native uint64) followed by the encoded bytes. Use \ref CompressedReader "CompressedReader" to decode it.
+ */
+class CompressedWriter {
+ private:
+  /**
+   * @brief Quantized state of a particle in the last frame
+   */
+  struct State {
+    std::array<std::int64_t, 9> q{};
+    std::uint64_t frame = 0;
+  };
+
+  const std::string filename;
+  const CompressionSettings settings;
+  std::ofstream file;
+  CompressedHeader header{};
+
+  /**
+   * @brief Quantized state indexed by particle id
+   */
+  std::vector<State> states;
+
+  /**
+   * @brief Number of frames written, frame numbers in states are one-based
+   */
+  std::uint64_t frames = 0;
+
+  void open(const std::array<double, 3>& lower, const std::array<double, 3>& upper);
+
+ public:
+  /**
+   * @param filename Path of the output file, its directory is created if necessary
+   * @param settings Resolution of positions, velocities and forces
+   */
+  explicit CompressedWriter(std::string filename, CompressionSettings settings = {});
+
+  /**
+   * @brief Sets the domain the positions are quantized relative to. Must be called before the first frame; without
+   * it, the bounding box of the first frame is used.
+   * @param lower Lower corner of the domain
+   * @param upper Upper corner of the domain
+   */
+  void setDomain(const std::array<double, 3>& lower, const std::array<double, 3>& upper);
+
+  /**
+   * @brief Appends one frame to the file
+   * @param particles Particles of the simulation
+   * @param iteration Current iteration number
+   * @throws std::overflow_error if a value is not finite or too large for the quantization
+   */
+  void plotParticles(const ParticleContainer& particles, int iteration);
+};
+
+}  // namespace outputWriter
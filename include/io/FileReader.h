@@ -1,6 +1,14 @@
 #pragma once
 
+#include "MixingTable.h"
 #include "ParticleContainer.h"
+#include "io/InitialStateCache.h"
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
 
 /**
  * @class BaseFileReader
@@ -32,6 +40,7 @@ public:
    * XYZ position, XYZ velocity, and mass.
    *
    * @param particles ParticleContainer which will hold the particles read from the file.
+   * @throws std::runtime_error if the file cannot be opened or is malformed
    */
   virtual void readFile(ParticleContainer& particles);
 };
@@ -39,11 +48,70 @@ public:
 /**
  * @class CuboidFileReader
  * @brief File reader that loads cuboids of particles.
+ *
+ * Each cuboid may optionally specify a particle type together with the Lennard-Jones epsilon and sigma of that type.
  */
 class CuboidFileReader : BaseFileReader {
+private:
+  /**
+   * @brief Parameters of a single cuboid as read from the input file.
+   */
+  struct CuboidSpec {
+    std::array<double, 3> x;
+    std::array<double, 3> v;
+    std::array<int, 3> n;
+    double h;
+    double m;
+    double t;
+    int type;
+  };
+
+  /**
+   * @brief Lennard-Jones parameters of the particle types that specify them in the input file.
+   */
+  std::map<int, Species> species;
+
+  /**
+   * @brief Largest particle type read from the file.
+   */
+  int maxType = 0;
+
+  /**
+   * @brief Number of dimensions spanned by the cuboids, see \ref getDimensions "getDimensions()".
+   */
+  int dimensions = 2;
+
+  /**
+   * @brief Parses all cuboids of the input file and records their particle types and dimensionality.
+   */
+  std::vector<CuboidSpec> parseCuboids();
+
+  /**
+   * @brief Expands the cuboids into particles with Maxwell-Boltzmann distributed velocities.
+   */
+  static void generate(const std::vector<CuboidSpec>& cuboids, ParticleContainer& particles);
+
 public:
   using BaseFileReader::BaseFileReader;
 
+  /**
+   * @brief Returns the Lennard-Jones parameters of all particle types read from the file, indexed by type.
+   * @param fallback Parameters used for types whose cuboids do not specify any.
+   */
+  [[nodiscard]] std::vector<Species> getSpecies(const Species& fallback) const;
+
+  /**
+   * @brief Returns 2 if all cuboids lie in one xy-plane and do not move out of it, 3 otherwise.
+   */
+  [[nodiscard]] int getDimensions() const { return dimensions; }
+
+  /**
+   * @brief Parses the input file without generating particles.
+   * @return Number of particles \ref readFile "readFile()" would generate.
+   * @throws std::runtime_error if the file cannot be opened or is malformed
+   */
+  [[nodiscard]] std::size_t countParticles();
+
   /**
    * @brief Reads the input file and accordingly populates ParticleContainer with particles forming cuboids.
    *
@@ -51,6 +119,16 @@ public:
    * velocities according to the Maxwell–Boltzmann distribution.
    *
    * @param particles ParticleContainer where particles are inserted.
+   * @throws std::runtime_error if the file cannot be opened or is malformed
    */
   void readFile(ParticleContainer& particles) override;
+
+  /**
+   * @brief Like \ref readFile "readFile()", but takes the particles from the cache if it holds the state generated
+   * from the same file contents, and stores them there otherwise.
+   *
+   * @param particles ParticleContainer where particles are inserted.
+   * @param cache Cache of generated initial states.
+   */
+  void readFile(ParticleContainer& particles, const InitialStateCache& cache);
 };
@@ -0,0 +1,85 @@
+/**
+ * @file InitialStateCache.h
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "ParticleContainer.h"
+
+/**
+ * @class InitialStateCache
+ * @brief Directory of generated initial states, keyed by a hash of the input file and the generator parameters.
+ *
+ * Generating large cuboid lattices with Maxwell-Boltzmann velocities takes seconds to minutes, and benchmark runs
+ * and ensemble members regenerate the same state over and over. The cache stores the generated particles as a flat
+ * binary blob `<directory>/<key>.state` and later runs memory-map it instead of generating them again.
+ *
+ * A blob starts with a \ref Header "Header" followed by one \ref Record "Record" per particle. Blobs whose header
+ * does not match (older format, other key, truncated file) are ignored and overwritten.
+ */
+class InitialStateCache {
+ public:
+  /**
+   * @brief Leading bytes of every blob, "MDSTATE1"
+   */
+  static constexpr std::uint64_t magic = 0x3145544154534d44;
+
+  struct Header {
+    std::uint64_t magic;
+    std::uint64_t key;
+    std::uint64_t count;
+  };
+
+  /**
+   * @brief Particle as stored in a blob, independent of the layout of \ref Particle "Particle"
+   */
+  struct Record {
+    double x[3];
+    double v[3];
+    double m;
+    std::int32_t type;
+    std::int32_t padding;
+  };
+
+ private:
+  std::string directory;
+  bool refresh;
+
+ public:
+  /**
+   * @param directory Directory of the blobs, created when the first one is stored
+   * @param refresh Ignore existing blobs, i.e. always regenerate and overwrite them
+   */
+  explicit InitialStateCache(std::string directory, bool refresh = false);
+
+  /**
+   * @brief 64 bit FNV-1a hash of a byte string, continuing from a previous hash
+   * @param bytes Data to hash
+   * @param hash Result of hashing the preceding data
+   */
+  [[nodiscard]] static std::uint64_t hash(const std::string& bytes, std::uint64_t hash = 0xcbf29ce484222325);
+
+  /**
+   * @brief Path of the blob of a key
+   */
+  [[nodiscard]] std::string path(std::uint64_t key) const;
+
+  /**
+   * @brief Appends the particles of the blob of a key to the container
+   * @return false if there is no valid blob for the key or the cache is refreshed, the container is unchanged then
+   */
+  bool load(std::uint64_t key, ParticleContainer& particles) const;
+
+  /**
+   * @brief Stores the particles as the blob of a key
+   *
+   * The blob is written to a temporary file and renamed, so concurrent simulations never see a partial blob.
+   * Failures are only logged, since the cache is an optimization.
+   * @return Whether the blob was written
+   */
+  bool store(std::uint64_t key, const ParticleContainer& particles) const;
+};
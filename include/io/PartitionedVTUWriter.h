@@ -0,0 +1,86 @@
+/**
+ * @file PartitionedVTUWriter.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @class PartitionedVTUWriter
+ * @brief Writes a snapshot as several .vtu pieces in parallel, combined by a .pvtu master file.
+ *
+ * The particles are split into contiguous storage ranges of nearly equal size, one per piece, and the pieces are
+ * written concurrently by OpenMP threads. ParaView opens the master file `<name>_<iteration>.pvtu` as a single
+ * dataset. The static helpers define the partitioning and the file names, so that processes which each hold a part
+ * of the particles (e.g. MPI ranks) can write their own pieces with \ref writePiece "writePiece()" and let a single
+ * process write the master file with \ref writeMaster "writeMaster()".
+ */
+class PartitionedVTUWriter {
+ private:
+  const int pieces;
+
+ public:
+  /**
+   * @param pieces Number of pieces per snapshot, the number of OpenMP threads if not positive
+   */
+  explicit PartitionedVTUWriter(int pieces = 0);
+
+  /**
+   * @brief Number of pieces per snapshot
+   */
+  [[nodiscard]] int getPieces() const { return pieces; }
+
+  /**
+   * @brief Storage range of one piece when splitting count particles into the given number of pieces
+   * @return Index of the first particle of the piece and the number of particles in it
+   */
+  static std::pair<std::size_t, std::size_t> pieceRange(std::size_t count, int pieces, int piece);
+
+  /**
+   * @brief File name of one piece, without directory
+   */
+  static std::string pieceFilename(const std::string& name, int iteration, int piece);
+
+  /**
+   * @brief Writes one piece of a snapshot
+   * @param particles First particle of the piece
+   * @param count Number of particles in the piece
+   * @param outputDirectory Directory of the snapshot
+   * @param name Name of the snapshot series
+   * @param iteration Current iteration number
+   * @param piece Index of the piece
+   * @return Whether the piece was written
+   */
+  static bool writePiece(const Particle* particles, std::size_t count, const std::string& outputDirectory,
+                         const std::string& name, int iteration, int piece);
+
+  /**
+   * @brief Writes the master file referencing all pieces of a snapshot
+   * @param outputDirectory Directory of the snapshot
+   * @param name Name of the snapshot series
+   * @param iteration Current iteration number
+   * @param pieces Number of pieces
+   * @return Whether the master file was written
+   */
+  static bool writeMaster(const std::string& outputDirectory, const std::string& name, int iteration, int pieces);
+
+  /**
+   * @brief Writes all pieces of a snapshot concurrently and then the master file
+   * @param particles Particles to add to the output
+   * @param name Name of the snapshot series
+   * @param iteration Current iteration number
+   * @param outputDirectory Directory the files are written to
+   */
+  void plotParticles(const ParticleContainer& particles, const std::string& name, int iteration,
+                     const std::string& outputDirectory = "output") const;
+};
+
+}  // namespace outputWriter
@@ -0,0 +1,94 @@
+/**
+ * @file SharedMemoryReader.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+#include "io/SharedMemoryWriter.h"
+
+/**
+ * @class SharedMemoryReader
+ * @brief Attaches to the live stream of a running simulation published by
+ * \ref outputWriter::SharedMemoryWriter "SharedMemoryWriter".
+ *
+ * The segment is mapped read-only, so readers can never disturb the simulation. Frames are read in place: a
+ * \ref FrameView "FrameView" points into the shared memory and is checked with \ref isIntact "isIntact()" after use,
+ * or copied into particles with \ref latestFrame "latestFrame()".
+ */
+class SharedMemoryReader {
+ private:
+  const outputWriter::SharedStreamHeader* header = nullptr;
+  std::size_t mappingBytes = 0;
+  outputWriter::SharedSlotLayout layout{};
+
+ public:
+  /**
+   * @brief A frame in the shared memory, only valid as long as \ref isIntact "isIntact()" returns true
+   */
+  struct FrameView {
+    std::uint64_t frame;
+    std::uint64_t sequence;
+    int iteration;
+    std::size_t count;
+    const double* positions;
+    const float* velocities;
+    const float* forces;
+    const float* masses;
+    const std::int32_t* types;
+  };
+
+  /**
+   * @brief A copied frame
+   */
+  struct Frame {
+    std::uint64_t frame;
+    int iteration;
+    std::vector<Particle> particles;
+  };
+
+  /**
+   * @param name Name of the segment, without the leading slash
+   * @throws std::runtime_error if there is no live stream of that name
+   */
+  explicit SharedMemoryReader(const std::string& name);
+  ~SharedMemoryReader();
+
+  SharedMemoryReader(const SharedMemoryReader&) = delete;
+  SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+  /**
+   * @brief Number of frames published so far
+   */
+  [[nodiscard]] std::uint64_t published() const;
+
+  /**
+   * @brief Whether the simulation has ended
+   */
+  [[nodiscard]] bool finished() const;
+
+  /**
+   * @brief Points to the most recent frame without copying it
+   * @return The frame, or std::nullopt if none is published or it is being overwritten
+   */
+  [[nodiscard]] std::optional<FrameView> latestView() const;
+
+  /**
+   * @brief Whether the frame has not been overwritten since the view was taken, i.e. everything read through it so
+   * far is consistent
+   */
+  [[nodiscard]] bool isIntact(const FrameView& view) const;
+
+  /**
+   * @brief Copies the most recent frame, retrying if it is overwritten while being copied
+   * @return The frame, or std::nullopt if none is published yet
+   */
+  [[nodiscard]] std::optional<Frame> latestFrame() const;
+};
@@ -0,0 +1,148 @@
+/**
+ * @file SharedMemoryWriter.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Identifies live streams, "MDL" followed by the format version
+ */
+inline constexpr std::array<char, 4> sharedStreamMagic = {'M', 'D', 'L', '1'};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory streams need lock-free atomics");
+
+/**
+ * @struct SharedStreamHeader
+ * @brief Start of a live stream segment, followed by the slots of the ring buffer.
+ */
+struct alignas(64) SharedStreamHeader {
+  std::array<char, 4> magic;
+  std::uint32_t slots;
+  /**
+   * @brief Maximum number of particles per frame
+   */
+  std::uint64_t capacity;
+  /**
+   * @brief Size of a slot in bytes
+   */
+  std::uint64_t slotBytes;
+  /**
+   * @brief Number of frames published so far, frame n is stored in slot n % slots
+   */
+  std::atomic<std::uint64_t> published;
+  /**
+   * @brief Set to 1 when the simulation has ended, no further frames follow
+   */
+  std::atomic<std::uint64_t> finished;
+};
+
+/**
+ * @struct SharedSlotHeader
+ * @brief Start of a slot, followed by the particle arrays described by \ref SharedSlotLayout "SharedSlotLayout".
+ */
+struct alignas(64) SharedSlotHeader {
+  /**
+   * @brief Seqlock of the slot: odd while the frame is written, 2 * (frame + 1) once frame has been published
+   */
+  std::atomic<std::uint64_t> sequence;
+  std::int64_t iteration;
+  std::uint64_t count;
+};
+
+/**
+ * @struct SharedSlotLayout
+ * @brief Byte offsets of the particle arrays relative to the start of a slot.
+ *
+ * Positions are Float64 x 3, velocities and forces Float32 x 3, masses Float32 and types Int32, each array having
+ * room for the capacity of the stream.
+ */
+struct SharedSlotLayout {
+  std::size_t positions;
+  std::size_t velocities;
+  std::size_t forces;
+  std::size_t masses;
+  std::size_t types;
+  std::size_t bytes;
+
+  /**
+   * @param capacity Maximum number of particles per frame
+   */
+  static constexpr SharedSlotLayout forCapacity(const std::size_t capacity) {
+    SharedSlotLayout layout{};
+    layout.positions = sizeof(SharedSlotHeader);
+    layout.velocities = layout.positions + 3 * sizeof(double) * capacity;
+    layout.forces = layout.velocities + 3 * sizeof(float) * capacity;
+    layout.masses = layout.forces + 3 * sizeof(float) * capacity;
+    layout.types = layout.masses + sizeof(float) * capacity;
+    // slots start on cache lines, so that the seqlocks of neighbouring slots never share one
+    layout.bytes = (layout.types + sizeof(std::int32_t) * capacity + 63) / 64 * 64;
+    return layout;
+  }
+};
+
+/**
+ * @class SharedMemoryWriter
+ * @brief Publishes snapshots into a POSIX shared memory ring buffer that local processes can read while the
+ * simulation is running.
+ *
+ * The segment /dev/shm/<name> starts with a \ref SharedStreamHeader "SharedStreamHeader", followed by a ring of slots
+ * that frames are written to in turn. Every slot is guarded by a seqlock: the writer makes its sequence odd, writes
+ * the frame and publishes it with an even sequence, a reader copies or uses the data in place and accepts it only if
+ * the sequence was even and unchanged. The writer never waits for readers, a reader that is too slow just misses
+ * frames. See SharedMemoryReader for a reader; other languages can map the segment directly, e.g. with Python's mmap
+ * and numpy, using the layout documented here.
+ */
+class SharedMemoryWriter {
+ private:
+  std::string name;
+  SharedStreamHeader* header = nullptr;
+  std::size_t mappingBytes = 0;
+  SharedSlotLayout layout{};
+  std::uint64_t dropped = 0;
+
+ public:
+  /**
+   * @brief Creates the shared memory segment, replacing a stale one of the same name
+   * @param name Name of the segment, without the leading slash
+   * @param capacity Maximum number of particles per frame, larger frames are dropped
+   * @param slots Number of frames kept in the ring buffer
+   * @throws std::runtime_error if the segment cannot be created
+   */
+  SharedMemoryWriter(std::string name, std::size_t capacity, std::uint32_t slots = 4);
+
+  /**
+   * @brief Marks the stream as finished and removes the segment, attached readers keep their mapping
+   */
+  ~SharedMemoryWriter();
+
+  SharedMemoryWriter(const SharedMemoryWriter&) = delete;
+  SharedMemoryWriter& operator=(const SharedMemoryWriter&) = delete;
+
+  /**
+   * @brief Writes the particles into the next slot of the ring buffer
+   * @param particles Particles to add to the output
+   * @param iteration Current iteration number
+   * @return Whether the frame was published, false if it has more particles than the capacity
+   */
+  bool publish(const ParticleContainer& particles, int iteration);
+
+  [[nodiscard]] const std::string& getName() const { return name; }
+
+  /**
+   * @brief Number of frames dropped because they exceeded the capacity
+   */
+  [[nodiscard]] std::uint64_t getDropped() const { return dropped; }
+};
+
+}  // namespace outputWriter
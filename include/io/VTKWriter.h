@@ -37,9 +37,11 @@ class VTKWriter {
    * @param particles Particles to add to the output
    * @param filename Output filename
    * @param iteration Current iteration number
+   * @param outputDirectory Directory the file is written to
    */
   static void plotParticles(const ParticleContainer& particles,
-                            const std::string& filename, int iteration);
+                            const std::string& filename, int iteration,
+                            const std::string& outputDirectory = "output");
 };
 
 }  // namespace outputWriter
@@ -0,0 +1,101 @@
+/**
+ * @file VTUReader.h
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+
+/**
+ * @class VTUReader
+ * @brief Reads binary .vtu files with raw appended data as written by
+ * \ref outputWriter::VTUWriter::writeAppended "VTUWriter::writeAppended()".
+ *
+ * Only the XML header is parsed on construction. Every array is then read directly at its byte offset, either as a
+ * whole or a single tuple at a time, so a few particles or a single array of a large snapshot can be read without
+ * touching the rest of the file.
+ */
+class VTUReader {
+ public:
+  /**
+   * @brief Location of an array in the file
+   */
+  struct Array {
+    /**
+     * @brief Name of the array, "points" for the positions
+     */
+    std::string name;
+    /**
+     * @brief VTK type name, e.g. Float32 or UInt64
+     */
+    std::string type;
+    std::size_t components;
+    /**
+     * @brief Byte offset of the first value from the start of the file
+     */
+    std::uint64_t offset;
+  };
+
+ private:
+  std::string filename;
+  mutable std::ifstream file;
+  std::size_t points = 0;
+  std::vector<Array> arrays;
+
+  /**
+   * @brief Reads count tuples of an array starting at tuple first, converted to double
+   */
+  void read(const Array& array, std::size_t first, std::size_t count, double* values) const;
+
+ public:
+  /**
+   * @param filename Path of a binary .vtu file
+   * @throws std::runtime_error if the file cannot be opened or does not contain raw appended data
+   */
+  explicit VTUReader(std::string filename);
+
+  /**
+   * @brief Number of particles in the file
+   */
+  [[nodiscard]] std::size_t size() const { return points; }
+
+  /**
+   * @brief All arrays of the file, point data first
+   */
+  [[nodiscard]] const std::vector<Array>& getArrays() const { return arrays; }
+
+  /**
+   * @brief Looks up an array by name
+   * @return The array, or std::nullopt if the file has no array of that name
+   */
+  [[nodiscard]] std::optional<Array> find(const std::string& name) const;
+
+  /**
+   * @brief Reads all values of an array, converted to double
+   * @throws std::runtime_error if the file has no such array or is truncated
+   */
+  [[nodiscard]] std::vector<double> readArray(const std::string& name) const;
+
+  /**
+   * @brief Reads the values of a single particle from an array with up to 3 components
+   * @param array Array as returned by \ref find "find()"
+   * @param index Storage index of the particle in the file
+   * @throws std::runtime_error if the file is truncated
+   */
+  [[nodiscard]] std::array<double, 3> readTuple(const Array& array, std::size_t index) const;
+
+  /**
+   * @brief Reads all particles with their position, velocity, force, mass, type and, if stored, id
+   * @throws std::runtime_error if the file lacks one of the arrays or is truncated
+   */
+  [[nodiscard]] std::vector<Particle> readParticles() const;
+};
@@ -0,0 +1,77 @@
+/**
+ * @file VTUWriter.h
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+#include "ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @class VTUWriter
+ * @brief Writes particles as VTK XML unstructured grid (.vtu) without depending on the VTK library.
+ *
+ * The files contain the same point data as the ones of \ref VTKWriter "VTKWriter" (mass, velocity, force and type)
+ * and can be opened in ParaView, plus the particle ids, so that particles can be followed across snapshots even after
+ * others have been removed, see \ref VTUReader "VTUReader". Several files can be combined into one dataset with a
+ * .pvtu master file.
+ *
+ * The binary files store every array as one raw block in the appended data section. The particle data is gathered
+ * into one contiguous buffer per array and the whole file is handed to the kernel by a single writev(2) call, so
+ * writing a snapshot costs little more than copying the particle data once.
+ */
+class VTUWriter {
+ public:
+  /**
+   * @brief Writes the particles as binary .vtu file named <filename>_<iteration>.vtu
+   * @param particles Particles to add to the output
+   * @param filename Output filename
+   * @param iteration Current iteration number
+   * @param outputDirectory Directory the file is written to, created if necessary
+   */
+  static void plotParticles(const ParticleContainer& particles, const std::string& filename, int iteration,
+                            const std::string& outputDirectory = "output");
+
+  /**
+   * @brief Writes a contiguous range of particles as .vtu file with raw binary appended data
+   * @param particles First particle of the range
+   * @param count Number of particles in the range
+   * @param filename Path of the output file
+   * @return Whether the file was written
+   */
+  static bool writeAppended(const Particle* particles, std::size_t count, const std::string& filename);
+
+  /**
+   * @brief Writes the particles as human readable ASCII .vtu file
+   * @param particles Particles to add to the output
+   * @param filename Path of the output file
+   * @return Whether the file was written
+   */
+  static bool writeAscii(const std::vector<Particle>& particles, const std::string& filename);
+
+  /**
+   * @brief Writes a contiguous range of particles as human readable ASCII .vtu file
+   * @param particles First particle of the range
+   * @param count Number of particles in the range
+   * @param filename Path of the output file
+   * @return Whether the file was written
+   */
+  static bool writeAscii(const Particle* particles, std::size_t count, const std::string& filename);
+
+  /**
+   * @brief Writes a .pvtu master file which ParaView opens as a single dataset made of the given pieces
+   * @param filename Path of the master file
+   * @param pieceSources Paths of the .vtu pieces, relative to the directory of the master file
+   * @return Whether the file was written
+   */
+  static bool writeMaster(const std::string& filename, const std::vector<std::string>& pieceSources);
+};
+
+}  // namespace outputWriter
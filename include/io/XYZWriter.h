@@ -7,31 +7,66 @@
 
 #pragma once
 
+#include <cstddef>
 #include <fstream>
-#include <vector>
+#include <string>
 
 #include "Particle.h"
+#include "ParticleContainer.h"
 
 namespace outputWriter {
 
 /**
- * @brief A singleton class that can be used to describe the state of the simulation in a given moment.
+ * @brief Writes the positions of the particles in the XYZ format, see http://openbabel.org/wiki/XYZ_(format).
  *
+ * A frame is formatted with std::to_chars into one buffer, which is handed to the file in a single write. Numbers use
+ * the shortest representation that reads back to the same double. Frames are either written to one file per iteration
+ * with \ref plotParticles "plotParticles()", or appended to a single trajectory file by an XYZWriter instance, which
+ * most viewers play back as an animation.
  */
 class XYZWriter final {
+ private:
+  std::ofstream file;
+
+  /**
+   * @brief Formatted frame, reused so that its memory is only allocated once
+   */
+  std::string buffer;
+
  public:
-  XYZWriter();
+  /**
+   * @brief Opens a trajectory file that frames are appended to
+   * @param filename Path of the trajectory file, its directory is created if necessary
+   * @param append Whether frames already in the file are kept, otherwise it is truncated
+   */
+  explicit XYZWriter(const std::string& filename, bool append = false);
 
-  virtual ~XYZWriter();
   /**
-   * @brief creates a file, which describes the state of all particles in the system,
-   * for a particular iteration.
-   * @param particles A vector holding all particles in the system.
+   * @brief Appends the particles as a frame to the trajectory file
+   * @param particles Particles to add to the output
+   * @param iteration Iteration of the frame, written to its comment line
+   * @return Whether the frame was written
+   */
+  bool appendFrame(const ParticleContainer& particles, int iteration);
+
+  /**
+   * @brief Creates a file, which describes the state of all particles in the system, for a particular iteration.
+   * @param particles Particles to add to the output
    * @param filename A reference to the string that represents the name of the file being generated.
    * @param iteration Integer number representing the number of the iteration being plotted.
+   * @param outputDirectory Directory the file is written to.
+   */
+  static void plotParticles(const ParticleContainer& particles, const std::string& filename, int iteration,
+                            const std::string& outputDirectory = "output");
+
+  /**
+   * @brief Appends a frame of the given particles in the XYZ format to a buffer
+   * @param particles First particle of the frame
+   * @param count Number of particles in the frame
+   * @param iteration Iteration of the frame, written to its comment line
+   * @param buffer Buffer the frame is appended to
    */
-  static void plotParticles(const std::vector<Particle>& particles,
-                            const std::string& filename, int iteration);
+  static void formatFrame(const Particle* particles, std::size_t count, int iteration, std::string& buffer);
 };
 
 }  // namespace outputWriter
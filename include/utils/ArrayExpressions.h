@@ -0,0 +1,209 @@
+/**
+ * @file ArrayExpressions.h
+ *
+ * Expression templates for arithmetic on fixed-size std::array vectors.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+/**
+ * The operators of \ref ArrayUtils.h return a new container for every sub-expression, so x + dt * v + c * F creates
+ * four temporaries and runs four loops. The expressions in this file instead only record the operation. Evaluating
+ * the whole expression with \ref eval "eval()", \ref assign "assign()" or \ref addTo "addTo()" runs a single loop over
+ * the N components, which the compiler unrolls into the same code as a hand-written loop.
+ *
+ * Expressions start from a \ref view "view()" to a std::array and must be evaluated within the same statement, since
+ * they hold references to their operands:
+ * @code
+ * ArrayUtils::assign(x, ArrayUtils::view(x) + dt * ArrayUtils::view(v) + (0.5 * dt * dt / m) * ArrayUtils::view(f));
+ * @endcode
+ */
+namespace ArrayUtils {
+
+/**
+ * Base of all expressions, E being the expression itself.
+ * @tparam E Type of the derived expression.
+ */
+template <class E>
+struct Expression {
+  constexpr const E& derived() const { return static_cast<const E&>(*this); }
+};
+
+/**
+ * Leaf expression referring to the components of a std::array.
+ * @tparam T Component type.
+ * @tparam N Number of components.
+ */
+template <class T, std::size_t N>
+class ArrayView : public Expression<ArrayView<T, N>> {
+ private:
+  const std::array<T, N>& data;
+
+ public:
+  using value_type = T;
+  static constexpr std::size_t size = N;
+
+  constexpr explicit ArrayView(const std::array<T, N>& data) : data(data) {}
+  constexpr T operator[](const std::size_t i) const { return data[i]; }
+};
+
+/**
+ * Element wise binary operation of two expressions of the same size.
+ * @tparam L Left operand.
+ * @tparam R Right operand.
+ * @tparam Op Binary function object.
+ */
+template <class L, class R, class Op>
+class BinaryExpression : public Expression<BinaryExpression<L, R, Op>> {
+ private:
+  // operands are stored by value, leaves and inner nodes only hold references and scalars
+  const L lhs;
+  const R rhs;
+
+ public:
+  static_assert(L::size == R::size, "Operands of an expression must have the same number of components");
+  using value_type = decltype(Op{}(typename L::value_type{}, typename R::value_type{}));
+  static constexpr std::size_t size = L::size;
+
+  constexpr BinaryExpression(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+  constexpr value_type operator[](const std::size_t i) const { return Op{}(lhs[i], rhs[i]); }
+};
+
+/**
+ * Expression scaled by a scalar.
+ * @tparam E Scaled expression.
+ */
+template <class E>
+class ScaledExpression : public Expression<ScaledExpression<E>> {
+ private:
+  const typename E::value_type scalar;
+  const E expression;
+
+ public:
+  using value_type = typename E::value_type;
+  static constexpr std::size_t size = E::size;
+
+  constexpr ScaledExpression(const value_type scalar, const E& expression) : scalar(scalar), expression(expression) {}
+  constexpr value_type operator[](const std::size_t i) const { return scalar * expression[i]; }
+};
+
+/**
+ * Starts an expression from a std::array, without copying it.
+ */
+template <class T, std::size_t N>
+constexpr ArrayView<T, N> view(const std::array<T, N>& array) {
+  return ArrayView<T, N>(array);
+}
+
+/**
+ * Element wise addition of two expressions.
+ */
+template <class L, class R>
+constexpr BinaryExpression<L, R, std::plus<>> operator+(const Expression<L>& lhs, const Expression<R>& rhs) {
+  return {lhs.derived(), rhs.derived()};
+}
+
+/**
+ * Element wise subtraction of two expressions.
+ */
+template <class L, class R>
+constexpr BinaryExpression<L, R, std::minus<>> operator-(const Expression<L>& lhs, const Expression<R>& rhs) {
+  return {lhs.derived(), rhs.derived()};
+}
+
+/**
+ * Element wise multiplication of two expressions.
+ */
+template <class L, class R>
+constexpr BinaryExpression<L, R, std::multiplies<>> operator*(const Expression<L>& lhs, const Expression<R>& rhs) {
+  return {lhs.derived(), rhs.derived()};
+}
+
+/**
+ * Scaling of an expression.
+ */
+template <class E>
+constexpr ScaledExpression<E> operator*(const typename E::value_type scalar, const Expression<E>& expression) {
+  return {scalar, expression.derived()};
+}
+
+/**
+ * Scaling of an expression.
+ */
+template <class E>
+constexpr ScaledExpression<E> operator*(const Expression<E>& expression, const typename E::value_type scalar) {
+  return {scalar, expression.derived()};
+}
+
+/**
+ * Negation of an expression.
+ */
+template <class E>
+constexpr ScaledExpression<E> operator-(const Expression<E>& expression) {
+  return {typename E::value_type{-1}, expression.derived()};
+}
+
+/**
+ * Evaluates an expression into a new std::array in a single loop.
+ */
+template <class E>
+constexpr std::array<typename E::value_type, E::size> eval(const Expression<E>& expression) {
+  std::array<typename E::value_type, E::size> result{};
+  for (std::size_t i = 0; i < E::size; i++) {
+    result[i] = expression.derived()[i];
+  }
+  return result;
+}
+
+/**
+ * Evaluates an expression into an existing std::array in a single loop.
+ *
+ * The target may appear in the expression, since component i of the result only depends on component i of the
+ * operands.
+ */
+template <class T, std::size_t N, class E>
+constexpr void assign(std::array<T, N>& target, const Expression<E>& expression) {
+  static_assert(E::size == N, "Expression and target must have the same number of components");
+  for (std::size_t i = 0; i < N; i++) {
+    target[i] = expression.derived()[i];
+  }
+}
+
+/**
+ * Adds an expression to an existing std::array in a single loop.
+ */
+template <class T, std::size_t N, class E>
+constexpr void addTo(std::array<T, N>& target, const Expression<E>& expression) {
+  static_assert(E::size == N, "Expression and target must have the same number of components");
+  for (std::size_t i = 0; i < N; i++) {
+    target[i] += expression.derived()[i];
+  }
+}
+
+/**
+ * Dot product of two expressions.
+ */
+template <class L, class R>
+constexpr auto dot(const Expression<L>& lhs, const Expression<R>& rhs) {
+  static_assert(L::size == R::size, "Operands of an expression must have the same number of components");
+  typename L::value_type sum{};
+  for (std::size_t i = 0; i < L::size; i++) {
+    sum += lhs.derived()[i] * rhs.derived()[i];
+  }
+  return sum;
+}
+
+/**
+ * Euclidean norm of an expression.
+ */
+template <class E>
+auto norm(const Expression<E>& expression) {
+  return std::sqrt(dot(expression, expression));
+}
+
+}  // namespace ArrayUtils
@@ -0,0 +1,78 @@
+/**
+ * @file Compression.h
+ *
+ * Integer and entropy coding used by the compressed snapshot output.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Maps signed to unsigned integers so that values of small magnitude get small codes (0, -1, 1, -2, ...)
+ */
+inline std::uint64_t zigzagEncode(const std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Inverse of \ref zigzagEncode "zigzagEncode()"
+ */
+inline std::int64_t zigzagDecode(const std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * @brief Appends an unsigned integer as LEB128 varint, 7 bits per byte
+ */
+inline void appendVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * @brief Reads a LEB128 varint and advances the position past it
+ * @throws std::runtime_error if the data ends inside the varint
+ */
+inline std::uint64_t readVarint(const std::vector<std::uint8_t>& in, std::size_t& position) {
+  std::uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (position >= in.size()) {
+      throw std::runtime_error("Unexpected end of data in varint");
+    }
+    const std::uint8_t byte = in[position++];
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Varint longer than 64 bits");
+}
+
+/**
+ * @brief Compresses bytes with a canonical Huffman code built for exactly this data.
+ *
+ * The result starts with the code lengths of all 256 byte values (4 bits each, at most 15 bits per code), followed
+ * by the codes of all bytes, most significant bit first.
+ * @param data Bytes to compress
+ * @return Compressed bytes, decoded by \ref huffmanDecode "huffmanDecode()" given the size of data
+ */
+std::vector<std::uint8_t> huffmanEncode(const std::vector<std::uint8_t>& data);
+
+/**
+ * @brief Decompresses the output of \ref huffmanEncode "huffmanEncode()".
+ * @param encoded Compressed bytes
+ * @param size Number of bytes to decode
+ * @throws std::runtime_error if the data is corrupt
+ */
+std::vector<std::uint8_t> huffmanDecode(const std::vector<std::uint8_t>& encoded, std::size_t size);
+
+}  // namespace utils
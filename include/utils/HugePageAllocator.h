@@ -0,0 +1,112 @@
+/**
+ * @file HugePageAllocator.h
+ *
+ * Allocator for large particle buffers, backed by transparent huge pages where available.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace utils {
+
+/**
+ * @class HugePageAllocator
+ * @brief Standard-conforming allocator returning cache-line aligned storage.
+ *
+ * Small requests are served by aligned operator new. Requests of at least one huge page (2 MiB) are mapped
+ * anonymously, aligned to a 2 MiB boundary and marked with madvise(MADV_HUGEPAGE), so that the kernel can back
+ * them with transparent huge pages and the particle arrays of large runs cause far fewer TLB misses.
+ *
+ * @tparam T Value type.
+ * @tparam Alignment Minimum alignment of returned storage in bytes (64 = one cache line / AVX-512 register).
+ */
+template <typename T, std::size_t Alignment = 64>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  /**
+   * @brief Size of a (transparent) huge page on x86-64 and aarch64 with 4K base pages.
+   */
+  static constexpr std::size_t hugePageSize = std::size_t{2} * 1024 * 1024;
+
+  template <typename U>
+  struct rebind {
+    using other = HugePageAllocator<U, Alignment>;
+  };
+
+  HugePageAllocator() noexcept = default;
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U, Alignment>& /*other*/) noexcept {}
+
+  /**
+   * @brief Allocates uninitialized storage for n objects of type T.
+   * @param n Number of objects.
+   * @return Pointer to storage aligned to at least Alignment bytes.
+   * @throws std::bad_alloc if the memory could not be obtained.
+   */
+  [[nodiscard]] T* allocate(std::size_t n) {
+    const std::size_t bytes = n * sizeof(T);
+    if (bytes < hugePageSize) {
+      return static_cast<T*>(::operator new(bytes, std::align_val_t{Alignment}));
+    }
+
+    // over-map by one huge page so that the returned region can start on a 2 MiB boundary
+    const std::size_t length = roundUp(bytes);
+    const std::size_t mapped = length + hugePageSize;
+    void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    const auto rawAddr = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t alignedAddr = (rawAddr + hugePageSize - 1) & ~(hugePageSize - 1);
+    // release the unaligned head and the unused tail of the mapping
+    if (const std::size_t head = alignedAddr - rawAddr; head > 0) {
+      munmap(raw, head);
+    }
+    if (const std::size_t tail = mapped - (alignedAddr - rawAddr) - length; tail > 0) {
+      munmap(reinterpret_cast<void*>(alignedAddr + length), tail);
+    }
+    void* aligned = reinterpret_cast<void*>(alignedAddr);
+#ifdef MADV_HUGEPAGE
+    // only a hint, failure (e.g. THP disabled) leaves us with regular pages
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return static_cast<T*>(aligned);
+  }
+
+  /**
+   * @brief Releases storage obtained from \ref allocate "allocate()".
+   * @param p Pointer returned by allocate.
+   * @param n Number of objects passed to allocate.
+   */
+  void deallocate(T* p, std::size_t n) noexcept {
+    const std::size_t bytes = n * sizeof(T);
+    if (bytes < hugePageSize) {
+      ::operator delete(p, std::align_val_t{Alignment});
+    } else {
+      munmap(p, roundUp(bytes));
+    }
+  }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U, Alignment>& /*other*/) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const HugePageAllocator<U, Alignment>& /*other*/) const noexcept {
+    return false;
+  }
+
+ private:
+  static constexpr std::size_t roundUp(std::size_t bytes) {
+    return (bytes + hugePageSize - 1) & ~(hugePageSize - 1);
+  }
+};
+
+}  // namespace utils
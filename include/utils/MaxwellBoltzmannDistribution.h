@@ -15,14 +15,11 @@
  *
  * @param averageVelocity The average velocity of the brownian motion for the system.
  * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
+ * @param randomEngine Random engine drawing the velocity components, owned by the caller.
  * @return Array containing the generated velocity vector.
  */
 std::array<double, 3> maxwellBoltzmannDistributedVelocity(
-    double averageVelocity, size_t dimensions) {
-  // we use a constant seed for repeatability.
-  // random engine needs static lifetime otherwise it would be recreated for every call.
-  static std::default_random_engine randomEngine(42);
-
+    double averageVelocity, size_t dimensions, std::default_random_engine &randomEngine) {
   // when adding independent normally distributed values to all velocity components
   // the velocity change is maxwell boltzmann distributed
   std::normal_distribution<double> normalDistribution{0, 1};
@@ -32,3 +29,18 @@ std::array<double, 3> maxwellBoltzmannDistributedVelocity(
   }
   return randomVelocity;
 }
+
+/**
+ * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
+ *
+ * @param averageVelocity The average velocity of the brownian motion for the system.
+ * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
+ * @return Array containing the generated velocity vector.
+ */
+std::array<double, 3> maxwellBoltzmannDistributedVelocity(
+    double averageVelocity, size_t dimensions) {
+  // we use a constant seed for repeatability.
+  // random engine needs static lifetime otherwise it would be recreated for every call.
+  static std::default_random_engine randomEngine(42);
+  return maxwellBoltzmannDistributedVelocity(averageVelocity, dimensions, randomEngine);
+}
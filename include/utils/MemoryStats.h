@@ -0,0 +1,60 @@
+/**
+ * @file MemoryStats.h
+ *
+ * Page fault and TLB statistics reported in benchmark mode.
+ */
+
+#pragma once
+
+namespace utils {
+
+/**
+ * @struct MemoryStats
+ * @brief Memory subsystem counters accumulated over a measured interval.
+ *
+ * Counters which are not available on the current system (e.g. hardware counters inside a container without
+ * perf_event access) are set to -1. Inside a parallel region, e.g. for the members of an ensemble that run one per
+ * thread, the page faults are those of the calling thread, otherwise those of the whole process.
+ */
+struct MemoryStats {
+  /** @brief Page faults served without I/O */
+  long minorPageFaults = -1;
+  /** @brief Page faults that required I/O */
+  long majorPageFaults = -1;
+  /** @brief Data TLB load misses (hardware counter) */
+  long long dtlbLoadMisses = -1;
+  /** @brief Anonymous memory currently backed by transparent huge pages in kB */
+  long anonHugePagesKB = -1;
+};
+
+/**
+ * @class MemoryStatsRecorder
+ * @brief Measures \ref MemoryStats "MemoryStats" between a call to start() and stop().
+ */
+class MemoryStatsRecorder {
+ private:
+  /** @brief File descriptor of the dTLB perf event, -1 if unavailable */
+  int dtlbFd = -1;
+  long startMinorFaults = 0;
+  long startMajorFaults = 0;
+
+ public:
+  MemoryStatsRecorder() = default;
+  ~MemoryStatsRecorder();
+
+  MemoryStatsRecorder(const MemoryStatsRecorder&) = delete;
+  MemoryStatsRecorder& operator=(const MemoryStatsRecorder&) = delete;
+
+  /**
+   * @brief Begins a measurement interval.
+   */
+  void start();
+
+  /**
+   * @brief Ends the measurement interval.
+   * @return Counters accumulated since the last call to start().
+   */
+  MemoryStats stop();
+};
+
+}  // namespace utils
@@ -0,0 +1,136 @@
+/**
+ * @file Trace.h
+ *
+ * Timeline of the simulation phases per thread, written in the Chrome Trace Event format.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace utils::trace {
+
+/**
+ * @struct Event
+ * @brief A phase executed by one thread, written as complete event ("ph": "X").
+ */
+struct Event {
+  /** @brief Name of the phase, must be a string literal */
+  const char* name;
+  /** @brief Begin in nanoseconds since the first timestamp of the process */
+  std::int64_t begin;
+  /** @brief End in nanoseconds since the first timestamp of the process */
+  std::int64_t end;
+};
+
+/**
+ * @class ThreadBuffer
+ * @brief Ring buffer of the events of one thread.
+ *
+ * Only the owning thread records, so recording needs neither locks nor atomic read-modify-write operations. Once the
+ * buffer is full the oldest events are overwritten, which keeps the memory bounded for long runs.
+ */
+class ThreadBuffer {
+ public:
+  static constexpr std::size_t capacity = 1 << 16;
+
+  /**
+   * @param id Thread id in the trace
+   * @param name Thread name in the trace
+   */
+  ThreadBuffer(int id, std::string name);
+
+  /**
+   * @brief Appends an event, only to be called by the owning thread
+   */
+  void record(const Event& event) noexcept {
+    const std::uint64_t n = recorded.load(std::memory_order_relaxed);
+    events[n % capacity] = event;
+    recorded.store(n + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Events still in the buffer, oldest first
+   */
+  [[nodiscard]] std::vector<Event> snapshot() const;
+
+  /**
+   * @brief Number of events overwritten because the buffer was full
+   */
+  [[nodiscard]] std::uint64_t dropped() const;
+
+  [[nodiscard]] int getId() const { return id; }
+  [[nodiscard]] const std::string& getName() const { return name; }
+
+ private:
+  const int id;
+  const std::string name;
+  std::array<Event, capacity> events{};
+  std::atomic<std::uint64_t> recorded{0};
+};
+
+/**
+ * @brief Nanoseconds since the first call, from a monotonic clock
+ */
+std::int64_t now() noexcept;
+
+/**
+ * @brief Buffer of the calling thread, registered on first use
+ *
+ * The trace id of a thread is its OpenMP thread number, the main thread is OpenMP thread 0 even outside of parallel
+ * regions. Threads not started by OpenMP get ids from 1000 on.
+ *
+ * With ENABLE_TRACING the first registration also schedules writing the trace at exit, to the file named by the
+ * environment variable MOLSIM_TRACE or molsim_trace.json.
+ */
+ThreadBuffer& threadBuffer();
+
+/**
+ * @brief Drops the buffers of all threads, threads register a new buffer on their next event
+ *
+ * Meant for tests, must not run concurrently with recording threads.
+ */
+void reset();
+
+/**
+ * @brief Writes the events of all threads as Chrome Trace Event JSON, viewable in Perfetto or chrome://tracing
+ *
+ * Must not run concurrently with recording threads.
+ */
+void writeChromeTrace(std::ostream& out);
+
+/**
+ * @class Scope
+ * @brief Records an event from construction to destruction.
+ */
+class Scope {
+ private:
+  const char* const name;
+  const std::int64_t begin;
+
+ public:
+  explicit Scope(const char* name) : name(name), begin(now()) {}
+  ~Scope() { threadBuffer().record({name, begin, now()}); }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+};
+
+}  // namespace utils::trace
+
+#define MOLSIM_TRACE_CONCAT_IMPL(a, b) a##b
+#define MOLSIM_TRACE_CONCAT(a, b) MOLSIM_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_TRACING
+/**
+ * @brief Records the enclosing scope as phase with the given string literal as name
+ */
+#define TRACE_SCOPE(name) const utils::trace::Scope MOLSIM_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif  // ENABLE_TRACING
@@ -0,0 +1,83 @@
+/**
+ * @file WorkStealingScheduler.h
+ *
+ * Dynamic load balancing of independent tasks over the OpenMP threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @struct ThreadLoad
+ * @brief Time a thread spent working and waiting in parallel loops, accumulated over several calls.
+ */
+struct ThreadLoad {
+  /** @brief Seconds spent executing tasks */
+  double busySeconds = 0;
+  /** @brief Seconds spent looking for work or waiting for the other threads to finish */
+  double idleSeconds = 0;
+  /** @brief Number of executed tasks */
+  std::size_t tasks = 0;
+  /** @brief Number of tasks taken over from other threads */
+  std::size_t stolenTasks = 0;
+};
+
+/**
+ * @class WorkStealingScheduler
+ * @brief Executes a fixed set of tasks on the OpenMP threads, balancing uneven task costs by work stealing.
+ *
+ * The tasks are split into one contiguous range per thread up front. Each thread takes tasks from the front of its
+ * own range; a thread that runs out of work steals the back half of the range of another thread. A range is packed
+ * into a single atomic word, so taking and stealing tasks are each one compare-and-swap and never block.
+ */
+class WorkStealingScheduler {
+ private:
+  /**
+   * @brief Unclaimed tasks [begin, end) of one thread as begin << 32 | end, on its own cache line
+   */
+  struct alignas(64) TaskRange {
+    std::atomic<std::uint64_t> range{0};
+  };
+
+  int threads;
+  std::unique_ptr<TaskRange[]> ranges;
+
+  /**
+   * @brief Claims the first task of the thread's own range
+   * @return Whether a task was claimed
+   */
+  bool pop(int thread, std::size_t& task);
+
+  /**
+   * @brief Moves the back half of the range of another thread into the (empty) range of the given thread
+   * @return Number of stolen tasks, 0 if all other ranges are empty
+   */
+  std::size_t steal(int thread);
+
+ public:
+  /**
+   * @param threads Number of threads, the OpenMP default if not positive
+   */
+  explicit WorkStealingScheduler(int threads = 0);
+
+  /**
+   * @brief Calls task(index, thread) once for every index in [0, tasks), in parallel
+   * @param tasks Number of tasks, at most 2^32 - 1
+   * @param task Work of one task; thread is the number of the executing thread in [0, getThreads())
+   * @param loads If not nullptr, the busy and idle time of every thread is added to it
+   */
+  void run(std::size_t tasks, const std::function<void(std::size_t, int)>& task,
+           std::vector<ThreadLoad>* loads = nullptr);
+
+  [[nodiscard]] int getThreads() const { return threads; }
+};
+
+}  // namespace utils
@@ -0,0 +1,71 @@
+#include "AutoTunedForce.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+double AutoTunedForce::steadySeconds() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AutoTunedForce::AutoTunedForce(ParticleContainer& particles, std::vector<Candidate> candidates,
+                               const std::size_t retuneInterval, const std::size_t trialSteps,
+                               std::function<double()> clock)
+    : ForceCalc(particles),
+      candidates(std::move(candidates)),
+      retuneInterval(retuneInterval),
+      trialSteps(trialSteps),
+      clock(std::move(clock)) {
+  if (this->candidates.empty() or trialSteps == 0 or trialSteps * this->candidates.size() > retuneInterval) {
+    throw std::invalid_argument("Autotuning requires candidates and trials that fit into the retune interval");
+  }
+}
+
+void AutoTunedForce::calculateF() {
+  step([](ForceCalc& force) { force.calculateF(); });
+}
+
+void AutoTunedForce::calculateF(ForceObservables& observables) {
+  step([&observables](ForceCalc& force) { force.calculateF(observables); });
+}
+
+void AutoTunedForce::setDimensions(const int newDimensions) {
+  ForceCalc::setDimensions(newDimensions);
+  for (auto& candidate : candidates) {
+    candidate.force->setDimensions(newDimensions);
+  }
+}
+
+void AutoTunedForce::step(const std::function<void(ForceCalc&)>& calculate) {
+  const std::size_t phase = calls++ % retuneInterval;
+  const std::size_t trialCalls = trialSteps * candidates.size();
+  if (phase >= trialCalls) {
+    calculate(*candidates[selected].force);
+    return;
+  }
+
+  if (phase == 0) {
+    trialTimes.assign(candidates.size(), std::numeric_limits<double>::infinity());
+  }
+  const std::size_t candidate = phase / trialSteps;
+  const double start = clock();
+  calculate(*candidates[candidate].force);
+  trialTimes[candidate] = std::min(trialTimes[candidate], clock() - start);
+
+  if (phase + 1 == trialCalls) {
+    const std::size_t fastest = std::min_element(trialTimes.begin(), trialTimes.end()) - trialTimes.begin();
+    for (std::size_t c = 0; c < candidates.size(); c++) {
+      SPDLOG_DEBUG("Autotuning: {} takes {:.3f} ms per step", candidates[c].name, 1e3 * trialTimes[c]);
+    }
+    // candidates within the measurement noise of the selected one do not replace it
+    if (calls == trialCalls or trialTimes[fastest] < (1.0 - switchMargin) * trialTimes[selected]) {
+      selected = fastest;
+      SPDLOG_INFO("Autotuning after {} steps: using {} ({:.3f} ms per step), pass {} to pin this choice", calls,
+                  candidates[selected].name, 1e3 * trialTimes[selected], candidates[selected].name);
+    }
+  }
+}
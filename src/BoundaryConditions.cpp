@@ -0,0 +1,188 @@
+#include "BoundaryConditions.h"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+BoundaryConfig BoundaryConfig::parse(const std::string& faces, const std::string& domain) {
+  BoundaryConfig config{};
+  if (faces.size() != config.faces.size()) {
+    throw std::invalid_argument("Expected 6 boundary types, got \"" + faces + "\"");
+  }
+  for (std::size_t i = 0; i < faces.size(); i++) {
+    switch (faces[i]) {
+      case 'o':
+        config.faces[i] = BoundaryType::OUTFLOW;
+        break;
+      case 'r':
+        config.faces[i] = BoundaryType::REFLECTING;
+        break;
+      case 'p':
+        config.faces[i] = BoundaryType::PERIODIC;
+        break;
+      default:
+        throw std::invalid_argument(std::string("Invalid boundary type '") + faces[i] + "', use o, r or p");
+    }
+  }
+
+  std::istringstream stream(domain);
+  std::string value;
+  std::array<double, 6> corners{};
+  std::size_t count = 0;
+  while (std::getline(stream, value, ',')) {
+    if (count == corners.size()) {
+      throw std::invalid_argument("Too many values in domain \"" + domain + "\"");
+    }
+    corners[count++] = std::stod(value);
+  }
+  if (count != corners.size()) {
+    throw std::invalid_argument("Expected 6 comma separated values in domain \"" + domain + "\"");
+  }
+  config.lowerCorner = {corners[0], corners[1], corners[2]};
+  config.upperCorner = {corners[3], corners[4], corners[5]};
+  return config;
+}
+
+BoundaryConditions::BoundaryConditions(const BoundaryConfig& config, const double epsilon, const double sigma,
+                                       const double cutoffRadius)
+    : config(config),
+      epsilon(epsilon),
+      sigma(sigma),
+      cutoffRadius(cutoffRadius),
+      domainSize{},
+      reflectDistance(std::pow(2.0, 1.0 / 6.0) * sigma / 2.0) {
+  for (std::size_t d = 0; d < 3; d++) {
+    domainSize[d] = config.upperCorner[d] - config.lowerCorner[d];
+    if (domainSize[d] <= 0) {
+      throw std::invalid_argument("Domain must have a positive extent in every dimension");
+    }
+    if ((lower(d) == BoundaryType::PERIODIC) != (upper(d) == BoundaryType::PERIODIC)) {
+      throw std::invalid_argument("Periodic boundaries must be set on both opposite faces");
+    }
+    if (lower(d) == BoundaryType::PERIODIC and 2 * cutoffRadius > domainSize[d]) {
+      throw std::invalid_argument("Periodic boundaries require a domain of at least twice the cutoff radius");
+    }
+  }
+}
+
+double BoundaryConditions::wallForce(const double wallDistance) const {
+  const double r = 2.0 * wallDistance;
+  const double sigma_r2 = (sigma * sigma) / (r * r);
+  const double sigma_r6 = sigma_r2 * sigma_r2 * sigma_r2;
+  return 24.0 * epsilon / r * sigma_r6 * (2.0 * sigma_r6 - 1.0);
+}
+
+void BoundaryConditions::applyAfterPositionUpdate(ParticleContainer& particles) {
+  const auto& lo = config.lowerCorner;
+  const auto& up = config.upperCorner;
+
+  nearReflectingFace.clear();
+  std::vector<Particle> halo;
+
+  std::size_t i = 0;
+  while (i < particles.size()) {
+    auto& p = particles[i];
+    auto x = p.getX();
+    auto v = p.getV();
+
+    // handle particles that crossed a face during the last position update
+    bool outflow = false;
+    for (std::size_t d = 0; d < 3; d++) {
+      BoundaryType crossed;
+      if (x[d] < lo[d]) {
+        crossed = lower(d);
+      } else if (x[d] >= up[d]) {
+        crossed = upper(d);
+      } else {
+        continue;
+      }
+      switch (crossed) {
+        case BoundaryType::OUTFLOW:
+          outflow = true;
+          break;
+        case BoundaryType::PERIODIC:
+          x[d] += x[d] < lo[d] ? domainSize[d] : -domainSize[d];
+          break;
+        case BoundaryType::REFLECTING:
+          x[d] = x[d] < lo[d] ? 2 * lo[d] - x[d] : 2 * up[d] - x[d];
+          v[d] = -v[d];
+          break;
+      }
+    }
+    if (outflow) {
+      // the last particle is moved into slot i, which is therefore visited again
+      particles.removeParticle(i);
+      continue;
+    }
+    p.setX(x);
+    p.setV(v);
+
+    // record the particles that interact with a face
+    std::array<double, 3> haloShift{};
+    bool nearReflecting = false;
+    for (std::size_t d = 0; d < 3; d++) {
+      const double distLower = x[d] - lo[d];
+      const double distUpper = up[d] - x[d];
+      if (lower(d) == BoundaryType::PERIODIC) {
+        if (distLower < cutoffRadius) {
+          haloShift[d] = domainSize[d];
+        } else if (distUpper < cutoffRadius) {
+          haloShift[d] = -domainSize[d];
+        }
+      }
+      nearReflecting |= (lower(d) == BoundaryType::REFLECTING and distLower < reflectDistance) or
+                        (upper(d) == BoundaryType::REFLECTING and distUpper < reflectDistance);
+    }
+    if (nearReflecting) {
+      nearReflectingFace.push_back(i);
+    }
+    // every non-empty combination of shifted dimensions yields one halo copy (faces, edges and corners)
+    for (unsigned mask = 1; mask < 8; mask++) {
+      auto haloX = x;
+      bool valid = true;
+      for (std::size_t d = 0; d < 3 and valid; d++) {
+        if (mask & (1u << d)) {
+          valid = haloShift[d] != 0;
+          haloX[d] += haloShift[d];
+        }
+      }
+      if (valid) {
+        Particle copy = p;
+        copy.setX(haloX);
+        halo.push_back(copy);
+      }
+    }
+    i++;
+  }
+
+  firstHalo = particles.size();
+  particles.addHalos(halo);
+  SPDLOG_TRACE("Boundary pass: {} particles, {} halo copies, {} near reflecting faces", firstHalo, halo.size(),
+               nearReflectingFace.size());
+}
+
+void BoundaryConditions::applyAfterForceUpdate(ParticleContainer& particles) {
+  const auto& lo = config.lowerCorner;
+  const auto& up = config.upperCorner;
+
+  for (const std::size_t index : nearReflectingFace) {
+    auto& p = particles[index];
+    const auto& x = p.getX();
+    auto f = p.getF();
+    for (std::size_t d = 0; d < 3; d++) {
+      const double distLower = x[d] - lo[d];
+      const double distUpper = up[d] - x[d];
+      if (lower(d) == BoundaryType::REFLECTING and distLower > 0 and distLower < reflectDistance) {
+        f[d] += wallForce(distLower);
+      }
+      if (upper(d) == BoundaryType::REFLECTING and distUpper > 0 and distUpper < reflectDistance) {
+        f[d] -= wallForce(distUpper);
+      }
+    }
+    p.setF(f);
+  }
+
+  particles.truncate(firstHalo);
+}
@@ -0,0 +1,168 @@
+#include "Ensemble.h"
+
+#include "io/FileReader.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+/**
+ * @brief Value of the P option selecting a parallelization
+ */
+const char* optionValue(const Parallelization parallelization) {
+  switch (parallelization) {
+    case Parallelization::ON:
+      return "ON";
+    case Parallelization::DETERMINISTIC:
+      return "DET";
+    case Parallelization::AUTO:
+      return "AUTO";
+    case Parallelization::OFF:
+      break;
+  }
+  return "OFF";
+}
+}  // namespace
+
+EnsembleRunner::EnsembleRunner(std::vector<EnsembleMember> members, const SimulationMode simulationMode,
+                               std::string outputRoot, const std::size_t largeParticles)
+    : members(std::move(members)),
+      simulationMode(simulationMode),
+      outputRoot(std::move(outputRoot)),
+      largeParticles(largeParticles) {}
+
+std::vector<EnsembleMember> EnsembleRunner::readManifest(const std::string& filename) {
+  std::ifstream input_file(filename);
+  if (not input_file.is_open()) {
+    throw std::invalid_argument("Could not open ensemble manifest " + filename);
+  }
+
+  std::vector<EnsembleMember> members;
+  std::set<std::string> names;
+  std::string line;
+  for (int lineNumber = 1; std::getline(input_file, line); lineNumber++) {
+    if (line.empty() or line[0] == '#') {
+      continue;
+    }
+    std::istringstream stream(line);
+    EnsembleMember member;
+    if (not(stream >> member.name >> member.inputFilename >> member.end_time >> member.dt)) {
+      throw std::invalid_argument("Line " + std::to_string(lineNumber) +
+                                  " of the manifest: expected name input_file t_end delta_t [options]");
+    }
+    if (not std::filesystem::exists(member.inputFilename)) {
+      throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the manifest: input file " +
+                                  member.inputFilename + " does not exist");
+    }
+    if (not names.insert(member.name).second) {
+      throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the manifest: duplicate name " +
+                                  member.name);
+    }
+    std::vector<std::string> arguments;
+    for (std::string argument; stream >> argument;) {
+      arguments.push_back(argument);
+    }
+    try {
+      member.options = SimulationOptions::parse(arguments);
+    } catch (const std::invalid_argument& err) {
+      throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the manifest: " + err.what());
+    }
+    // concurrent members must not replace each other's shared memory segments
+    if (member.options.outputFormat == OutputFormat::LIVE) {
+      member.options.streamName += "_" + member.name;
+    }
+    members.push_back(std::move(member));
+  }
+  return members;
+}
+
+void EnsembleRunner::runMember(const std::size_t index, const bool allThreads) {
+  const EnsembleMember& member = members[index];
+  EnsembleResult& result = results[index];
+  const SimulationOptions& options = member.options;
+  result.parallelization = options.parallelization;
+  const bool parallel = options.parallelization != Parallelization::OFF;
+  result.threads = allThreads and parallel ? omp_get_max_threads() : 1;
+  if (allThreads and not parallel) {
+    SPDLOG_WARN("Ensemble member {} has {} particles but runs with P:OFF on a single thread", member.name,
+                result.particles);
+  } else if (not allThreads and parallel) {
+    // the parallel region of the force calculation is nested in the one running the small members
+    SPDLOG_WARN("Ensemble member {} runs next to other members, so P:{} calculates its forces on a single thread",
+                member.name, optionValue(options.parallelization));
+  }
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    auto simulation = options.createSimulation(member.inputFilename, member.end_time, member.dt, simulationMode);
+    simulation->setOutputDirectory(outputRoot + "/" + member.name);
+    simulation->run();
+    result.succeeded = true;
+  } catch (const std::exception& err) {
+    SPDLOG_ERROR("Ensemble member {} failed: {}", member.name, err.what());
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  SPDLOG_INFO("Ensemble member {} finished after {} s on {} thread(s)", member.name, result.seconds, result.threads);
+}
+
+bool EnsembleRunner::run() {
+  results.assign(members.size(), {});
+
+  // estimate the cost of every member from its particle count and number of steps
+  std::vector<std::size_t> small;
+  std::vector<std::size_t> large;
+  std::vector<double> cost(members.size());
+  for (std::size_t i = 0; i < members.size(); i++) {
+    try {
+      results[i].particles = CuboidFileReader(members[i].inputFilename).countParticles();
+    } catch (const std::runtime_error&) {
+      // the member fails with the same error once it runs
+    }
+    const double n = static_cast<double>(results[i].particles);
+    cost[i] = n * n * (members[i].end_time / members[i].dt);
+    (results[i].particles >= largeParticles ? large : small).push_back(i);
+  }
+  // longest first, so that the last members to start are the short ones
+  std::stable_sort(small.begin(), small.end(), [&cost](std::size_t a, std::size_t b) { return cost[a] > cost[b]; });
+  SPDLOG_INFO("Running an ensemble of {} members: {} on all threads, {} one per thread", members.size(), large.size(),
+              small.size());
+
+  for (const std::size_t index : large) {
+    runMember(index, true);
+  }
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (std::size_t k = 0; k < small.size(); k++) {
+    runMember(small[k], false);
+  }
+
+  writeSummary();
+  return std::all_of(results.begin(), results.end(), [](const EnsembleResult& r) { return r.succeeded; });
+}
+
+void EnsembleRunner::writeSummary() const {
+  try {
+    std::filesystem::create_directories(outputRoot);
+  } catch (const std::filesystem::filesystem_error& err) {
+    SPDLOG_ERROR("Error while creating directory {}:{}", outputRoot, err.what());
+    return;
+  }
+  std::ofstream summary(outputRoot + "/ensemble.csv");
+  summary << "name,particles,threads,parallelization,seconds,status\n";
+  for (std::size_t i = 0; i < members.size(); i++) {
+    const EnsembleResult& result = results[i];
+    summary << members[i].name << ',' << result.particles << ',' << result.threads << ','
+            << optionValue(result.parallelization) << ',' << result.seconds << ','
+            << (result.succeeded ? "ok" : "failed") << '\n';
+  }
+}
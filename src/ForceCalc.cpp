@@ -1,34 +1,107 @@
 #include "ForceCalc.h"
+#include "utils/ArrayExpressions.h"
 #include "utils/ArrayUtils.h"
+#include "utils/Trace.h"
 
+#include <omp.h>
 #include <spdlog/spdlog.h>
 
-ForceCalc::~ForceCalc() = default;
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
-void ForceCalc::calculateX(const double dt) {
-  for (auto& p : particles) {
-    const auto x_curr = p.getX();
-    const double m = p.getM();
-    const auto F = p.getF();
-    const auto v = p.getV();
-    const auto a = (1.0 / m) * F;
-    const auto x_new = x_curr + dt * v + 0.5 * (dt * dt) * a;
-    p.setX(x_new);
+namespace {
+/**
+ * @brief Adds the energy and virial of one pair, weighted by the number of owned particles in it
+ * @param dist x_j - x_i
+ * @param F_vector Force on particle i
+ */
+inline void accumulatePair(ForceObservables& observables, const size_t i, const size_t j, const double energy,
+                           const std::array<double, 3>& dist, const std::array<double, 3>& F_vector) {
+  const double weight =
+      0.5 * (static_cast<double>(i < observables.ownedParticles) + static_cast<double>(j < observables.ownedParticles));
+  observables.potentialEnergy += weight * energy;
+  for (size_t a = 0; a < 3; ++a) {
+    for (size_t b = 0; b < 3; ++b) {
+      observables.virial[a][b] -= weight * dist[a] * F_vector[b];
+    }
   }
 }
 
-void ForceCalc::calculateV(const double dt) {
-  for (auto& p : particles) {
-    const auto v_curr = p.getV();
-    const double m_i = p.getM();
-    const auto F = p.getF();
-    const auto F_old = p.getOldF();
-    const auto v_new = v_curr + (dt / (2.0 * m_i)) * (F_old + F);
-    p.setV(v_new);
+/**
+ * @brief Adds the partial sums of one thread to the total
+ */
+inline void accumulatePartial(ForceObservables& total, const ForceObservables& partial) {
+  total.potentialEnergy += partial.potentialEnergy;
+  for (size_t a = 0; a < 3; ++a) {
+    for (size_t b = 0; b < 3; ++b) {
+      total.virial[a][b] += partial.virial[a][b];
+    }
   }
 }
 
+/**
+ * @brief x_j - x_i in the first Dimensions components, zero in the others
+ */
+template <size_t Dimensions>
+inline std::array<double, 3> difference(const std::array<double, 3>& x_i, const std::array<double, 3>& x_j) {
+  std::array<double, 3> dist{};
+  for (size_t d = 0; d < Dimensions; ++d) {
+    dist[d] = x_j[d] - x_i[d];
+  }
+  return dist;
+}
+
+/**
+ * @brief Euclidean norm of the first Dimensions components
+ */
+template <size_t Dimensions>
+inline double length(const std::array<double, 3>& dist) {
+  double norm2 = 0;
+  for (size_t d = 0; d < Dimensions; ++d) {
+    norm2 += dist[d] * dist[d];
+  }
+  return std::sqrt(norm2);
+}
+
+/**
+ * @brief Clears the sums of the observables before a force calculation
+ */
+inline void resetObservables(ForceObservables& observables) {
+  observables.potentialEnergy = 0;
+  observables.virial = {};
+  observables.valid = true;
+}
+}  // namespace
+
+ForceCalc::~ForceCalc() = default;
+
+void ForceCalc::calculateF(ForceObservables& observables) {
+  calculateF();
+  observables.valid = false;
+}
+
+void ForceCalc::setDimensions(const int newDimensions) {
+  if (newDimensions != 2 and newDimensions != 3) {
+    throw std::invalid_argument("Particles move in 2 or 3 dimensions, not " + std::to_string(newDimensions));
+  }
+  dimensions = newDimensions;
+}
+
 void GravityForce::calculateF() {
+  computeForces<false>(nullptr);
+}
+
+void GravityForce::calculateF(ForceObservables& observables) {
+  resetObservables(observables);
+  computeForces<true>(&observables);
+}
+
+template <bool withObservables>
+void GravityForce::computeForces(ForceObservables* observables) {
   for (auto& p : particles) {
     p.setF({});
   }
@@ -40,8 +113,8 @@ void GravityForce::calculateF() {
       auto& p_i = particles[i];
       auto& p_j = particles[j];
 
-      const auto dist = p_j.getX() - p_i.getX();
-      const double norm = ArrayUtils::L2Norm(dist);
+      const auto dist = ArrayUtils::eval(ArrayUtils::view(p_j.getX()) - ArrayUtils::view(p_i.getX()));
+      const double norm = ArrayUtils::norm(ArrayUtils::view(dist));
       if (norm == 0.) {
         // avoid division by zero
         SPDLOG_ERROR(
@@ -53,28 +126,47 @@ void GravityForce::calculateF() {
       }
       const double norm3 = norm * norm * norm;
 
-      const auto F_vector = ((p_i.getM() * p_j.getM()) / norm3) * dist;
+      const auto F_vector = ArrayUtils::eval(((p_i.getM() * p_j.getM()) / norm3) * ArrayUtils::view(dist));
+      if constexpr (withObservables) {
+        accumulatePair(*observables, i, j, -p_i.getM() * p_j.getM() / norm, dist, F_vector);
+      }
 
-      // apply forces using Newton's third law (O(n^2) -> O(((n^2)/2))
-      auto F_i = p_i.getF();
-      auto F_j = p_j.getF();
-      // actio est reactio
-      p_i.setF(F_i + F_vector);
-      p_j.setF(F_j - F_vector);
+      // apply forces using Newton's third law (O(n^2) -> O(((n^2)/2)), actio est reactio
+      ArrayUtils::addTo(p_i.getF(), ArrayUtils::view(F_vector));
+      ArrayUtils::addTo(p_j.getF(), -ArrayUtils::view(F_vector));
     }
   }
 }
 
 LennardJonesForce::LennardJonesForce(ParticleContainer& particles, const double epsilon, const double sigma,
                                      const double cutoffRadius)
-    : ForceCalc(particles), epsilon(epsilon), sigma(sigma), cutoffRadius(cutoffRadius) {}
+    : LennardJonesForce(particles, MixingTable(epsilon, sigma), cutoffRadius) {}
+
+LennardJonesForce::LennardJonesForce(ParticleContainer& particles, MixingTable mixing, const double cutoffRadius)
+    : ForceCalc(particles), mixing(std::move(mixing)), cutoffRadius(cutoffRadius) {}
 
 void LennardJonesForce::calculateF() {
+  if (dimensions == 2) {
+    computeForces<false, 2>(nullptr);
+  } else {
+    computeForces<false, 3>(nullptr);
+  }
+}
+
+void LennardJonesForce::calculateF(ForceObservables& observables) {
+  resetObservables(observables);
+  if (dimensions == 2) {
+    computeForces<true, 2>(&observables);
+  } else {
+    computeForces<true, 3>(&observables);
+  }
+}
+
+template <bool withObservables, size_t Dimensions>
+void LennardJonesForce::computeForces(ForceObservables* observables) {
   for (auto& p : particles) {
     p.setF({});
   }
-  const double sigma2 = sigma * sigma;
-  const double sigma6 = sigma2 * sigma2 * sigma2;
 
   const size_t n_particles = particles.size();
   for (size_t i = 0; i < n_particles; ++i) {
@@ -83,8 +175,8 @@ void LennardJonesForce::calculateF() {
       auto& p_i = particles[i];
       auto& p_j = particles[j];
 
-      const auto dist = p_j.getX() - p_i.getX();
-      const double norm = ArrayUtils::L2Norm(dist);
+      const auto dist = difference<Dimensions>(p_i.getX(), p_j.getX());
+      const double norm = length<Dimensions>(dist);
       if (norm == 0) {
         // avoid division by zero
         SPDLOG_ERROR(
@@ -99,42 +191,217 @@ void LennardJonesForce::calculateF() {
       const double inv_norm2 = 1.0 / (norm * norm);
       const double inv_norm6 = inv_norm2 * inv_norm2 * inv_norm2;
 
-      const double crossing_norm_quot_6 = sigma6 * inv_norm6;
+      const auto& params = mixing(p_i.getType(), p_j.getType());
+      const double crossing_norm_quot_6 = params.sigma6 * inv_norm6;
       const double crossing_norm_quot_12 = crossing_norm_quot_6 * crossing_norm_quot_6;
 
-      const auto F_vector = (24.0 * epsilon) * inv_norm2 * (crossing_norm_quot_6 - 2.0 * crossing_norm_quot_12) * dist;
+      const auto F_vector = params.epsilon24 * inv_norm2 * (crossing_norm_quot_6 - 2.0 * crossing_norm_quot_12) * dist;
+      if constexpr (withObservables) {
+        // 4 epsilon = epsilon24 / 6
+        const double energy = params.epsilon24 / 6.0 * (crossing_norm_quot_12 - crossing_norm_quot_6);
+        accumulatePair(*observables, i, j, energy, dist, F_vector);
+      }
 
       // apply forces using Newton's third law (O(n^2) -> O(((n^2)/2))
-      auto F_i = p_i.getF();
-      auto F_j = p_j.getF();
+      auto& F_i = p_i.getF();
+      auto& F_j = p_j.getF();
       // actio est reactio
-      p_i.setF(F_i + F_vector);
-      p_j.setF(F_j - F_vector);
+      for (size_t d = 0; d < Dimensions; ++d) {
+        F_i[d] += F_vector[d];
+        F_j[d] -= F_vector[d];
+      }
     }
   }
 }
 LennardJonesForceParallel::LennardJonesForceParallel(ParticleContainer& particles, const double epsilon,
                                                      const double sigma, const double cutoffRadius)
-    : ForceCalc(particles), epsilon(epsilon), sigma(sigma), cutoffRadius(cutoffRadius) {}
+    : LennardJonesForceParallel(particles, MixingTable(epsilon, sigma), cutoffRadius) {}
+
+LennardJonesForceParallel::LennardJonesForceParallel(ParticleContainer& particles, MixingTable mixing,
+                                                     const double cutoffRadius, const Schedule schedule)
+    : ForceCalc(particles), mixing(std::move(mixing)), cutoffRadius(cutoffRadius), schedule(schedule) {}
 
 void LennardJonesForceParallel::calculateF() {
+  if (dimensions == 2) {
+    computeForces<false, 2>(nullptr);
+  } else {
+    computeForces<false, 3>(nullptr);
+  }
+}
+
+void LennardJonesForceParallel::calculateF(ForceObservables& observables) {
+  resetObservables(observables);
+  if (dimensions == 2) {
+    computeForces<true, 2>(&observables);
+  } else {
+    computeForces<true, 3>(&observables);
+  }
+}
+
+template <bool withObservables, size_t Dimensions>
+void LennardJonesForceParallel::computeForces(ForceObservables* observables) {
 #pragma omp parallel for
   for (auto& p : particles) {
     p.setF({});
   }
-  const double sigma2 = sigma * sigma;
-  const double sigma6 = sigma2 * sigma2 * sigma2;
   const size_t n_particles = particles.size();
 
+  // partial sums of the threads
+  ForceObservables initialPartial;
+  if constexpr (withObservables) {
+    initialPartial.ownedParticles = observables->ownedParticles;
+  }
+
+  if (schedule == Schedule::WORK_STEALING) {
+    std::vector<ForceObservables> partials(scheduler.getThreads(), initialPartial);
+    const size_t tasks = (n_particles + rowsPerTask - 1) / rowsPerTask;
+    scheduler.run(
+        tasks,
+        [&](const size_t task, const int thread) {
+          TRACE_SCOPE("LennardJonesForceParallel task");
+          const size_t end = std::min(n_particles, (task + 1) * rowsPerTask);
+          for (size_t i = task * rowsPerTask; i < end; ++i) {
+            computeRow<withObservables, Dimensions>(i, partials[thread]);
+          }
+        },
+        &threadLoads);
+    if constexpr (withObservables) {
+      for (const auto& partial : partials) {
+        accumulatePartial(*observables, partial);
+      }
+    }
+    return;
+  }
+
+  threadLoads.resize(std::max(threadLoads.size(), static_cast<size_t>(omp_get_max_threads())));
+  std::vector<double> busy(threadLoads.size(), 0.0);
+  const double start = omp_get_wtime();
+#pragma omp parallel
+  {
+    ForceObservables partial = initialPartial;
+    const int thread = omp_get_thread_num();
+    const double loopStart = omp_get_wtime();
+    size_t rows = 0;
+
+    {
+      // the gaps until the end of the parallel region show the idle time of the triangular loop
+      TRACE_SCOPE("LennardJonesForceParallel rows");
+#pragma omp for schedule(guided) nowait
+      for (size_t i = 0; i < n_particles; ++i) {
+        computeRow<withObservables, Dimensions>(i, partial);
+        rows++;
+      }
+    }
+    busy[thread] = omp_get_wtime() - loopStart;
+    threadLoads[thread].busySeconds += busy[thread];
+    threadLoads[thread].tasks += rows;
+
+    if constexpr (withObservables) {
+#pragma omp critical
+      accumulatePartial(*observables, partial);
+    }
+  }
+  const double elapsed = omp_get_wtime() - start;
+  for (size_t t = 0; t < busy.size(); ++t) {
+    threadLoads[t].idleSeconds += elapsed - busy[t];
+  }
+}
+
+template <bool withObservables, size_t Dimensions>
+void LennardJonesForceParallel::computeRow(const size_t i, ForceObservables& partial) {
+  const size_t n_particles = particles.size();
+  // index offset for Newton's third law
+  for (size_t j = i + 1; j < n_particles; ++j) {
+    auto& p_i = particles[i];
+    auto& p_j = particles[j];
+
+    const auto dist = difference<Dimensions>(p_i.getX(), p_j.getX());
+    const double norm = length<Dimensions>(dist);
+    if (norm == 0) {
+      // avoid division by zero
+      SPDLOG_ERROR(
+          "Calculated a zero norm between particles. This is likely caused "
+          "by an incorrect initialization of the Simulation.");
+      throw std::overflow_error(
+          "Calculated a zero norm between particles. This is likely caused "
+          "by an incorrect initialization of the Simulation.");
+    } else if (norm >= cutoffRadius) {
+      continue;
+    }
+    const double inv_norm2 = 1.0 / (norm * norm);
+    const double inv_norm6 = inv_norm2 * inv_norm2 * inv_norm2;
+
+    const auto& params = mixing(p_i.getType(), p_j.getType());
+    const double crossing_norm_quot_6 = params.sigma6 * inv_norm6;
+    const double crossing_norm_quot_12 = crossing_norm_quot_6 * crossing_norm_quot_6;
+
+    const auto F_vector = params.epsilon24 * inv_norm2 * (crossing_norm_quot_6 - 2.0 * crossing_norm_quot_12) * dist;
+    if constexpr (withObservables) {
+      // 4 epsilon = epsilon24 / 6
+      const double energy = params.epsilon24 / 6.0 * (crossing_norm_quot_12 - crossing_norm_quot_6);
+      accumulatePair(partial, i, j, energy, dist, F_vector);
+    }
+
+    auto& Fi = p_i.getF();
+    auto& Fj = p_j.getF();
+    // apply forces using Newton's third law and atomic operations
+    for (size_t d = 0; d < Dimensions; ++d) {
+#pragma omp atomic
+      Fi[d] += F_vector[d];
+#pragma omp atomic
+      Fj[d] -= F_vector[d];
+    }
+  }
+}
+
+LennardJonesForceDeterministic::LennardJonesForceDeterministic(ParticleContainer& particles, MixingTable mixing,
+                                                               const double cutoffRadius)
+    : ForceCalc(particles), mixing(std::move(mixing)), cutoffRadius(cutoffRadius) {}
+
+void LennardJonesForceDeterministic::calculateF() {
+  if (dimensions == 2) {
+    computeForces<false, 2>(nullptr);
+  } else {
+    computeForces<false, 3>(nullptr);
+  }
+}
+
+void LennardJonesForceDeterministic::calculateF(ForceObservables& observables) {
+  resetObservables(observables);
+  if (dimensions == 2) {
+    computeForces<true, 2>(&observables);
+  } else {
+    computeForces<true, 3>(&observables);
+  }
+}
+
+template <bool withObservables, size_t Dimensions>
+void LennardJonesForceDeterministic::computeForces(ForceObservables* observables) {
+  const size_t n_particles = particles.size();
+
+  // energy and virial of every particle's half of its pairs, reduced in index order after the pair loop
+  std::vector<ForceObservables> shares;
+  if constexpr (withObservables) {
+    ForceObservables share;
+    share.ownedParticles = observables->ownedParticles;
+    shares.assign(n_particles, share);
+  }
+
 #pragma omp parallel for schedule(guided)
   for (size_t i = 0; i < n_particles; ++i) {
-    // index offset for Newton's third law
-    for (size_t j = i + 1; j < n_particles; ++j) {
-      auto& p_i = particles[i];
-      auto& p_j = particles[j];
+    std::array<double, 3> F_i{};
+    for (size_t j = 0; j < n_particles; ++j) {
+      if (j == i) {
+        continue;
+      }
+      // evaluate the pair in the orientation of the serial kernel, whose outer loop runs over the lower index
+      const size_t lower = std::min(i, j);
+      const size_t upper = std::max(i, j);
+      const auto& p_lower = particles[lower];
+      const auto& p_upper = particles[upper];
 
-      const auto dist = p_j.getX() - p_i.getX();
-      const double norm = ArrayUtils::L2Norm(dist);
+      const auto dist = difference<Dimensions>(p_lower.getX(), p_upper.getX());
+      const double norm = length<Dimensions>(dist);
       if (norm == 0) {
         // avoid division by zero
         SPDLOG_ERROR(
@@ -149,27 +416,28 @@ void LennardJonesForceParallel::calculateF() {
       const double inv_norm2 = 1.0 / (norm * norm);
       const double inv_norm6 = inv_norm2 * inv_norm2 * inv_norm2;
 
-      const double crossing_norm_quot_6 = sigma6 * inv_norm6;
+      const auto& params = mixing(p_lower.getType(), p_upper.getType());
+      const double crossing_norm_quot_6 = params.sigma6 * inv_norm6;
       const double crossing_norm_quot_12 = crossing_norm_quot_6 * crossing_norm_quot_6;
 
-      const auto F_vector = (24.0 * epsilon) * inv_norm2 * (crossing_norm_quot_6 - 2.0 * crossing_norm_quot_12) * dist;
+      const auto F_vector = params.epsilon24 * inv_norm2 * (crossing_norm_quot_6 - 2.0 * crossing_norm_quot_12) * dist;
+      if constexpr (withObservables) {
+        // every pair is visited from both sides
+        const double energy = params.epsilon24 / 6.0 * (crossing_norm_quot_12 - crossing_norm_quot_6);
+        accumulatePair(shares[i], lower, upper, 0.5 * energy, dist, 0.5 * F_vector);
+      }
 
-      auto& Fi = p_i.getF();
-      auto& Fj = p_j.getF();
-      // apply forces using Newton's third law and atomic operations
-#pragma omp atomic
-      Fi[0] += F_vector[0];
-#pragma omp atomic
-      Fi[1] += F_vector[1];
-#pragma omp atomic
-      Fi[2] += F_vector[2];
+      // same operations in the same order as the serial kernel applies to this particle
+      for (size_t d = 0; d < Dimensions; ++d) {
+        F_i[d] = j < i ? F_i[d] - F_vector[d] : F_i[d] + F_vector[d];
+      }
+    }
+    particles[i].setF(F_i);
+  }
 
-#pragma omp atomic
-      Fj[0] -= F_vector[0];
-#pragma omp atomic
-      Fj[1] -= F_vector[1];
-#pragma omp atomic
-      Fj[2] -= F_vector[2];
+  if constexpr (withObservables) {
+    for (const auto& share : shares) {
+      accumulatePartial(*observables, share);
     }
   }
-}
\ No newline at end of file
+}
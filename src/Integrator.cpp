@@ -0,0 +1,88 @@
+#include "Integrator.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+/**
+ * @brief Störmer-Verlet position update of the first Dimensions components, which also stores f(t_n) for the
+ * velocity update
+ */
+template <std::size_t Dimensions>
+void updatePositions(ParticleContainer& particles, const double dt) {
+  for (auto& p : particles) {
+    auto x = p.getX();
+    const auto& v = p.getV();
+    const auto& F = p.getF();
+    const double inv_m = 1.0 / p.getM();
+    for (std::size_t d = 0; d < Dimensions; ++d) {
+      x[d] = x[d] + dt * v[d] + 0.5 * (dt * dt) * (inv_m * F[d]);
+    }
+    p.setX(x);
+    p.setOldF(F);
+  }
+}
+
+/**
+ * @brief Störmer-Verlet velocity update of the first Dimensions components
+ */
+template <std::size_t Dimensions>
+void updateVelocities(ParticleContainer& particles, const double dt) {
+  for (auto& p : particles) {
+    auto v = p.getV();
+    const auto& F = p.getF();
+    const auto& F_old = p.getOldF();
+    const double scale = dt / (2.0 * p.getM());
+    for (std::size_t d = 0; d < Dimensions; ++d) {
+      v[d] = v[d] + scale * (F_old[d] + F[d]);
+    }
+    p.setV(v);
+  }
+}
+}  // namespace
+
+Integrator::~Integrator() = default;
+
+void Integrator::setDimensions(const int newDimensions) {
+  if (newDimensions != 2 and newDimensions != 3) {
+    throw std::invalid_argument("Particles move in 2 or 3 dimensions, not " + std::to_string(newDimensions));
+  }
+  dimensions = newDimensions;
+}
+
+void Integrator::verletStep(ParticleContainer& particles, const double h, const std::function<void(bool)>& updateForces,
+                            const bool last) const {
+  if (dimensions == 2) {
+    updatePositions<2>(particles, h);
+  } else {
+    updatePositions<3>(particles, h);
+  }
+  updateForces(last);
+  if (dimensions == 2) {
+    updateVelocities<2>(particles, h);
+  } else {
+    updateVelocities<3>(particles, h);
+  }
+}
+
+void VelocityVerlet::step(ParticleContainer& particles, const double dt, const ForceUpdate& updateForces) const {
+  verletStep(particles, dt, updateForces, true);
+}
+
+void ForestRuth::step(ParticleContainer& particles, const double dt, const ForceUpdate& updateForces) const {
+  static const double theta = 1.0 / (2.0 - std::cbrt(2.0));
+  verletStep(particles, theta * dt, updateForces, false);
+  verletStep(particles, (1.0 - 2.0 * theta) * dt, updateForces, false);
+  verletStep(particles, theta * dt, updateForces, true);
+}
+
+std::unique_ptr<Integrator> createIntegrator(const IntegrationScheme scheme) {
+  switch (scheme) {
+    case IntegrationScheme::FOREST_RUTH:
+      return std::make_unique<ForestRuth>();
+    case IntegrationScheme::VERLET:
+    default:
+      return std::make_unique<VelocityVerlet>();
+  }
+}
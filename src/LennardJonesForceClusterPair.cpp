@@ -0,0 +1,671 @@
+#include "LennardJonesForceClusterPair.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+/**
+ * @brief Spreads the lower 21 bits of v so that two zero bits follow each of them
+ */
+std::uint64_t spreadBits(std::uint64_t v) {
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffff;
+  v = (v | v << 16) & 0x1f0000ff0000ff;
+  v = (v | v << 8) & 0x100f00f00f00f00f;
+  v = (v | v << 4) & 0x10c30c30c30c30c3;
+  v = (v | v << 2) & 0x1249249249249249;
+  return v;
+}
+}  // namespace
+
+template <std::size_t ClusterSize>
+LennardJonesForceClusterPair<ClusterSize>::LennardJonesForceClusterPair(ParticleContainer& particles,
+                                                                        const MixingTable& mixing,
+                                                                        const double cutoffRadius, const double buffer)
+    : ForceCalc(particles), cutoffRadius(cutoffRadius), buffer(buffer), numTypes(mixing.size()) {
+  if (buffer < 0) {
+    throw std::invalid_argument("The buffer of the cluster pair list must not be negative");
+  }
+  epsilon24Table.resize(numTypes * numTypes);
+  sigma6Table.resize(numTypes * numTypes);
+  for (std::size_t ti = 0; ti < numTypes; ++ti) {
+    for (std::size_t tj = 0; tj < numTypes; ++tj) {
+      const auto& params = mixing(static_cast<int>(ti), static_cast<int>(tj));
+      epsilon24Table[ti * numTypes + tj] = params.epsilon24;
+      sigma6Table[ti * numTypes + tj] = params.sigma6;
+    }
+  }
+}
+
+template <std::size_t ClusterSize>
+bool LennardJonesForceClusterPair<ClusterSize>::needsRebuild() const {
+  if (referencePositions.size() != particles.size() or rebuilds == 0) {
+    return true;
+  }
+  // pairs within the cutoff were within cutoff + buffer when the list was built if neither moved by more than half
+  const double limit2 = 0.25 * buffer * buffer;
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    const auto& x_i = particles[i].getX();
+    const auto& ref = referencePositions[i];
+    const double dx = x_i[0] - ref[0];
+    const double dy = x_i[1] - ref[1];
+    const double dz = x_i[2] - ref[2];
+    if (dx * dx + dy * dy + dz * dz > limit2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::rebuild() {
+  const std::size_t n_particles = particles.size();
+  std::array<double, 3> lower;
+  std::array<double, 3> upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+  referencePositions.resize(n_particles);
+  for (std::size_t i = 0; i < n_particles; ++i) {
+    referencePositions[i] = particles[i].getX();
+    for (std::size_t d = 0; d < 3; ++d) {
+      lower[d] = std::min(lower[d], referencePositions[i][d]);
+      upper[d] = std::max(upper[d], referencePositions[i][d]);
+    }
+  }
+
+  // sort along a Morton curve through cells that hold one cluster on average, so that consecutive particles are close
+  int spanned = 0;
+  double volume = 1;
+  for (std::size_t d = 0; d < 3; ++d) {
+    if (upper[d] > lower[d]) {
+      spanned++;
+      volume *= upper[d] - lower[d];
+    }
+  }
+  double cell = 1;
+  if (spanned > 0 and n_particles > 0) {
+    cell = std::pow(volume * ClusterSize / static_cast<double>(n_particles), 1.0 / spanned);
+  }
+  std::vector<std::pair<std::uint64_t, std::size_t>> order(n_particles);
+  for (std::size_t i = 0; i < n_particles; ++i) {
+    std::uint64_t key = 0;
+    for (std::size_t d = 0; d < 3; ++d) {
+      const double c = std::min((referencePositions[i][d] - lower[d]) / cell, static_cast<double>(0x1fffff));
+      key |= spreadBits(static_cast<std::uint64_t>(c)) << d;
+    }
+    order[i] = {key, i};
+  }
+  std::sort(order.begin(), order.end());
+
+  const std::size_t n_clusters = (n_particles + ClusterSize - 1) / ClusterSize;
+  const std::size_t n_slots = n_clusters * ClusterSize;
+  slotParticle.assign(n_slots, n_particles);
+  for (std::size_t k = 0; k < n_particles; ++k) {
+    slotParticle[k] = order[k].second;
+  }
+  for (auto* v : {&x, &y, &z, &present, &fx, &fy, &fz}) {
+    v->assign(n_slots, 0.0);
+  }
+  typeIndex.assign(n_slots, 0);
+
+  // bounding box of every cluster as lower and upper corner
+  std::vector<std::array<double, 6>> boxes(n_clusters);
+  for (std::size_t c = 0; c < n_clusters; ++c) {
+    auto& box = boxes[c];
+    box = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+           std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+           std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (std::size_t k = c * ClusterSize; k < std::min((c + 1) * ClusterSize, n_particles); ++k) {
+      for (std::size_t d = 0; d < 3; ++d) {
+        box[d] = std::min(box[d], referencePositions[slotParticle[k]][d]);
+        box[3 + d] = std::max(box[3 + d], referencePositions[slotParticle[k]][d]);
+      }
+    }
+  }
+
+  // bin the clusters by the centers of their boxes into cells at least as wide as the reach plus the largest box, so
+  // that the boxes of two clusters are only within reach if their cells are neighbours
+  const double reach = cutoffRadius + buffer;
+  const double reach2 = reach * reach;
+  double largestBox = 0;
+  std::array<double, 3> lowerCenter;
+  std::array<double, 3> upperCenter;
+  lowerCenter.fill(std::numeric_limits<double>::max());
+  upperCenter.fill(std::numeric_limits<double>::lowest());
+  for (const auto& box : boxes) {
+    for (std::size_t d = 0; d < 3; ++d) {
+      largestBox = std::max(largestBox, box[3 + d] - box[d]);
+      lowerCenter[d] = std::min(lowerCenter[d], 0.5 * (box[d] + box[3 + d]));
+      upperCenter[d] = std::max(upperCenter[d], 0.5 * (box[d] + box[3 + d]));
+    }
+  }
+  double width = std::max(reach + largestBox, std::numeric_limits<double>::min());
+  std::array<std::size_t, 3> cells{1, 1, 1};
+  // sparse systems would get more cells than clusters, wider cells keep the grid small
+  for (; n_clusters > 0; width *= 2) {
+    std::array<double, 3> perDimension{};
+    for (std::size_t d = 0; d < 3; ++d) {
+      perDimension[d] = std::floor((upperCenter[d] - lowerCenter[d]) / width) + 1;
+    }
+    if (perDimension[0] * perDimension[1] * perDimension[2] <= static_cast<double>(2 * n_clusters + 1)) {
+      for (std::size_t d = 0; d < 3; ++d) {
+        cells[d] = static_cast<std::size_t>(perDimension[d]);
+      }
+      break;
+    }
+  }
+  const auto cellOf = [&](const std::size_t c, const std::size_t d) {
+    const double center = 0.5 * (boxes[c][d] + boxes[c][3 + d]);
+    return std::min(cells[d] - 1, static_cast<std::size_t>((center - lowerCenter[d]) / width));
+  };
+  std::vector<std::size_t> cellStart(cells[0] * cells[1] * cells[2] + 1, 0);
+  std::vector<std::size_t> clusterCell(n_clusters);
+  for (std::size_t c = 0; c < n_clusters; ++c) {
+    clusterCell[c] = (cellOf(c, 0) * cells[1] + cellOf(c, 1)) * cells[2] + cellOf(c, 2);
+    cellStart[clusterCell[c] + 1]++;
+  }
+  for (std::size_t cell = 1; cell < cellStart.size(); ++cell) {
+    cellStart[cell] += cellStart[cell - 1];
+  }
+  std::vector<std::size_t> cellClusters(n_clusters);
+  std::vector<std::size_t> filled(cellStart.begin(), cellStart.end() - 1);
+  for (std::size_t c = 0; c < n_clusters; ++c) {
+    cellClusters[filled[clusterCell[c]]++] = c;
+  }
+
+  clusterPairs.clear();
+  std::vector<std::size_t> partners;
+  for (std::size_t ci = 0; ci < n_clusters; ++ci) {
+    partners.clear();
+    const std::array<std::size_t, 3> cell{cellOf(ci, 0), cellOf(ci, 1), cellOf(ci, 2)};
+    for (std::size_t cx = cell[0] > 0 ? cell[0] - 1 : 0; cx <= std::min(cell[0] + 1, cells[0] - 1); ++cx) {
+      for (std::size_t cy = cell[1] > 0 ? cell[1] - 1 : 0; cy <= std::min(cell[1] + 1, cells[1] - 1); ++cy) {
+        for (std::size_t cz = cell[2] > 0 ? cell[2] - 1 : 0; cz <= std::min(cell[2] + 1, cells[2] - 1); ++cz) {
+          const std::size_t neighbour = (cx * cells[1] + cy) * cells[2] + cz;
+          for (std::size_t k = cellStart[neighbour]; k < cellStart[neighbour + 1]; ++k) {
+            const std::size_t cj = cellClusters[k];
+            if (cj < ci) {
+              continue;
+            }
+            double dist2 = 0;
+            for (std::size_t d = 0; d < 3; ++d) {
+              const double gap = std::max({0.0, boxes[cj][d] - boxes[ci][3 + d], boxes[ci][d] - boxes[cj][3 + d]});
+              dist2 += gap * gap;
+            }
+            if (dist2 < reach2) {
+              partners.push_back(cj);
+            }
+          }
+        }
+      }
+    }
+    // the same order as a loop over all pairs, so the forces are summed in a reproducible order
+    std::sort(partners.begin(), partners.end());
+    for (const std::size_t cj : partners) {
+      clusterPairs.emplace_back(static_cast<std::uint32_t>(ci), static_cast<std::uint32_t>(cj));
+    }
+  }
+  // the cached forces of sleeping clusters refer to the old clusters
+  cacheValid = false;
+  rebuilds++;
+  SPDLOG_TRACE("Built {} clusters of {} particles with {} cluster pairs", n_clusters, ClusterSize,
+               clusterPairs.size());
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::calculateF() {
+  if (dimensions == 2) {
+    computeForces<false, 2>(nullptr);
+  } else {
+    computeForces<false, 3>(nullptr);
+  }
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::calculateF(ForceObservables& observables) {
+  observables.potentialEnergy = 0;
+  observables.virial = {};
+  observables.valid = true;
+  if (dimensions == 2) {
+    computeForces<true, 2>(&observables);
+  } else {
+    computeForces<true, 3>(&observables);
+  }
+}
+
+template <std::size_t ClusterSize>
+template <bool withObservables, std::size_t Dimensions>
+void LennardJonesForceClusterPair<ClusterSize>::computeForces(ForceObservables* observables) {
+  if (needsRebuild()) {
+    rebuild();
+  }
+
+  const std::size_t n_particles = particles.size();
+  const std::size_t n_slots = slotParticle.size();
+  const std::size_t owned = withObservables ? observables->ownedParticles : n_particles;
+  if constexpr (withObservables) {
+    ownedSlot.assign(n_slots, 0.0);
+  }
+  for (std::size_t k = 0; k < n_slots; ++k) {
+    const std::size_t index = slotParticle[k];
+    if (index < n_particles) {
+      const auto& p = particles[index];
+      x[k] = p.getX()[0];
+      y[k] = p.getX()[1];
+      if constexpr (Dimensions == 3) {
+        z[k] = p.getX()[2];
+      }
+      present[k] = 1.0;
+      typeIndex[k] = numTypes == 1 ? 0 : static_cast<std::size_t>(p.getType());
+      if constexpr (withObservables) {
+        ownedSlot[k] = static_cast<double>(index < owned);
+      }
+    }
+    fx[k] = fy[k] = fz[k] = 0;
+  }
+
+  // observables need every pair, so sleeping clusters are only skipped without them
+  const bool skipSleeping = sleepSettings.has_value() and not withObservables;
+  std::size_t zeroDistances = 0;
+  if (skipSleeping) {
+    updateSleeping();
+    if (sleepSettings->strict and cacheValid) {
+      wakeUnboundedClusters<Dimensions>();
+    }
+    if (not cacheValid) {
+      for (auto* v : {&cachedX, &cachedY, &cachedZ}) {
+        v->assign(n_slots, 0.0);
+      }
+      if (sleepSettings->strict) {
+        cachedPositionX = x;
+        cachedPositionY = y;
+        cachedPositionZ = z;
+        errorSlope.assign(n_slots, 0.0);
+        cutoffMargin.assign(n_slots, std::numeric_limits<double>::infinity());
+      }
+      for (const auto& [ci, cj] : clusterPairs) {
+        if (asleep[ci] and asleep[cj]) {
+          zeroDistances += interactClusters<false, Dimensions>(ci, cj, cachedX.data(), cachedY.data(),
+                                                               cachedZ.data(), nullptr);
+          if (sleepSettings->strict) {
+            boundCachedError<Dimensions>(ci, cj);
+          }
+        }
+      }
+      cacheValid = true;
+    }
+  }
+
+  for (const auto& [ci, cj] : clusterPairs) {
+    if (skipSleeping and asleep[ci] and asleep[cj]) {
+      skippedPairs++;
+      continue;
+    }
+    zeroDistances +=
+        interactClusters<withObservables, Dimensions>(ci, cj, fx.data(), fy.data(), fz.data(), observables);
+  }
+  totalPairs += clusterPairs.size();
+
+  if (zeroDistances > 0) {
+    // avoid division by zero
+    SPDLOG_ERROR(
+        "Calculated a zero norm between particles. This is likely caused "
+        "by an incorrect initialization of the Simulation.");
+    throw std::overflow_error(
+        "Calculated a zero norm between particles. This is likely caused "
+        "by an incorrect initialization of the Simulation.");
+  }
+
+  if (skipSleeping) {
+    for (std::size_t k = 0; k < n_slots; ++k) {
+      fx[k] += cachedX[k];
+      fy[k] += cachedY[k];
+      fz[k] += cachedZ[k];
+    }
+    if (sleepSettings->verifyPeriodically and ++stepsSinceVerification >= sleepSettings->verifyInterval) {
+      stepsSinceVerification = 0;
+      verify<Dimensions>();
+    }
+  }
+
+  for (std::size_t k = 0; k < n_slots; ++k) {
+    if (slotParticle[k] < n_particles) {
+      particles[slotParticle[k]].setF({fx[k], fy[k], fz[k]});
+    }
+  }
+  if (sleepSettings) {
+    updateQuietSteps();
+  }
+}
+
+template <std::size_t ClusterSize>
+template <bool withObservables, std::size_t Dimensions>
+std::size_t LennardJonesForceClusterPair<ClusterSize>::interactClusters(const std::size_t ci, const std::size_t cj,
+                                                                        double* forceX, double* forceY,
+                                                                        double* forceZ,
+                                                                        ForceObservables* observables) {
+  const double cutoff2 = cutoffRadius * cutoffRadius;
+  std::size_t zeroDistances = 0;
+  std::array<double, ClusterSize> epsilon24_j, sigma6_j;
+  std::array<double, ClusterSize> factor_j, energy_j, dx_j, dy_j, dz_j;
+  const std::size_t i0 = ci * ClusterSize;
+  const std::size_t j0 = cj * ClusterSize;
+  for (std::size_t i = 0; i < ClusterSize; ++i) {
+    const std::size_t si = i0 + i;
+    const double x_i = x[si];
+    const double y_i = y[si];
+    const double z_i = Dimensions == 3 ? z[si] : 0.0;
+    const double present_i = present[si];
+    const std::size_t row = typeIndex[si] * numTypes;
+    for (std::size_t j = 0; j < ClusterSize; ++j) {
+      epsilon24_j[j] = epsilon24Table[row + typeIndex[j0 + j]];
+      sigma6_j[j] = sigma6Table[row + typeIndex[j0 + j]];
+    }
+
+    double fx_i = 0;
+    double fy_i = 0;
+    double fz_i = 0;
+    // all ClusterSize interactions, pairs out of range or counted twice are masked instead of skipped
+#pragma omp simd reduction(+ : fx_i, fy_i, fz_i, zeroDistances)
+    for (std::size_t j = 0; j < ClusterSize; ++j) {
+      const std::size_t sj = j0 + j;
+      const double dx = x[sj] - x_i;
+      const double dy = y[sj] - y_i;
+      const double dz = Dimensions == 3 ? z[sj] - z_i : 0.0;
+      const double r2 = dx * dx + dy * dy + dz * dz;
+      const bool inRange = (ci != cj or j > i) and r2 < cutoff2;
+      const double mask = present_i * present[sj] * static_cast<double>(inRange);
+      zeroDistances += static_cast<std::size_t>(mask != 0 and r2 == 0);
+
+      const double inv_r2 = 1.0 / (mask != 0 ? r2 : 1.0);
+      const double sigma_r6 = sigma6_j[j] * inv_r2 * inv_r2 * inv_r2;
+      const double factor = mask * epsilon24_j[j] * inv_r2 * (sigma_r6 - 2.0 * sigma_r6 * sigma_r6);
+      fx_i += factor * dx;
+      fy_i += factor * dy;
+      fz_i += factor * dz;
+      forceX[sj] -= factor * dx;
+      forceY[sj] -= factor * dy;
+      if constexpr (Dimensions == 3) {
+        forceZ[sj] -= factor * dz;
+      }
+      if constexpr (withObservables) {
+        // 4 epsilon = epsilon24 / 6
+        energy_j[j] = mask * epsilon24_j[j] / 6.0 * (sigma_r6 * sigma_r6 - sigma_r6);
+        factor_j[j] = factor;
+        dx_j[j] = dx;
+        dy_j[j] = dy;
+        dz_j[j] = dz;
+      }
+    }
+    forceX[si] += fx_i;
+    forceY[si] += fy_i;
+    forceZ[si] += fz_i;
+
+    if constexpr (withObservables) {
+      for (std::size_t j = 0; j < ClusterSize; ++j) {
+        const double weight = 0.5 * (ownedSlot[si] + ownedSlot[j0 + j]);
+        const std::array<double, 3> dist{dx_j[j], dy_j[j], dz_j[j]};
+        observables->potentialEnergy += weight * energy_j[j];
+        for (std::size_t a = 0; a < 3; ++a) {
+          for (std::size_t b = 0; b < 3; ++b) {
+            observables->virial[a][b] -= weight * dist[a] * factor_j[j] * dist[b];
+          }
+        }
+      }
+    }
+  }
+  return zeroDistances;
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::enableSleeping(const SleepSettings& settings) {
+  if (settings.quietSteps == 0 or settings.verifyInterval == 0 or not(settings.displacementTolerance >= 0) or
+      not(settings.forceTolerance >= 0) or not(settings.maxForceError >= 0)) {
+    throw std::invalid_argument("Sleeping clusters require positive step counts and non-negative tolerances");
+  }
+  sleepSettings = settings;
+  quietSteps.clear();
+  quietPosition.clear();
+  quietForce.clear();
+  quietKey.clear();
+  cacheValid = false;
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::matchQuietState() {
+  const std::size_t n_particles = particles.size();
+  std::size_t largestId = 0;
+  for (const auto& p : particles) {
+    largestId = std::max(largestId, p.getId());
+  }
+  copiesOfId.assign(largestId + 1, 0);
+  particleKey.resize(n_particles);
+  for (std::size_t i = 0; i < n_particles; ++i) {
+    auto& copies = copiesOfId[particles[i].getId()];
+    particleKey[i] = particles[i].getId() * 256 + copies;
+    copies = static_cast<std::uint8_t>(std::min(copies + 1, 255));
+  }
+  // usually only the halo copies at the end or the particles moved by outflow changed
+  std::size_t first = 0;
+  while (first < std::min(n_particles, quietKey.size()) and quietKey[first] == particleKey[first]) {
+    first++;
+  }
+  if (first == n_particles and quietKey.size() == n_particles) {
+    return;
+  }
+  std::unordered_map<std::size_t, std::size_t> previousIndex;
+  for (std::size_t i = first; i < quietKey.size(); ++i) {
+    previousIndex.emplace(quietKey[i], i);
+  }
+  std::vector<std::size_t> steps(n_particles - first, 0);
+  std::vector<std::array<double, 3>> positions(n_particles - first), forces(n_particles - first);
+  for (std::size_t i = first; i < n_particles; ++i) {
+    if (const auto it = previousIndex.find(particleKey[i]); it != previousIndex.end()) {
+      steps[i - first] = quietSteps[it->second];
+      positions[i - first] = quietPosition[it->second];
+      forces[i - first] = quietForce[it->second];
+    }
+  }
+  quietSteps.resize(first);
+  quietPosition.resize(first);
+  quietForce.resize(first);
+  quietSteps.insert(quietSteps.end(), steps.begin(), steps.end());
+  quietPosition.insert(quietPosition.end(), positions.begin(), positions.end());
+  quietForce.insert(quietForce.end(), forces.begin(), forces.end());
+  quietKey = particleKey;
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::updateSleeping() {
+  const std::size_t n_particles = particles.size();
+  const std::size_t n_clusters = slotParticle.size() / ClusterSize;
+  matchQuietState();
+  // particles that moved away wake their clusters before the forces are calculated
+  const double displacement2 = sleepSettings->displacementTolerance * sleepSettings->displacementTolerance;
+  for (std::size_t i = 0; i < n_particles; ++i) {
+    const auto& x_i = particles[i].getX();
+    double dx2 = 0;
+    for (std::size_t d = 0; d < 3; ++d) {
+      dx2 += (x_i[d] - quietPosition[i][d]) * (x_i[d] - quietPosition[i][d]);
+    }
+    if (dx2 > displacement2) {
+      quietSteps[i] = 0;
+    }
+  }
+  if (cachedAsleep.size() != n_clusters) {
+    cachedAsleep.assign(n_clusters, 0);
+    cacheValid = false;
+  }
+  asleep.assign(n_clusters, 0);
+  for (std::size_t c = 0; c < n_clusters; ++c) {
+    bool quiet = true;
+    for (std::size_t k = c * ClusterSize; k < (c + 1) * ClusterSize; ++k) {
+      quiet = quiet and (slotParticle[k] >= n_particles or quietSteps[slotParticle[k]] >= sleepSettings->quietSteps);
+    }
+    asleep[c] = static_cast<char>(quiet);
+  }
+  if (asleep != cachedAsleep) {
+    cachedAsleep = asleep;
+    cacheValid = false;
+  }
+}
+
+template <std::size_t ClusterSize>
+void LennardJonesForceClusterPair<ClusterSize>::updateQuietSteps() {
+  const double forceChange2 = sleepSettings->forceTolerance * sleepSettings->forceTolerance;
+  matchQuietState();
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    const auto& F_i = particles[i].getF();
+    double dF2 = 0;
+    for (std::size_t d = 0; d < 3; ++d) {
+      dF2 += (F_i[d] - quietForce[i][d]) * (F_i[d] - quietForce[i][d]);
+    }
+    // a particle that just became quiet, or whose force changed, starts over from its current state
+    const bool changed = dF2 > forceChange2;
+    if (quietSteps[i] == 0 or changed) {
+      quietPosition[i] = particles[i].getX();
+      quietForce[i] = F_i;
+    }
+    quietSteps[i] = changed and quietSteps[i] > 0 ? 0 : quietSteps[i] + 1;
+  }
+}
+
+template <std::size_t ClusterSize>
+template <std::size_t Dimensions>
+void LennardJonesForceClusterPair<ClusterSize>::boundCachedError(const std::size_t ci, const std::size_t cj) {
+  // every sleeping particle stays within the displacement tolerance of a position it also had when the forces were
+  // cached, so the distance of a pair changes by at most four tolerances
+  const double reach = 4.0 * sleepSettings->displacementTolerance;
+  for (std::size_t i = 0; i < ClusterSize; ++i) {
+    const std::size_t si = ci * ClusterSize + i;
+    if (present[si] == 0) {
+      continue;
+    }
+    for (std::size_t j = ci == cj ? i + 1 : 0; j < ClusterSize; ++j) {
+      const std::size_t sj = cj * ClusterSize + j;
+      if (present[sj] == 0) {
+        continue;
+      }
+      const double dx = x[sj] - x[si];
+      const double dy = y[sj] - y[si];
+      const double dz = Dimensions == 3 ? z[sj] - z[si] : 0.0;
+      const double r = std::sqrt(dx * dx + dy * dy + dz * dz);
+      cutoffMargin[si] = std::min(cutoffMargin[si], std::abs(r - cutoffRadius));
+      cutoffMargin[sj] = std::min(cutoffMargin[sj], std::abs(r - cutoffRadius));
+      if (r >= cutoffRadius) {
+        continue;
+      }
+      // the eigenvalues of the Jacobian of the pair force are |F| / r and d|F| / dr, which are both bounded by
+      // epsilon24 / r^2 * (26 (sigma / r)^12 + 7 (sigma / r)^6), a bound that decreases with r
+      const double r_min = r - reach;
+      double slope = std::numeric_limits<double>::infinity();
+      if (r_min > 0) {
+        const std::size_t types = typeIndex[si] * numTypes + typeIndex[sj];
+        const double inv_r2 = 1.0 / (r_min * r_min);
+        const double sigma_r6 = sigma6Table[types] * inv_r2 * inv_r2 * inv_r2;
+        slope = epsilon24Table[types] * inv_r2 * (26.0 * sigma_r6 * sigma_r6 + 7.0 * sigma_r6);
+      }
+      errorSlope[si] += slope;
+      errorSlope[sj] += slope;
+    }
+  }
+}
+
+template <std::size_t ClusterSize>
+template <std::size_t Dimensions>
+void LennardJonesForceClusterPair<ClusterSize>::wakeUnboundedClusters() {
+  const std::size_t n_slots = slotParticle.size();
+  std::vector<double> drift(n_slots, 0.0);
+  double largestDrift = 0;
+  for (std::size_t k = 0; k < n_slots; ++k) {
+    if (present[k] != 0 and asleep[k / ClusterSize]) {
+      const double dx = x[k] - cachedPositionX[k];
+      const double dy = y[k] - cachedPositionY[k];
+      const double dz = Dimensions == 3 ? z[k] - cachedPositionZ[k] : 0.0;
+      drift[k] = std::sqrt(dx * dx + dy * dy + dz * dz);
+      largestDrift = std::max(largestDrift, drift[k]);
+    }
+  }
+  if (largestDrift == 0) {
+    return;
+  }
+  // the distance to any cached partner changed by at most the own drift plus the largest drift
+  const double reach = 4.0 * sleepSettings->displacementTolerance;
+  bool woken = false;
+  for (std::size_t c = 0; c < asleep.size(); ++c) {
+    if (not asleep[c]) {
+      continue;
+    }
+    bool bounded = true;
+    for (std::size_t k = c * ClusterSize; k < (c + 1) * ClusterSize; ++k) {
+      const double change = drift[k] + largestDrift;
+      bounded = bounded and (present[k] == 0 or (change <= reach and change < cutoffMargin[k] and
+                                                 errorSlope[k] * change <= sleepSettings->maxForceError));
+    }
+    if (not bounded) {
+      for (std::size_t k = c * ClusterSize; k < (c + 1) * ClusterSize; ++k) {
+        if (slotParticle[k] < particles.size()) {
+          quietSteps[slotParticle[k]] = 0;
+        }
+      }
+      asleep[c] = 0;
+      woken = true;
+    }
+  }
+  if (woken) {
+    cachedAsleep = asleep;
+    cacheValid = false;
+  }
+}
+
+template <std::size_t ClusterSize>
+template <std::size_t Dimensions>
+void LennardJonesForceClusterPair<ClusterSize>::verify() {
+  if (std::find(asleep.begin(), asleep.end(), 1) == asleep.end()) {
+    return;
+  }
+  const std::size_t n_slots = slotParticle.size();
+  std::vector<double> exactX(n_slots, 0.0);
+  std::vector<double> exactY(n_slots, 0.0);
+  std::vector<double> exactZ(n_slots, 0.0);
+  for (const auto& [ci, cj] : clusterPairs) {
+    interactClusters<false, Dimensions>(ci, cj, exactX.data(), exactY.data(), exactZ.data(), nullptr);
+  }
+  double error = 0;
+  for (std::size_t k = 0; k < n_slots; ++k) {
+    error = std::max({error, std::abs(fx[k] - exactX[k]), std::abs(fy[k] - exactY[k]), std::abs(fz[k] - exactZ[k])});
+  }
+  largestVerifiedError = std::max(largestVerifiedError, error);
+  if (error > sleepSettings->maxForceError) {
+    SPDLOG_DEBUG("Cached forces of sleeping clusters are off by {}, waking all clusters", error);
+    fx = std::move(exactX);
+    fy = std::move(exactY);
+    fz = std::move(exactZ);
+    std::fill(quietSteps.begin(), quietSteps.end(), 0);
+    std::fill(asleep.begin(), asleep.end(), 0);
+    cacheValid = false;
+  }
+}
+
+template <std::size_t ClusterSize>
+std::size_t LennardJonesForceClusterPair<ClusterSize>::getSleepingClusters() const {
+  return static_cast<std::size_t>(std::count(asleep.begin(), asleep.end(), 1));
+}
+
+template <std::size_t ClusterSize>
+LennardJonesForceClusterPair<ClusterSize>::~LennardJonesForceClusterPair() {
+  if (sleepSettings and totalPairs > 0) {
+    SPDLOG_INFO("Sleeping clusters skipped {:.1f}% of the cluster pairs", 100.0 * getSkippedFraction());
+    if (sleepSettings->verifyPeriodically) {
+      SPDLOG_INFO("Largest force error of sleeping clusters found by the verifications: {}", largestVerifiedError);
+    }
+  }
+}
+
+template class LennardJonesForceClusterPair<4>;
+template class LennardJonesForceClusterPair<8>;
@@ -0,0 +1,25 @@
+#include "MixingTable.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+MixingTable::MixingTable(const double epsilon, const double sigma)
+    : MixingTable(std::vector<Species>{{epsilon, sigma}}) {}
+
+MixingTable::MixingTable(std::vector<Species> species) : numTypes(species.size()), species(std::move(species)) {
+  if (numTypes == 0) {
+    throw std::invalid_argument("A mixing table needs at least one species");
+  }
+  entries.resize(numTypes * numTypes);
+  for (std::size_t i = 0; i < numTypes; i++) {
+    for (std::size_t j = 0; j < numTypes; j++) {
+      const Species& si = this->species[i];
+      const Species& sj = this->species[j];
+      const double epsilon = i == j ? si.epsilon : std::sqrt(si.epsilon * sj.epsilon);
+      const double sigma = i == j ? si.sigma : (si.sigma + sj.sigma) / 2.0;
+      const double sigma2 = sigma * sigma;
+      entries[i * numTypes + j] = {24.0 * epsilon, sigma2 * sigma2 * sigma2};
+    }
+  }
+}
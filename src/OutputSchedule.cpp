@@ -0,0 +1,158 @@
+#include "OutputSchedule.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+OutputSchedule::~OutputSchedule() = default;
+
+void OutputSchedule::start(const ParticleContainer&) {}
+
+void OutputSchedule::written(const ParticleContainer&, double) {}
+
+IterationInterval::IterationInterval(const int iterations) : iterations(iterations) {
+  if (iterations <= 0) {
+    throw std::invalid_argument("Snapshots are written every positive number of iterations");
+  }
+}
+
+bool IterationInterval::isDue(const int iteration, double, const ParticleContainer&) {
+  return iteration % iterations == 0;
+}
+
+std::string IterationInterval::describe() const {
+  return "every " + std::to_string(iterations) + " iterations";
+}
+
+TimeInterval::TimeInterval(const double interval) : interval(interval) {
+  if (not(interval > 0)) {
+    throw std::invalid_argument("Snapshots are written every positive interval of simulated time");
+  }
+}
+
+bool TimeInterval::isDue(int, const double time, const ParticleContainer&) {
+  // the tolerance keeps rounding errors in the accumulated time from skipping a multiple
+  const auto multiple = static_cast<long>(std::floor(time / interval + 1e-9));
+  if (multiple <= lastMultiple) {
+    return false;
+  }
+  lastMultiple = multiple;
+  return true;
+}
+
+std::string TimeInterval::describe() const {
+  std::ostringstream description;
+  description << "every " << interval << " units of simulated time";
+  return description.str();
+}
+
+double WallTimeBudget::steadySeconds() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+WallTimeBudget::WallTimeBudget(const double percent, std::function<double()> clock)
+    : share(percent / 100.0), clock(std::move(clock)) {
+  if (not(percent > 0) or percent > 100) {
+    throw std::invalid_argument("The output budget is a share of the runtime between 0 and 100 percent");
+  }
+}
+
+void WallTimeBudget::start(const ParticleContainer&) {
+  startTime = clock();
+  outputSeconds = 0;
+  lastWriteSeconds = 0;
+}
+
+bool WallTimeBudget::isDue(int, double, const ParticleContainer&) {
+  const double elapsed = clock() - startTime;
+  return outputSeconds + lastWriteSeconds <= share * elapsed;
+}
+
+void WallTimeBudget::written(const ParticleContainer&, const double seconds) {
+  outputSeconds += seconds;
+  lastWriteSeconds = seconds;
+}
+
+std::string WallTimeBudget::describe() const {
+  std::ostringstream description;
+  description << "within " << 100.0 * share << "% of the runtime";
+  return description.str();
+}
+
+DisplacementTrigger::DisplacementTrigger(const double threshold, const std::array<double, 3> periodicSize)
+    : threshold(threshold), periodicSize(periodicSize) {
+  if (not(threshold > 0)) {
+    throw std::invalid_argument("Snapshots are written after a positive RMS displacement");
+  }
+}
+
+void DisplacementTrigger::remember(const ParticleContainer& particles) {
+  present.assign(present.size(), false);
+  for (const auto& p : particles) {
+    if (p.getId() >= reference.size()) {
+      reference.resize(p.getId() + 1);
+      present.resize(p.getId() + 1, false);
+    }
+    reference[p.getId()] = p.getX();
+    present[p.getId()] = true;
+  }
+}
+
+double DisplacementTrigger::rmsDisplacement(const ParticleContainer& particles) const {
+  double sum = 0;
+  std::size_t count = 0;
+  for (const auto& p : particles) {
+    if (p.getId() >= present.size() or not present[p.getId()]) {
+      continue;
+    }
+    const auto& x = p.getX();
+    const auto& x0 = reference[p.getId()];
+    for (std::size_t d = 0; d < 3; d++) {
+      double dx = x[d] - x0[d];
+      if (periodicSize[d] > 0) {
+        dx -= periodicSize[d] * std::round(dx / periodicSize[d]);
+      }
+      sum += dx * dx;
+    }
+    count++;
+  }
+  return count > 0 ? std::sqrt(sum / static_cast<double>(count)) : 0.0;
+}
+
+void DisplacementTrigger::start(const ParticleContainer& particles) {
+  remember(particles);
+}
+
+bool DisplacementTrigger::isDue(int, double, const ParticleContainer& particles) {
+  return rmsDisplacement(particles) > threshold;
+}
+
+void DisplacementTrigger::written(const ParticleContainer& particles, double) {
+  remember(particles);
+}
+
+std::string DisplacementTrigger::describe() const {
+  std::ostringstream description;
+  description << "after an RMS displacement of " << threshold;
+  return description.str();
+}
+
+std::unique_ptr<OutputSchedule> createOutputSchedule(const OutputScheduleSettings& settings) {
+  switch (settings.trigger) {
+    case OutputTrigger::TIME:
+      return std::make_unique<TimeInterval>(settings.value);
+    case OutputTrigger::WALL_TIME_BUDGET:
+      return std::make_unique<WallTimeBudget>(settings.value);
+    case OutputTrigger::DISPLACEMENT:
+      return std::make_unique<DisplacementTrigger>(settings.value, settings.periodicSize);
+    case OutputTrigger::ITERATIONS:
+    default:
+      if (settings.value != std::floor(settings.value) or settings.value > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("Snapshots are written every whole number of iterations");
+      }
+      return std::make_unique<IterationInterval>(static_cast<int>(settings.value));
+  }
+}
@@ -1,15 +1,55 @@
 #include "ParticleContainer.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 std::size_t ParticleContainer::size() const {
   return particles.size();
 }
 
-void ParticleContainer::addParticle(std::array<double, 3> x, std::array<double, 3> v, double m) {
-  particles.emplace_back(x, v, m);
+std::size_t ParticleContainer::capacity() const {
+  return particles.capacity();
+}
+
+void ParticleContainer::reserve(const std::size_t n) {
+  particles.reserve(n);
+}
+
+void ParticleContainer::addParticle(std::array<double, 3> x, std::array<double, 3> v, double m, int type) {
+  particles.emplace_back(x, v, m, type).setId(nextId++);
 }
 
 void ParticleContainer::addParticle(const Particle* p) {
-  particles.emplace_back(*p);
+  particles.emplace_back(*p).setId(nextId++);
+}
+
+void ParticleContainer::addParticles(const std::vector<Particle>& batch) {
+  particles.reserve(particles.size() + batch.size());
+  for (const auto& p : batch) {
+    particles.emplace_back(p).setId(nextId++);
+  }
+}
+
+void ParticleContainer::addHalos(const std::vector<Particle>& halos) {
+  particles.insert(particles.end(), halos.begin(), halos.end());
+}
+
+void ParticleContainer::removeParticle(const std::size_t index) {
+  if (index >= particles.size()) {
+    throw std::out_of_range("Cannot remove particle " + std::to_string(index) + " of " +
+                            std::to_string(particles.size()));
+  }
+  if (index != particles.size() - 1) {
+    particles[index] = std::move(particles.back());
+  }
+  particles.pop_back();
+}
+
+void ParticleContainer::truncate(const std::size_t first) {
+  if (first < particles.size()) {
+    particles.erase(particles.begin() + static_cast<std::ptrdiff_t>(first), particles.end());
+  }
 }
 
 ParticleContainer::iterator ParticleContainer::begin() {
@@ -35,3 +75,8 @@ Particle& ParticleContainer::operator[](std::size_t i) {
 const Particle& ParticleContainer::operator[](std::size_t i) const {
   return particles[i];
 }
+
+void ParticleContainer::sortByType() {
+  std::stable_sort(particles.begin(), particles.end(),
+                   [](const Particle& a, const Particle& b) { return a.getType() < b.getType(); });
+}
@@ -1,10 +1,19 @@
 #include "Simulation.h"
 
+#include "AutoTunedForce.h"
+#include "LennardJonesForceClusterPair.h"
 #include "io/FileReader.h"
+#include "io/PartitionedVTUWriter.h"
 #include "io/VTKWriter.h"
+#include "io/VTUWriter.h"
+#include "utils/MemoryStats.h"
+#include "utils/Trace.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
 #ifndef SPDLOG_ACTIVE_LEVEL
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
@@ -12,106 +21,333 @@
 #include "spdlog/spdlog.h"
 
 BaseSimulation::BaseSimulation(double end_time, double dt, SimulationMode simulationMode)
-    : end_time(end_time), dt(dt), simulationMode(simulationMode) {}
+    : end_time(end_time),
+      dt(dt),
+      integrator(std::make_unique<VelocityVerlet>()),
+      simulationMode(simulationMode),
+      outputSchedule(std::make_unique<IterationInterval>(10)) {}
 BaseSimulation::~BaseSimulation() = default;
 
-void BaseSimulation::plotParticles(const int iteration) const {
-  const std::string out_name("MD_vtk");
-  outputWriter::VTKWriter::plotParticles(*particles, out_name, iteration);
+void BaseSimulation::plotParticles(const int iteration) {
+  TRACE_SCOPE("plotParticles");
+  switch (outputFormat) {
+    case OutputFormat::VTU:
+      outputWriter::VTUWriter::plotParticles(*particles, "MD_vtu", iteration, outputDirectory);
+      break;
+    case OutputFormat::VTK: {
+      // SimulationOptions::parse rejects OUTPUT:vtk in builds without VTK
+#ifdef ENABLE_VTK_OUTPUT
+      const std::string out_name("MD_vtk");
+      outputWriter::VTKWriter::plotParticles(*particles, out_name, iteration, outputDirectory);
+#endif
+      break;
+    }
+    case OutputFormat::XYZ:
+      outputWriter::XYZWriter::plotParticles(*particles, "MD_xyz", iteration, outputDirectory);
+      break;
+    case OutputFormat::XYZ_TRAJECTORY:
+      if (not xyzWriter) {
+        xyzWriter = std::make_unique<outputWriter::XYZWriter>(outputDirectory + "/MD.xyz");
+      }
+      xyzWriter->appendFrame(*particles, iteration);
+      break;
+    case OutputFormat::COMPRESSED:
+      if (not compressedWriter) {
+        compressedWriter =
+            std::make_unique<outputWriter::CompressedWriter>(outputDirectory + "/MD.mdc", compressionSettings);
+        if (boundaryConditions) {
+          const BoundaryConfig& config = boundaryConditions->getConfig();
+          compressedWriter->setDomain(config.lowerCorner, config.upperCorner);
+        }
+      }
+      compressedWriter->plotParticles(*particles, iteration);
+      break;
+    case OutputFormat::PVTU:
+      outputWriter::PartitionedVTUWriter(outputPieces).plotParticles(*particles, "MD_vtu", iteration, outputDirectory);
+      break;
+    case OutputFormat::LIVE:
+      if (not liveWriter) {
+        // halos are not plotted and no particles are added during the run, outflow only removes particles
+        liveWriter = std::make_unique<outputWriter::SharedMemoryWriter>(streamName, particles->size());
+      }
+      liveWriter->publish(*particles, iteration);
+      break;
+  }
+}
+
+void BaseSimulation::analyse(const int iteration, const double time, const ForceObservables* forces) const {
+  if (analysis and analysis->isDue(iteration)) {
+    analysis->submit(iteration, time, *particles, forces);
+  }
+}
+
+void BaseSimulation::enableAnalysis(const int interval, const analysis::SeriesFormat format) {
+  analysisInterval = interval;
+  analysisFormat = format;
+}
+
+void BaseSimulation::setOutputDirectory(std::string directory) {
+  outputDirectory = std::move(directory);
+}
+
+void BaseSimulation::setOutputFormat(const OutputFormat format, const outputWriter::CompressionSettings settings,
+                                     const int pieces, std::string stream) {
+  outputFormat = format;
+  compressionSettings = settings;
+  outputPieces = pieces;
+  streamName = std::move(stream);
+}
+
+void BaseSimulation::setOutputSchedule(const OutputScheduleSettings& settings) {
+  outputSchedule = createOutputSchedule(settings);
+}
+
+void BaseSimulation::setIntegrator(const IntegrationScheme scheme) {
+  integrator = createIntegrator(scheme);
+}
+
+void BaseSimulation::step(ForceObservables* forces) const {
+  TRACE_SCOPE("step");
+  integrator->step(*particles, dt, [this, forces](const bool last) {
+    TRACE_SCOPE("calculateF");
+    if (boundaryConditions) {
+      boundaryConditions->applyAfterPositionUpdate(*particles);
+    }
+    // observables are only needed for the final positions of the step
+    if (forces and last) {
+      forces->ownedParticles = boundaryConditions ? boundaryConditions->getFirstHalo() : particles->size();
+      forceCalc->calculateF(*forces);
+    } else {
+      forceCalc->calculateF();
+    }
+    if (boundaryConditions) {
+      boundaryConditions->applyAfterForceUpdate(*particles);
+    }
+  });
+}
+
+void BaseSimulation::stepAndAnalyse(const int iteration, const double time) const {
+  if (analysis and analysis->isDue(iteration)) {
+    ForceObservables forces;
+    step(&forces);
+    analyse(iteration, time, &forces);
+  } else {
+    step();
+  }
 }
 
 // Simulation run methods
-void BaseSimulation::runFileOutput() const {
+void BaseSimulation::runFileOutput() {
   constexpr double start_time = 0;
 
   double current_time = start_time;
   int iteration = 0;
+  analyse(iteration, current_time);
+  outputSchedule->start(*particles);
+  SPDLOG_DEBUG("Writing snapshots {}", outputSchedule->describe());
+  int frames = 0;
 
   // for this loop, we assume: current x, current f and current v are known
   while (current_time < end_time) {
-    // calculate new x
-    forceCalc->calculateX(dt);
-    for (auto& p : *particles) {
-      p.setOldF(p.getF());  // store f(t_n) for v update
-    }
-    // calculate new f
-    forceCalc->calculateF();
-    // calculate new v
-    forceCalc->calculateV(dt);
-
     iteration++;
-    if (iteration % 10 == 0) {
+    current_time += dt;
+    stepAndAnalyse(iteration, current_time);
+
+    if (outputSchedule->isDue(iteration, current_time, *particles)) {
+      const auto writeStart = std::chrono::steady_clock::now();
       plotParticles(iteration);
+      outputSchedule->written(*particles,
+                              std::chrono::duration<double>(std::chrono::steady_clock::now() - writeStart).count());
+      frames++;
     }
-    current_time += dt;
   }
+  SPDLOG_INFO("Wrote {} snapshots of {} iterations", frames, iteration);
 }
 
-void BaseSimulation::runBenchmark() const {
+void BaseSimulation::runBenchmark() {
   using namespace std::chrono;
+  utils::MemoryStatsRecorder memoryStats;
+
+  // particle generation is where the particle storage is first touched
+  memoryStats.start();
+  setupSimulation();
+  const utils::MemoryStats setupStats = memoryStats.stop();
+
   // used for benchmark
+  memoryStats.start();
   const auto chronoStart = steady_clock::now();
 
   // Benchmark begin
   constexpr double start_time = 0;
   double current_time = start_time;
+  int iteration = 0;
+  analyse(iteration, current_time);
 
   // For this loop, we assume current x, current F and current v are known
   while (current_time < end_time) {
-    // Calculate the new positions of the particles
-    forceCalc->calculateX(dt);
-    for (auto& p : *particles) {
-      p.setOldF(p.getF());  // store F(t_n) for v update
-    }
-    // Calculate new forces and velocities
-    forceCalc->calculateF();
-    forceCalc->calculateV(dt);
-
+    iteration++;
     current_time += dt;
+    stepAndAnalyse(iteration, current_time);
   }
 
   const auto chronoEnd = steady_clock::now();
+  const utils::MemoryStats runStats = memoryStats.stop();
   const auto elapsed = duration_cast<duration<double>>(chronoEnd - chronoStart);
-  spdlog::set_level(spdlog::level::info);
-  SPDLOG_INFO("Time elapsed: {} s", elapsed.count());
-  spdlog::set_level(spdlog::level::off);
+  // the summary is shown at any log level, without changing the global level that concurrent ensemble members share
+  const auto summary = spdlog::default_logger()->clone(spdlog::default_logger()->name());
+  summary->set_level(spdlog::level::info);
+  SPDLOG_LOGGER_INFO(summary, "Time elapsed: {} s", elapsed.count());
+  SPDLOG_LOGGER_INFO(summary, "Setup: {} minor / {} major page faults, {} dTLB load misses",
+                     setupStats.minorPageFaults, setupStats.majorPageFaults, setupStats.dtlbLoadMisses);
+  SPDLOG_LOGGER_INFO(summary, "Simulation: {} minor / {} major page faults, {} dTLB load misses",
+                     runStats.minorPageFaults, runStats.majorPageFaults, runStats.dtlbLoadMisses);
+  SPDLOG_LOGGER_INFO(summary, "Anonymous memory backed by huge pages: {} kB", runStats.anonHugePagesKB);
 }
 
 void BaseSimulation::run() {
-  setupSimulation();
-
   if (simulationMode == SimulationMode::FILE_OUTPUT) {
+    setupSimulation();
     runFileOutput();
   } else if (simulationMode == SimulationMode::BENCHMARK) {
     runBenchmark();
   }
+  if (analysis) {
+    analysis->finish();
+  }
 }
 
 // CollisionSimulation definitions
 CollisionSimulation::CollisionSimulation(std::string inputFilename, double end_time, double dt,
-                                         const SimulationMode simulationMode)
-    : BaseSimulation(end_time, dt, simulationMode), inputFilename(std::move(inputFilename)) {
+                                         const SimulationMode simulationMode,
+                                         std::optional<BoundaryConfig> boundaryConfig, const bool sortByType)
+    : BaseSimulation(end_time, dt, simulationMode),
+      inputFilename(std::move(inputFilename)),
+      boundaryConfig(std::move(boundaryConfig)),
+      sortByType(sortByType) {
   particles = std::make_unique<ParticleContainer>();
-  constexpr double sigma = 1.0;
-  constexpr double cutoffRadius = 2.5 * sigma;
-  forceCalc = std::make_unique<LennardJonesForce>(*particles, 5.0, sigma, cutoffRadius);
 }
 
 void CollisionSimulation::setupSimulation() {
   CuboidFileReader reader(inputFilename);
-  reader.readFile(*particles);
+  if (initialStateCache) {
+    reader.readFile(*particles, *initialStateCache);
+  } else {
+    reader.readFile(*particles);
+  }
+  if (sortByType) {
+    particles->sortByType();
+  }
+
+  constexpr Species defaultSpecies{5.0, 1.0};
+  const std::vector<Species> species = reader.getSpecies(defaultSpecies);
+  double maxSigma = 0;
+  for (const auto& s : species) {
+    maxSigma = std::max(maxSigma, s.sigma);
+  }
+  const double cutoffRadius = 2.5 * maxSigma;
+  SPDLOG_DEBUG("Loaded {} particles of {} types, cutoff radius {}", particles->size(), species.size(), cutoffRadius);
+
+  MixingTable mixing(species);
+  if (analysisInterval > 0) {
+    // pressure and density refer to the domain if there is one
+    std::optional<std::array<double, 3>> domainSize;
+    if (boundaryConfig) {
+      domainSize.emplace();
+      for (std::size_t d = 0; d < 3; d++) {
+        (*domainSize)[d] = boundaryConfig->upperCorner[d] - boundaryConfig->lowerCorner[d];
+      }
+    }
+    analysis = std::make_unique<analysis::AnalysisPipeline>(outputDirectory, analysisInterval, analysisFormat);
+    analysis->addObservable(std::make_unique<analysis::KineticEnergy>());
+    analysis->addObservable(std::make_unique<analysis::PotentialEnergy>(mixing, cutoffRadius));
+    analysis->addObservable(std::make_unique<analysis::Temperature>(reader.getDimensions()));
+    analysis->addObservable(std::make_unique<analysis::Momentum>());
+    analysis->addObservable(std::make_unique<analysis::Pressure>(reader.getDimensions(), domainSize));
+    analysis->addObservable(
+        std::make_unique<analysis::RadialDistribution>(cutoffRadius, 50, reader.getDimensions(), domainSize));
+  }
+  if (boundaryConfig) {
+    const Species& wall = mixing.getSpecies(0);
+    boundaryConditions =
+        std::make_unique<BoundaryConditions>(*boundaryConfig, wall.epsilon, wall.sigma, cutoffRadius);
+  }
+  forceCalc = createForceCalc(std::move(mixing), cutoffRadius);
+
+  // periodic z faces place halo copies above and below the plane, which only the 3D kernels tell apart
+  const bool periodicZ = boundaryConfig and boundaryConfig->faces[4] == BoundaryType::PERIODIC;
+  forceCalc->setDimensions(periodicZ ? 3 : reader.getDimensions());
+  integrator->setDimensions(forceCalc->getDimensions());
+  SPDLOG_DEBUG("Integrating with {} and calculating forces in {} dimensions", integrator->name(),
+               forceCalc->getDimensions());
 }
 
-CollisionSimulationParallel::CollisionSimulationParallel(std::string inputFilename, double end_time, double dt,
-                                                         const SimulationMode simulationMode)
-    : BaseSimulation(end_time, dt, simulationMode), inputFilename(std::move(inputFilename)) {
-  particles = std::make_unique<ParticleContainer>();
-  constexpr double sigma = 1.0;
-  constexpr double cutoffRadius = 2.5 * sigma;
-  forceCalc = std::make_unique<LennardJonesForceParallel>(*particles, 5.0, sigma, cutoffRadius);
+void CollisionSimulation::setClusterSize(const std::size_t size) {
+  if (size != 0 and size != 4 and size != 8) {
+    throw std::invalid_argument("Clusters of the cluster pair force calculation hold 4 or 8 particles");
+  }
+  clusterSize = size;
 }
 
-void CollisionSimulationParallel::setupSimulation() {
-  CuboidFileReader reader(inputFilename);
-  reader.readFile(*particles);
+void CollisionSimulation::setSleeping(std::optional<SleepSettings> settings) {
+  sleepSettings = settings;
+}
+
+void CollisionSimulation::setInitialStateCache(std::optional<InitialStateCache> cache) {
+  initialStateCache = std::move(cache);
+}
+
+namespace {
+template <std::size_t ClusterSize>
+std::unique_ptr<ForceCalc> makeClusterPairForce(ParticleContainer& particles, const MixingTable& mixing,
+                                                const double cutoffRadius,
+                                                const std::optional<SleepSettings>& sleepSettings) {
+  auto force = std::make_unique<LennardJonesForceClusterPair<ClusterSize>>(particles, mixing, cutoffRadius);
+  if (sleepSettings) {
+    force->enableSleeping(*sleepSettings);
+  }
+  return force;
+}
+}  // namespace
+
+std::unique_ptr<ForceCalc> CollisionSimulation::createForceCalc(MixingTable mixing, const double cutoffRadius) {
+  switch (clusterSize) {
+    case 4:
+      return makeClusterPairForce<4>(*particles, mixing, cutoffRadius, sleepSettings);
+    case 8:
+      return makeClusterPairForce<8>(*particles, mixing, cutoffRadius, sleepSettings);
+    default:
+      return std::make_unique<LennardJonesForce>(*particles, std::move(mixing), cutoffRadius);
+  }
+}
+
+void CollisionSimulationParallel::setSchedule(const Schedule newSchedule) {
+  schedule = newSchedule;
+}
+
+std::unique_ptr<ForceCalc> CollisionSimulationParallel::createForceCalc(MixingTable mixing,
+                                                                       const double cutoffRadius) {
+  return std::make_unique<LennardJonesForceParallel>(*particles, std::move(mixing), cutoffRadius, schedule);
+}
+
+void CollisionSimulationAutoTuned::setRetuneInterval(const std::size_t interval) {
+  retuneInterval = interval;
+}
+
+std::unique_ptr<ForceCalc> CollisionSimulationAutoTuned::createForceCalc(MixingTable mixing,
+                                                                        const double cutoffRadius) {
+  std::vector<AutoTunedForce::Candidate> candidates;
+  candidates.push_back({"P:OFF", std::make_unique<LennardJonesForce>(*particles, mixing, cutoffRadius)});
+  candidates.push_back(
+      {"P:OFF CLUSTER:4", std::make_unique<LennardJonesForceClusterPair<4>>(*particles, mixing, cutoffRadius)});
+  candidates.push_back({"P:ON SCHEDULE:GUIDED", std::make_unique<LennardJonesForceParallel>(
+                                                    *particles, mixing, cutoffRadius, Schedule::GUIDED)});
+  candidates.push_back({"P:ON SCHEDULE:STEAL", std::make_unique<LennardJonesForceParallel>(
+                                                   *particles, mixing, cutoffRadius, Schedule::WORK_STEALING)});
+  candidates.push_back({"P:DET", std::make_unique<LennardJonesForceDeterministic>(*particles, mixing, cutoffRadius)});
+  return std::make_unique<AutoTunedForce>(*particles, std::move(candidates), retuneInterval);
+}
+
+std::unique_ptr<ForceCalc> CollisionSimulationDeterministic::createForceCalc(MixingTable mixing,
+                                                                            const double cutoffRadius) {
+  return std::make_unique<LennardJonesForceDeterministic>(*particles, std::move(mixing), cutoffRadius);
 }
@@ -0,0 +1,270 @@
+#include "SimulationOptions.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+SimulationOptions SimulationOptions::parse(const std::vector<std::string>& arguments) {
+  SimulationOptions options;
+  std::string boundaryFaces;
+  std::string domain;
+  for (const auto& option : arguments) {
+    if (option == "P:OFF") {
+      options.parallelization = Parallelization::OFF;
+    } else if (option == "P:ON") {
+      options.parallelization = Parallelization::ON;
+    } else if (option == "P:DET") {
+      options.parallelization = Parallelization::DETERMINISTIC;
+    } else if (option == "P:AUTO") {
+      options.parallelization = Parallelization::AUTO;
+    } else if (option.rfind("AUTOTUNE:", 0) == 0) {
+      long interval = 0;
+      try {
+        interval = std::stol(option.substr(9));
+      } catch (const std::logic_error&) {
+        interval = 0;
+      }
+      // every trial measures 5 candidates in 3 steps each
+      if (interval < 15) {
+        throw std::invalid_argument("Invalid autotuning interval in " + option + ", expected at least 15 steps");
+      }
+      options.retuneInterval = static_cast<std::size_t>(interval);
+    } else if (option.rfind("BC:", 0) == 0) {
+      boundaryFaces = option.substr(3);
+    } else if (option.rfind("DOMAIN:", 0) == 0) {
+      domain = option.substr(7);
+    } else if (option == "SORT:TYPE") {
+      options.sortByType = true;
+    } else if (option.rfind("CACHE:", 0) == 0) {
+      // CACHE:<directory>[,refresh]
+      std::string directory = option.substr(6);
+      const std::size_t comma = directory.rfind(',');
+      options.refreshCache = comma != std::string::npos and directory.substr(comma + 1) == "refresh";
+      if (options.refreshCache) {
+        directory.erase(comma);
+      }
+      if (directory.empty()) {
+        throw std::invalid_argument("Invalid cache option " + option + ", expected CACHE:<directory>[,refresh]");
+      }
+      options.cacheDirectory = directory;
+    } else if (option.rfind("ANALYSIS:", 0) == 0) {
+      // ANALYSIS:<interval>[,csv|,bin]
+      const std::string value = option.substr(9);
+      const std::size_t comma = value.find(',');
+      int interval = 0;
+      try {
+        interval = std::stoi(value.substr(0, comma));
+      } catch (const std::logic_error&) {
+        interval = 0;
+      }
+      const std::string format = comma == std::string::npos ? "csv" : value.substr(comma + 1);
+      if (interval <= 0 or (format != "csv" and format != "bin")) {
+        throw std::invalid_argument("Invalid analysis option " + option +
+                                    ", expected ANALYSIS:<interval>[,csv|,bin]");
+      }
+      options.analysisInterval = interval;
+      options.analysisFormat = format == "bin" ? analysis::SeriesFormat::BINARY : analysis::SeriesFormat::CSV;
+    } else if (option == "CLUSTER:4") {
+      options.clusterSize = 4;
+    } else if (option == "CLUSTER:8") {
+      options.clusterSize = 8;
+    } else if (option.rfind("SLEEP:", 0) == 0) {
+      // SLEEP:<quiet steps>[,<displacement>,<force change>][,verify][,strict]
+      std::vector<std::string> values;
+      std::stringstream stream(option.substr(6));
+      for (std::string value; std::getline(stream, value, ',');) {
+        values.push_back(value);
+      }
+      SleepSettings settings;
+      settings.strict = not values.empty() and values.back() == "strict";
+      if (settings.strict) {
+        values.pop_back();
+      }
+      settings.verifyPeriodically = not values.empty() and values.back() == "verify";
+      if (settings.verifyPeriodically) {
+        values.pop_back();
+      }
+      bool valid = values.size() == 1 or values.size() == 3;
+      try {
+        const long quietSteps = valid ? std::stol(values[0]) : 0;
+        settings.quietSteps = static_cast<std::size_t>(std::max(quietSteps, 0L));
+        if (values.size() == 3) {
+          settings.displacementTolerance = std::stod(values[1]);
+          settings.forceTolerance = std::stod(values[2]);
+        }
+      } catch (const std::logic_error&) {
+        valid = false;
+      }
+      if (not valid or settings.quietSteps == 0 or not(settings.displacementTolerance > 0) or
+          not(settings.forceTolerance > 0)) {
+        throw std::invalid_argument("Invalid sleep option " + option +
+                                    ", expected SLEEP:<quiet steps>[,<displacement>,<force change>][,verify][,strict]");
+      }
+      options.sleepSettings = settings;
+    } else if (option == "INTEGRATOR:VERLET") {
+      options.integrator = IntegrationScheme::VERLET;
+    } else if (option == "INTEGRATOR:FOREST_RUTH") {
+      options.integrator = IntegrationScheme::FOREST_RUTH;
+    } else if (option == "SCHEDULE:GUIDED") {
+      options.schedule = Schedule::GUIDED;
+    } else if (option == "SCHEDULE:STEAL") {
+      options.schedule = Schedule::WORK_STEALING;
+    } else if (option.rfind("FRAMES:", 0) == 0) {
+      // FRAMES:iterations,<n>|time,<interval>|budget,<percent>|change,<rms displacement>
+      const std::string value = option.substr(7);
+      const std::size_t comma = value.find(',');
+      const std::string policy = value.substr(0, comma);
+      const std::map<std::string, OutputTrigger> triggers{{"iterations", OutputTrigger::ITERATIONS},
+                                                          {"time", OutputTrigger::TIME},
+                                                          {"budget", OutputTrigger::WALL_TIME_BUDGET},
+                                                          {"change", OutputTrigger::DISPLACEMENT}};
+      OutputScheduleSettings settings;
+      bool valid = comma != std::string::npos and triggers.count(policy) > 0;
+      try {
+        settings.trigger = valid ? triggers.at(policy) : settings.trigger;
+        settings.value = valid ? std::stod(value.substr(comma + 1)) : settings.value;
+        createOutputSchedule(settings);
+      } catch (const std::logic_error&) {
+        valid = false;
+      }
+      if (not valid) {
+        throw std::invalid_argument("Invalid frame option " + option +
+                                    ", expected FRAMES:iterations,<n>|time,<interval>|budget,<percent>|change,<rms>");
+      }
+      options.outputSchedule = settings;
+    } else if (option.rfind("OUTPUT:", 0) == 0) {
+      // OUTPUT:vtu|vtk|xyz[,single]|compressed[,<position precision>]|pvtu[,<pieces>]|live[,<name>]
+      const std::string value = option.substr(7);
+      const std::size_t comma = value.find(',');
+      const std::string format = value.substr(0, comma);
+      if (format == "vtu" and comma == std::string::npos) {
+        options.outputFormat = OutputFormat::VTU;
+      } else if (format == "vtk" and comma == std::string::npos) {
+#ifdef ENABLE_VTK_OUTPUT
+        options.outputFormat = OutputFormat::VTK;
+#else
+        throw std::invalid_argument("OUTPUT:vtk is not available, the build lacks VTK (-DENABLE_VTK_OUTPUT=ON)");
+#endif
+      } else if (format == "xyz" and comma == std::string::npos) {
+        options.outputFormat = OutputFormat::XYZ;
+      } else if (format == "xyz" and value.substr(comma + 1) == "single") {
+        options.outputFormat = OutputFormat::XYZ_TRAJECTORY;
+      } else if (format == "compressed") {
+        options.outputFormat = OutputFormat::COMPRESSED;
+        if (comma != std::string::npos) {
+          double precision = 0;
+          try {
+            precision = std::stod(value.substr(comma + 1));
+          } catch (const std::logic_error&) {
+            precision = 0;
+          }
+          if (not(precision > 0 and precision < 1)) {
+            throw std::invalid_argument("Invalid output precision in " + option + ", expected a value in (0, 1)");
+          }
+          options.compressionSettings.positionPrecision = precision;
+        }
+      } else if (format == "pvtu") {
+        options.outputFormat = OutputFormat::PVTU;
+        if (comma != std::string::npos) {
+          int pieces = 0;
+          try {
+            pieces = std::stoi(value.substr(comma + 1));
+          } catch (const std::logic_error&) {
+            pieces = 0;
+          }
+          if (pieces <= 0) {
+            throw std::invalid_argument("Invalid number of pieces in " + option + ", expected a positive number");
+          }
+          options.outputPieces = pieces;
+        }
+      } else if (format == "live") {
+        options.outputFormat = OutputFormat::LIVE;
+        if (comma != std::string::npos) {
+          const std::string name = value.substr(comma + 1);
+          const bool valid = not name.empty() and std::all_of(name.begin(), name.end(), [](const char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) or c == '_' or c == '-' or c == '.';
+          });
+          if (not valid) {
+            throw std::invalid_argument("Invalid stream name in " + option +
+                                        ", expected letters, digits, '_', '-' and '.'");
+          }
+          options.streamName = name;
+        }
+      } else {
+        throw std::invalid_argument(
+            "Invalid output option " + option +
+            ", expected OUTPUT:vtu|vtk|xyz[,single]|compressed[,<precision>]|pvtu[,<pieces>]|live[,<name>]");
+      }
+    } else {
+      throw std::invalid_argument("Invalid option: " + option);
+    }
+  }
+
+  if (options.clusterSize > 0 and options.parallelization != Parallelization::OFF) {
+    throw std::invalid_argument("CLUSTER:4 and CLUSTER:8 are only available with P:OFF");
+  }
+  if (options.sleepSettings and options.clusterSize == 0) {
+    throw std::invalid_argument("SLEEP requires CLUSTER:4 or CLUSTER:8, whose clusters are the sleeping regions");
+  }
+  if (not boundaryFaces.empty() or not domain.empty()) {
+    if (boundaryFaces.empty() or domain.empty()) {
+      throw std::invalid_argument("Boundary conditions require both BC:<faces> and DOMAIN:<x0,y0,z0,x1,y1,z1>");
+    }
+    try {
+      options.boundaryConfig = BoundaryConfig::parse(boundaryFaces, domain);
+    } catch (const std::invalid_argument& err) {
+      throw std::invalid_argument(std::string("Invalid boundary configuration: ") + err.what());
+    }
+    for (std::size_t d = 0; d < 3; d++) {
+      if (options.boundaryConfig->faces[2 * d] == BoundaryType::PERIODIC) {
+        options.outputSchedule.periodicSize[d] =
+            options.boundaryConfig->upperCorner[d] - options.boundaryConfig->lowerCorner[d];
+      }
+    }
+  }
+  return options;
+}
+
+std::unique_ptr<CollisionSimulation> SimulationOptions::createSimulation(const std::string& inputFilename,
+                                                                         const double end_time, const double dt,
+                                                                         const SimulationMode simulationMode) const {
+  std::unique_ptr<CollisionSimulation> simulation;
+  switch (parallelization) {
+    case Parallelization::OFF:
+      simulation = std::make_unique<CollisionSimulation>(inputFilename, end_time, dt, simulationMode, boundaryConfig,
+                                                         sortByType);
+      simulation->setClusterSize(clusterSize);
+      simulation->setSleeping(sleepSettings);
+      break;
+    case Parallelization::ON: {
+      auto parallel = std::make_unique<CollisionSimulationParallel>(inputFilename, end_time, dt, simulationMode,
+                                                                    boundaryConfig, sortByType);
+      parallel->setSchedule(schedule);
+      simulation = std::move(parallel);
+      break;
+    }
+    case Parallelization::AUTO: {
+      auto autoTuned = std::make_unique<CollisionSimulationAutoTuned>(inputFilename, end_time, dt, simulationMode,
+                                                                      boundaryConfig, sortByType);
+      autoTuned->setRetuneInterval(retuneInterval);
+      simulation = std::move(autoTuned);
+      break;
+    }
+    case Parallelization::DETERMINISTIC:
+      simulation = std::make_unique<CollisionSimulationDeterministic>(inputFilename, end_time, dt, simulationMode,
+                                                                      boundaryConfig, sortByType);
+      break;
+  }
+  if (analysisInterval > 0) {
+    simulation->enableAnalysis(analysisInterval, analysisFormat);
+  }
+  simulation->setOutputFormat(outputFormat, compressionSettings, outputPieces, streamName);
+  simulation->setIntegrator(integrator);
+  simulation->setOutputSchedule(outputSchedule);
+  if (not cacheDirectory.empty()) {
+    simulation->setInitialStateCache(InitialStateCache(cacheDirectory, refreshCache));
+  }
+  return simulation;
+}
@@ -0,0 +1,86 @@
+#include "TabulatedForce.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+TabulatedForce::TabulatedForce(ParticleContainer& particles, std::function<double(double)> forceFactor,
+                               const double minRadius, const double cutoffRadius, const std::size_t tableSize,
+                               const Interpolation interpolation)
+    : ForceCalc(particles),
+      forceFactor(std::move(forceFactor)),
+      r2Min(minRadius * minRadius),
+      r2Cutoff(cutoffRadius * cutoffRadius),
+      interpolation(interpolation),
+      invSpacing(0) {
+  if (tableSize < 2 or minRadius <= 0 or minRadius >= cutoffRadius) {
+    throw std::invalid_argument("Tabulated force requires at least 2 points and 0 < minRadius < cutoffRadius");
+  }
+  const double spacing = (r2Cutoff - r2Min) / static_cast<double>(tableSize - 1);
+  invSpacing = 1.0 / spacing;
+
+  table.resize(tableSize + 3);
+  for (std::size_t i = 1; i < table.size(); i++) {
+    table[i] = this->forceFactor(r2Min + static_cast<double>(i - 1) * spacing);
+  }
+  // the point in front of r2Min may lie at a non-positive distance, extrapolate linearly instead
+  table[0] = r2Min > spacing ? this->forceFactor(r2Min - spacing) : 2 * table[1] - table[2];
+  SPDLOG_DEBUG("Tabulated force with {} points between r = {} and r = {}", tableSize, minRadius, cutoffRadius);
+}
+
+double TabulatedForce::interpolate(const double r2) const {
+  const double u = (r2 - r2Min) * invSpacing;
+  const auto k = static_cast<std::size_t>(u);
+  const double t = u - static_cast<double>(k);
+  // grid point k is stored at index k + 1
+  const double* p = &table[k];
+  if (interpolation == Interpolation::LINEAR) {
+    return p[1] + t * (p[2] - p[1]);
+  }
+  // Catmull-Rom spline through p[0], p[1], p[2], p[3] evaluated between p[1] and p[2]
+  return p[1] + 0.5 * t *
+                    ((p[2] - p[0]) +
+                     t * ((2.0 * p[0] - 5.0 * p[1] + 4.0 * p[2] - p[3]) + t * (3.0 * (p[1] - p[2]) + p[3] - p[0])));
+}
+
+void TabulatedForce::calculateF() {
+  for (auto& p : particles) {
+    p.setF({});
+  }
+
+  const size_t n_particles = particles.size();
+  for (size_t i = 0; i < n_particles; ++i) {
+    // index offset for Newton's third law
+    for (size_t j = i + 1; j < n_particles; ++j) {
+      auto& p_i = particles[i];
+      auto& p_j = particles[j];
+
+      const auto& x_i = p_i.getX();
+      const auto& x_j = p_j.getX();
+      const std::array<double, 3> dist = {x_j[0] - x_i[0], x_j[1] - x_i[1], x_j[2] - x_i[2]};
+      const double r2 = dist[0] * dist[0] + dist[1] * dist[1] + dist[2] * dist[2];
+      if (r2 == 0) {
+        // avoid division by zero
+        SPDLOG_ERROR(
+            "Calculated a zero norm between particles. This is likely caused "
+            "by an incorrect initialization of the Simulation.");
+        throw std::overflow_error(
+            "Calculated a zero norm between particles. This is likely caused "
+            "by an incorrect initialization of the Simulation.");
+      } else if (r2 >= r2Cutoff) {
+        continue;
+      }
+      const double factor = r2 < r2Min ? forceFactor(r2) : interpolate(r2);
+
+      // apply forces using Newton's third law
+      auto& F_i = p_i.getF();
+      auto& F_j = p_j.getF();
+      for (std::size_t d = 0; d < 3; d++) {
+        F_i[d] += factor * dist[d];
+        F_j[d] -= factor * dist[d];
+      }
+    }
+  }
+}
@@ -0,0 +1,126 @@
+#include "analysis/AnalysisPipeline.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace analysis {
+
+AnalysisPipeline::AnalysisPipeline(std::string outputDirectory, const int interval, const SeriesFormat format)
+    : outputDirectory(std::move(outputDirectory)), interval(interval), format(format) {
+  if (interval <= 0) {
+    throw std::invalid_argument("The analysis interval must be positive");
+  }
+}
+
+AnalysisPipeline::~AnalysisPipeline() {
+  finish();
+}
+
+void AnalysisPipeline::addObservable(std::unique_ptr<Observable> observable) {
+  if (worker.joinable()) {
+    throw std::logic_error("Observables must be registered before the first snapshot");
+  }
+  observables.push_back(std::move(observable));
+}
+
+void AnalysisPipeline::openOutputs() {
+  try {
+    std::filesystem::create_directories(outputDirectory);
+  } catch (const std::filesystem::filesystem_error& err) {
+    SPDLOG_ERROR("Error while creating directory {}:{}", outputDirectory, err.what());
+  }
+
+  for (const auto& observable : observables) {
+    const std::string stem = outputDirectory + "/" + observable->name();
+    std::string header = "iteration,time";
+    for (const auto& column : observable->columns()) {
+      header += "," + column;
+    }
+
+    if (format == SeriesFormat::CSV) {
+      outputs.emplace_back(stem + ".csv");
+      outputs.back() << header << '\n';
+    } else {
+      std::ofstream(stem + ".header") << header << '\n';
+      outputs.emplace_back(stem + ".bin", std::ios::binary);
+    }
+    if (not outputs.back()) {
+      SPDLOG_ERROR("Could not open the output file for observable {}", observable->name());
+    }
+  }
+}
+
+void AnalysisPipeline::submit(const int iteration, const double time, const ParticleContainer& particles,
+                              const ForceObservables* forces) {
+  if (observables.empty()) {
+    return;
+  }
+  if (not worker.joinable()) {
+    openOutputs();
+    worker = std::thread(&AnalysisPipeline::workerLoop, this);
+  }
+
+  Snapshot snapshot{iteration, time, std::vector<Particle>(particles.begin(), particles.end()),
+                    forces ? *forces : ForceObservables{}};
+  std::unique_lock lock(mutex);
+  queueChanged.wait(lock, [this] { return queue.size() < maxQueued; });
+  queue.push_back(std::move(snapshot));
+  lock.unlock();
+  queueChanged.notify_all();
+}
+
+void AnalysisPipeline::process(const Snapshot& snapshot) {
+  for (std::size_t i = 0; i < observables.size(); i++) {
+    const std::vector<double> values = observables[i]->evaluate(snapshot);
+    auto& out = outputs[i];
+    if (format == SeriesFormat::CSV) {
+      out << snapshot.iteration << ',' << snapshot.time;
+      for (const double value : values) {
+        out << ',' << value;
+      }
+      out << '\n';
+    } else {
+      const double prefix[2] = {static_cast<double>(snapshot.iteration), snapshot.time};
+      out.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+      out.write(reinterpret_cast<const char*>(values.data()),
+                static_cast<std::streamsize>(values.size() * sizeof(double)));
+    }
+  }
+  SPDLOG_TRACE("Analysed iteration {}", snapshot.iteration);
+}
+
+void AnalysisPipeline::workerLoop() {
+  while (true) {
+    std::unique_lock lock(mutex);
+    queueChanged.wait(lock, [this] { return stopping or not queue.empty(); });
+    if (queue.empty()) {
+      return;
+    }
+    Snapshot snapshot = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    queueChanged.notify_all();
+
+    process(snapshot);
+  }
+}
+
+void AnalysisPipeline::finish() {
+  if (not worker.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  queueChanged.notify_all();
+  worker.join();
+  for (auto& out : outputs) {
+    out.flush();
+  }
+}
+
+}  // namespace analysis
@@ -0,0 +1,191 @@
+#include "analysis/Observables.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+namespace analysis {
+
+Observable::~Observable() = default;
+
+namespace {
+double kineticEnergy(const std::vector<Particle>& particles) {
+  double energy = 0;
+  for (const auto& p : particles) {
+    const auto& v = p.getV();
+    energy += 0.5 * p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  }
+  return energy;
+}
+
+/**
+ * @brief Volume (area in 2D) of the domain if given, otherwise of the bounding box of the particles with each extent
+ * being at least minExtent
+ */
+double systemVolume(const std::vector<Particle>& particles, const int dimensions,
+                    const std::optional<std::array<double, 3>>& domainSize, const double minExtent) {
+  if (domainSize) {
+    double volume = 1.0;
+    for (int d = 0; d < dimensions; d++) {
+      volume *= (*domainSize)[d];
+    }
+    return volume;
+  }
+  std::array<double, 3> lower;
+  std::array<double, 3> upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+  for (const auto& p : particles) {
+    for (std::size_t d = 0; d < 3; d++) {
+      lower[d] = std::min(lower[d], p.getX()[d]);
+      upper[d] = std::max(upper[d], p.getX()[d]);
+    }
+  }
+  double volume = 1.0;
+  for (int d = 0; d < dimensions; d++) {
+    volume *= std::max(upper[d] - lower[d], minExtent);
+  }
+  return volume;
+}
+}  // namespace
+
+std::vector<double> KineticEnergy::evaluate(const Snapshot& snapshot) {
+  return {kineticEnergy(snapshot.particles)};
+}
+
+PotentialEnergy::PotentialEnergy(MixingTable mixing, const double cutoffRadius)
+    : mixing(std::move(mixing)), cutoffRadius(cutoffRadius) {}
+
+std::vector<double> PotentialEnergy::evaluate(const Snapshot& snapshot) {
+  if (snapshot.forces.valid) {
+    return {snapshot.forces.potentialEnergy};
+  }
+  const auto& particles = snapshot.particles;
+  const double cutoff2 = cutoffRadius * cutoffRadius;
+  double energy = 0;
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    const auto& x_i = particles[i].getX();
+    for (std::size_t j = i + 1; j < particles.size(); j++) {
+      const auto& x_j = particles[j].getX();
+      const double dx = x_j[0] - x_i[0];
+      const double dy = x_j[1] - x_i[1];
+      const double dz = x_j[2] - x_i[2];
+      const double r2 = dx * dx + dy * dy + dz * dz;
+      if (r2 >= cutoff2 or r2 == 0) {
+        continue;
+      }
+      const auto& params = mixing(particles[i].getType(), particles[j].getType());
+      const double inv_r2 = 1.0 / r2;
+      const double sigma_r6 = params.sigma6 * inv_r2 * inv_r2 * inv_r2;
+      // 4 epsilon = epsilon24 / 6
+      energy += params.epsilon24 / 6.0 * (sigma_r6 * sigma_r6 - sigma_r6);
+    }
+  }
+  return {energy};
+}
+
+Temperature::Temperature(const int dimensions) : dimensions(dimensions) {}
+
+std::vector<double> Temperature::evaluate(const Snapshot& snapshot) {
+  if (snapshot.particles.empty()) {
+    return {0.0};
+  }
+  return {2.0 * kineticEnergy(snapshot.particles) / (dimensions * static_cast<double>(snapshot.particles.size()))};
+}
+
+std::vector<double> Momentum::evaluate(const Snapshot& snapshot) {
+  std::vector<double> momentum(3, 0.0);
+  for (const auto& p : snapshot.particles) {
+    for (std::size_t d = 0; d < 3; d++) {
+      momentum[d] += p.getM() * p.getV()[d];
+    }
+  }
+  return momentum;
+}
+
+Pressure::Pressure(const int dimensions, std::optional<std::array<double, 3>> domainSize)
+    : dimensions(dimensions), domainSize(domainSize) {}
+
+std::vector<std::string> Pressure::columns() const {
+  std::vector<std::string> names{"P"};
+  for (const char a : {'x', 'y', 'z'}) {
+    for (const char b : {'x', 'y', 'z'}) {
+      names.push_back(std::string("W_") + a + b);
+    }
+  }
+  return names;
+}
+
+std::vector<double> Pressure::evaluate(const Snapshot& snapshot) {
+  if (not snapshot.forces.valid or snapshot.particles.empty()) {
+    return std::vector<double>(10, std::numeric_limits<double>::quiet_NaN());
+  }
+  const auto& virial = snapshot.forces.virial;
+  double trace = 0;
+  for (int d = 0; d < dimensions; d++) {
+    trace += virial[d][d];
+  }
+  const double volume = systemVolume(snapshot.particles, dimensions, domainSize, 1.0);
+  std::vector<double> values{(2.0 * kineticEnergy(snapshot.particles) + trace) / (dimensions * volume)};
+  for (const auto& row : virial) {
+    values.insert(values.end(), row.begin(), row.end());
+  }
+  return values;
+}
+
+RadialDistribution::RadialDistribution(const double rMax, const std::size_t bins, const int dimensions,
+                                       std::optional<std::array<double, 3>> domainSize)
+    : rMax(rMax), bins(bins), dimensions(dimensions), domainSize(domainSize) {}
+
+std::vector<std::string> RadialDistribution::columns() const {
+  std::vector<std::string> names;
+  names.reserve(bins);
+  const double width = rMax / static_cast<double>(bins);
+  for (std::size_t b = 0; b < bins; b++) {
+    std::ostringstream name;
+    name << "g(" << std::setprecision(4) << (static_cast<double>(b) + 0.5) * width << ")";
+    names.push_back(name.str());
+  }
+  return names;
+}
+
+std::vector<double> RadialDistribution::evaluate(const Snapshot& snapshot) {
+  const auto& particles = snapshot.particles;
+  std::vector<double> histogram(bins, 0.0);
+  const std::size_t n = particles.size();
+  if (n < 2) {
+    return histogram;
+  }
+
+  const double width = rMax / static_cast<double>(bins);
+  const double rMax2 = rMax * rMax;
+  for (std::size_t i = 0; i < n; i++) {
+    const auto& x_i = particles[i].getX();
+    for (std::size_t j = i + 1; j < n; j++) {
+      const auto& x_j = particles[j].getX();
+      const double dx = x_j[0] - x_i[0];
+      const double dy = x_j[1] - x_i[1];
+      const double dz = x_j[2] - x_i[2];
+      const double r2 = dx * dx + dy * dy + dz * dz;
+      if (r2 < rMax2) {
+        histogram[std::min(bins - 1, static_cast<std::size_t>(std::sqrt(r2) / width))] += 2.0;
+      }
+    }
+  }
+
+  const double density = static_cast<double>(n) / systemVolume(particles, dimensions, domainSize, width);
+  for (std::size_t b = 0; b < bins; b++) {
+    const double r0 = static_cast<double>(b) * width;
+    const double r1 = r0 + width;
+    const double shell =
+        dimensions == 2 ? M_PI * (r1 * r1 - r0 * r0) : 4.0 / 3.0 * M_PI * (r1 * r1 * r1 - r0 * r0 * r0);
+    histogram[b] /= static_cast<double>(n) * density * shell;
+  }
+  return histogram;
+}
+
+}  // namespace analysis
@@ -0,0 +1,274 @@
+#include "analysis/TrajectoryIndex.h"
+
+#include "io/VTUReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+
+namespace analysis {
+
+namespace {
+constexpr const char* formatLine = "# MolSim trajectory index v1";
+
+std::int64_t modificationTime(const std::filesystem::path& path) {
+  return static_cast<std::int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+}
+
+/**
+ * @brief Reads the statistics of a snapshot and where its arrays are
+ */
+FrameSummary summarize(const std::filesystem::path& path) {
+  const VTUReader reader(path.string());
+  const auto points = reader.find("points");
+  const auto velocity = reader.find("velocity");
+  const auto id = reader.find("id");
+  // the tracks read single values at the offsets, so the types must be the ones of VTUWriter
+  if (not points or not velocity or points->type != "Float64" or velocity->type != "Float32" or
+      (id and id->type != "UInt64")) {
+    throw std::runtime_error(path.string() + " was not written by MolSim");
+  }
+
+  FrameSummary frame;
+  frame.file = path.filename().string();
+  frame.fileBytes = std::filesystem::file_size(path);
+  frame.fileTime = modificationTime(path);
+  frame.particles = reader.size();
+  frame.pointsOffset = points->offset;
+  frame.velocityOffset = velocity->offset;
+  frame.idOffset = id ? id->offset : 0;
+
+  const std::vector<double> x = reader.readArray("points");
+  const std::vector<double> v = reader.readArray("velocity");
+  const std::vector<double> m = reader.readArray("mass");
+  frame.lower.fill(frame.particles > 0 ? std::numeric_limits<double>::max() : 0.0);
+  frame.upper.fill(frame.particles > 0 ? std::numeric_limits<double>::lowest() : 0.0);
+  double maxSpeed2 = 0;
+  for (std::size_t i = 0; i < frame.particles; i++) {
+    double speed2 = 0;
+    for (std::size_t d = 0; d < 3; d++) {
+      frame.lower[d] = std::min(frame.lower[d], x[3 * i + d]);
+      frame.upper[d] = std::max(frame.upper[d], x[3 * i + d]);
+      speed2 += v[3 * i + d] * v[3 * i + d];
+    }
+    frame.kineticEnergy += 0.5 * m[i] * speed2;
+    maxSpeed2 = std::max(maxSpeed2, speed2);
+  }
+  frame.maxSpeed = std::sqrt(maxSpeed2);
+  return frame;
+}
+
+/**
+ * @brief Reads a value of type T at a byte offset of a file
+ */
+template <typename T, std::size_t N>
+std::array<T, N> readAt(std::ifstream& file, const std::uint64_t offset) {
+  std::array<T, N> values{};
+  file.seekg(static_cast<std::streamoff>(offset));
+  if (not file.read(reinterpret_cast<char*>(values.data()), sizeof(values))) {
+    throw std::runtime_error("Snapshot is truncated");
+  }
+  return values;
+}
+
+using Statistic = std::function<double(const FrameSummary&)>;
+
+const std::map<std::string, Statistic>& statistics() {
+  static const std::map<std::string, Statistic> all{
+      {"iteration", [](const FrameSummary& f) { return f.iteration; }},
+      {"time", [](const FrameSummary& f) { return f.time; }},
+      {"particles", [](const FrameSummary& f) { return static_cast<double>(f.particles); }},
+      {"kinetic_energy", [](const FrameSummary& f) { return f.kineticEnergy; }},
+      {"max_speed", [](const FrameSummary& f) { return f.maxSpeed; }},
+      {"x_min", [](const FrameSummary& f) { return f.lower[0]; }},
+      {"y_min", [](const FrameSummary& f) { return f.lower[1]; }},
+      {"z_min", [](const FrameSummary& f) { return f.lower[2]; }},
+      {"x_max", [](const FrameSummary& f) { return f.upper[0]; }},
+      {"y_max", [](const FrameSummary& f) { return f.upper[1]; }},
+      {"z_max", [](const FrameSummary& f) { return f.upper[2]; }}};
+  return all;
+}
+}  // namespace
+
+TrajectoryIndex TrajectoryIndex::build(const std::string& directory, const double dt, const std::string& prefix,
+                                       const TrajectoryIndex* previous) {
+  TrajectoryIndex index;
+  index.directory = directory;
+  index.dt = dt;
+
+  const std::regex snapshot(prefix + "_(\\d+)\\.vtu");
+  std::vector<std::pair<int, std::filesystem::path>> files;
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    std::smatch match;
+    const std::string name = entry.path().filename().string();
+    if (entry.is_regular_file() and std::regex_match(name, match, snapshot)) {
+      files.emplace_back(std::stoi(match[1]), entry.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  std::map<std::string, const FrameSummary*> known;
+  if (previous) {
+    for (const auto& frame : previous->frames) {
+      known.emplace(frame.file, &frame);
+    }
+  }
+
+  index.frames.resize(files.size());
+  std::vector<std::string> errors(files.size());
+#pragma omp parallel for schedule(dynamic, 1)
+  for (std::size_t i = 0; i < files.size(); i++) {
+    const auto& [iteration, path] = files[i];
+    const auto it = known.find(path.filename().string());
+    try {
+      if (it != known.end() and it->second->fileBytes == std::filesystem::file_size(path) and
+          it->second->fileTime == modificationTime(path)) {
+        index.frames[i] = *it->second;
+      } else {
+        index.frames[i] = summarize(path);
+      }
+    } catch (const std::exception& err) {
+      errors[i] = err.what();
+    }
+    index.frames[i].iteration = iteration;
+    index.frames[i].time = iteration * dt;
+  }
+  for (const auto& error : errors) {
+    if (not error.empty()) {
+      throw std::runtime_error(error);
+    }
+  }
+  return index;
+}
+
+std::optional<TrajectoryIndex> TrajectoryIndex::load(const std::string& directory) {
+  std::ifstream file(std::filesystem::path(directory) / filename);
+  if (not file) {
+    return std::nullopt;
+  }
+  TrajectoryIndex index;
+  index.directory = directory;
+  std::string line;
+  std::getline(file, line);
+  std::istringstream format(line.substr(std::min(line.size(), std::strlen(formatLine))));
+  std::string key;
+  if (line.rfind(formatLine, 0) != 0 or not(format >> key >> index.dt) or key != "dt") {
+    throw std::runtime_error("Unsupported trajectory index in " + directory);
+  }
+  std::getline(file, line);  // column names
+  while (std::getline(file, line)) {
+    std::istringstream columns(line);
+    FrameSummary frame;
+    columns >> frame.iteration >> frame.time >> frame.particles >> frame.kineticEnergy >> frame.maxSpeed;
+    for (std::size_t d = 0; d < 3; d++) {
+      columns >> frame.lower[d] >> frame.upper[d];
+    }
+    columns >> frame.pointsOffset >> frame.velocityOffset >> frame.idOffset >> frame.fileBytes >> frame.fileTime;
+    columns.ignore(1, '\t');
+    if (not columns or not std::getline(columns, frame.file) or frame.file.empty()) {
+      throw std::runtime_error("Corrupt trajectory index in " + directory + ": " + line);
+    }
+    index.frames.push_back(frame);
+  }
+  return index;
+}
+
+void TrajectoryIndex::save() const {
+  const auto path = std::filesystem::path(directory) / filename;
+  std::ofstream file(path);
+  file << formatLine << " dt " << std::setprecision(17) << dt << "\n"
+       << "iteration\ttime\tparticles\tkinetic_energy\tmax_speed\tx_min\tx_max\ty_min\ty_max\tz_min\tz_max\t"
+          "points_offset\tvelocity_offset\tid_offset\tfile_bytes\tfile_time\tfile\n";
+  for (const auto& frame : frames) {
+    file << frame.iteration << '\t' << frame.time << '\t' << frame.particles << '\t' << frame.kineticEnergy << '\t'
+         << frame.maxSpeed;
+    for (std::size_t d = 0; d < 3; d++) {
+      file << '\t' << frame.lower[d] << '\t' << frame.upper[d];
+    }
+    file << '\t' << frame.pointsOffset << '\t' << frame.velocityOffset << '\t' << frame.idOffset << '\t'
+         << frame.fileBytes << '\t' << frame.fileTime << '\t' << frame.file << '\n';
+  }
+  if (not file) {
+    throw std::runtime_error("Could not write " + path.string());
+  }
+}
+
+const std::vector<std::string>& TrajectoryIndex::fields() {
+  static const std::vector<std::string> names = [] {
+    std::vector<std::string> keys;
+    for (const auto& [name, statistic] : statistics()) {
+      keys.push_back(name);
+    }
+    return keys;
+  }();
+  return names;
+}
+
+double TrajectoryIndex::value(const FrameSummary& frame, const std::string& field) {
+  const auto it = statistics().find(field);
+  if (it == statistics().end()) {
+    throw std::invalid_argument("Unknown frame statistic " + field);
+  }
+  return it->second(frame);
+}
+
+std::vector<FrameSummary> TrajectoryIndex::select(const std::string& field, const std::string& comparison,
+                                                  const double threshold) const {
+  const std::map<std::string, std::function<bool(double, double)>> comparisons{
+      {"<", std::less<>()}, {"<=", std::less_equal<>()}, {">", std::greater<>()}, {">=", std::greater_equal<>()}};
+  const auto compare = comparisons.find(comparison);
+  if (compare == comparisons.end()) {
+    throw std::invalid_argument("Unknown comparison " + comparison + ", expected <, <=, > or >=");
+  }
+  std::vector<FrameSummary> selected;
+  for (const auto& frame : frames) {
+    if (compare->second(value(frame, field), threshold)) {
+      selected.push_back(frame);
+    }
+  }
+  return selected;
+}
+
+std::vector<TrajectoryIndex::TrackPoint> TrajectoryIndex::track(const std::size_t id) const {
+  std::vector<TrackPoint> points;
+  for (const auto& frame : frames) {
+    std::ifstream file(std::filesystem::path(directory) / frame.file, std::ios::binary);
+    if (not file) {
+      throw std::runtime_error("Could not open " + frame.file);
+    }
+    // particles keep their storage index unless others were removed or reordered, so try that first
+    std::optional<std::size_t> index;
+    if (frame.idOffset == 0) {
+      index = id < frame.particles ? std::optional(id) : std::nullopt;
+    } else if (id < frame.particles and readAt<std::uint64_t, 1>(file, frame.idOffset + 8 * id)[0] == id) {
+      index = id;
+    } else {
+      std::vector<std::uint64_t> ids(frame.particles);
+      file.seekg(static_cast<std::streamoff>(frame.idOffset));
+      if (not file.read(reinterpret_cast<char*>(ids.data()), static_cast<std::streamsize>(8 * ids.size()))) {
+        throw std::runtime_error(frame.file + " is truncated");
+      }
+      if (const auto it = std::find(ids.begin(), ids.end(), id); it != ids.end()) {
+        index = static_cast<std::size_t>(it - ids.begin());
+      }
+    }
+    if (not index) {
+      continue;
+    }
+    const auto x = readAt<double, 3>(file, frame.pointsOffset + 3 * sizeof(double) * *index);
+    const auto v = readAt<float, 3>(file, frame.velocityOffset + 3 * sizeof(float) * *index);
+    points.push_back({frame.iteration, frame.time, x, {v[0], v[1], v[2]}});
+  }
+  return points;
+}
+
+}  // namespace analysis
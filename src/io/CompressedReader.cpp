@@ -0,0 +1,81 @@
+#include "io/CompressedReader.h"
+
+#include "utils/Compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+CompressedReader::CompressedReader(const std::string& filename) : file(filename, std::ios::binary) {
+  if (not file) {
+    throw std::runtime_error("Could not open " + filename);
+  }
+  std::array<char, 4> magic{};
+  file.read(magic.data(), magic.size());
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (not file or magic != outputWriter::compressedMagic) {
+    throw std::runtime_error(filename + " is not a compressed snapshot file");
+  }
+}
+
+std::optional<CompressedReader::Frame> CompressedReader::nextFrame() {
+  std::uint64_t sizes[2];
+  if (not file.read(reinterpret_cast<char*>(sizes), sizeof(sizes))) {
+    return std::nullopt;
+  }
+  std::vector<std::uint8_t> encoded(sizes[1]);
+  if (not file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()))) {
+    throw std::runtime_error("Compressed snapshot file is truncated");
+  }
+  const std::vector<std::uint8_t> raw = utils::huffmanDecode(encoded, sizes[0]);
+
+  const std::uint64_t previousFrame = frames++;
+  std::size_t position = 0;
+  Frame frame{static_cast<int>(utils::zigzagDecode(utils::readVarint(raw, position))), {}};
+  const std::uint64_t count = utils::readVarint(raw, position);
+  frame.particles.resize(count);
+
+  std::vector<std::size_t> ids(count);
+  std::size_t id = 0;
+  for (std::uint64_t i = 0; i < count; i++) {
+    id += static_cast<std::size_t>(utils::zigzagDecode(utils::readVarint(raw, position)));
+    ids[i] = id;
+    if (id >= states.size()) {
+      states.resize(std::max(id + 1, 2 * states.size()));
+    }
+    State& state = states[id];
+    if (state.frame != previousFrame or previousFrame == 0) {
+      state.q.fill(0);
+    }
+    for (auto& q : state.q) {
+      q += utils::zigzagDecode(utils::readVarint(raw, position));
+    }
+  }
+
+  for (std::uint64_t i = 0; i < count; i++) {
+    State& state = states[ids[i]];
+    if (state.frame != previousFrame or previousFrame == 0) {
+      if (position + sizeof(double) > raw.size()) {
+        throw std::runtime_error("Compressed snapshot frame is truncated");
+      }
+      std::memcpy(&state.m, raw.data() + position, sizeof(double));
+      position += sizeof(double);
+      state.type = static_cast<int>(utils::zigzagDecode(utils::readVarint(raw, position)));
+    }
+    state.frame = frames;
+
+    std::array<double, 3> x{};
+    std::array<double, 3> v{};
+    std::array<double, 3> f{};
+    for (std::size_t d = 0; d < 3; d++) {
+      x[d] = header.origin[d] + static_cast<double>(state.q[d]) * header.positionStep[d];
+      v[d] = static_cast<double>(state.q[3 + d]) * header.velocityStep;
+      f[d] = static_cast<double>(state.q[6 + d]) * header.forceStep;
+    }
+    Particle& p = frame.particles[i];
+    p = Particle(x, v, state.m, state.type);
+    p.setF(f);
+    p.setId(ids[i]);
+  }
+  return frame;
+}
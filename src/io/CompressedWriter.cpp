@@ -0,0 +1,143 @@
+#include "io/CompressedWriter.h"
+
+#include "utils/Compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace outputWriter {
+
+namespace {
+/**
+ * @brief Rounds a value to the nearest multiple of step
+ */
+std::int64_t quantize(const double value, const double step) {
+  const double scaled = value / step;
+  // keeps deltas between two quantized values within 64 bits
+  if (not(std::abs(scaled) < 0x1p62)) {
+    throw std::overflow_error("Value " + std::to_string(value) + " cannot be quantized with step " +
+                              std::to_string(step));
+  }
+  return std::llround(scaled);
+}
+}  // namespace
+
+CompressedWriter::CompressedWriter(std::string filename, const CompressionSettings settings)
+    : filename(std::move(filename)), settings(settings) {}
+
+void CompressedWriter::setDomain(const std::array<double, 3>& lower, const std::array<double, 3>& upper) {
+  if (file.is_open()) {
+    throw std::logic_error("The domain of a compressed output must be set before the first frame");
+  }
+  open(lower, upper);
+}
+
+void CompressedWriter::open(const std::array<double, 3>& lower, const std::array<double, 3>& upper) {
+  const std::filesystem::path path(filename);
+  if (path.has_parent_path()) {
+    try {
+      std::filesystem::create_directories(path.parent_path());
+    } catch (const std::filesystem::filesystem_error& err) {
+      SPDLOG_ERROR("Error while creating directory {}:{}", path.parent_path().string(), err.what());
+    }
+  }
+
+  double largestExtent = 0;
+  for (std::size_t d = 0; d < 3; d++) {
+    largestExtent = std::max(largestExtent, upper[d] - lower[d]);
+  }
+  header.origin = lower;
+  for (std::size_t d = 0; d < 3; d++) {
+    // flat dimensions (e.g. z in 2D) use the resolution of the largest one
+    const double extent = upper[d] > lower[d] ? upper[d] - lower[d] : largestExtent;
+    header.positionStep[d] = settings.positionPrecision * (extent > 0 ? extent : 1.0);
+  }
+  header.velocityStep = settings.velocityStep;
+  header.forceStep = settings.forceStep;
+
+  file.open(filename, std::ios::binary);
+  if (not file) {
+    SPDLOG_ERROR("Could not open the compressed output file {}", filename);
+    return;
+  }
+  file.write(compressedMagic.data(), compressedMagic.size());
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void CompressedWriter::plotParticles(const ParticleContainer& particles, const int iteration) {
+  if (not file.is_open()) {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    lower.fill(particles.size() > 0 ? std::numeric_limits<double>::max() : 0.0);
+    upper.fill(particles.size() > 0 ? std::numeric_limits<double>::lowest() : 0.0);
+    for (const auto& p : particles) {
+      for (std::size_t d = 0; d < 3; d++) {
+        lower[d] = std::min(lower[d], p.getX()[d]);
+        upper[d] = std::max(upper[d], p.getX()[d]);
+      }
+    }
+    open(lower, upper);
+  }
+
+  const std::uint64_t previousFrame = frames++;
+  std::vector<std::uint8_t> raw;
+  raw.reserve(particles.size() * 12);
+  utils::appendVarint(raw, utils::zigzagEncode(iteration));
+  utils::appendVarint(raw, particles.size());
+
+  std::size_t previousId = 0;
+  for (const auto& p : particles) {
+    const std::size_t id = p.getId();
+    if (id >= states.size()) {
+      states.resize(std::max(id + 1, 2 * states.size()));
+    }
+    State& state = states[id];
+    if (state.frame != previousFrame or previousFrame == 0) {
+      // new particle, encoded relative to zero
+      state.q.fill(0);
+    }
+
+    std::array<std::int64_t, 9> q{};
+    for (std::size_t d = 0; d < 3; d++) {
+      q[d] = quantize(p.getX()[d] - header.origin[d], header.positionStep[d]);
+      q[3 + d] = quantize(p.getV()[d], header.velocityStep);
+      q[6 + d] = quantize(p.getF()[d], header.forceStep);
+    }
+
+    utils::appendVarint(raw, utils::zigzagEncode(static_cast<std::int64_t>(id - previousId)));
+    for (std::size_t k = 0; k < q.size(); k++) {
+      utils::appendVarint(raw, utils::zigzagEncode(q[k] - state.q[k]));
+    }
+    previousId = id;
+    state.q = q;
+  }
+
+  // constant properties of the particles that were not part of the previous frame
+  for (const auto& p : particles) {
+    State& state = states[p.getId()];
+    if (state.frame != previousFrame or previousFrame == 0) {
+      const double m = p.getM();
+      std::uint8_t bytes[sizeof(double)];
+      std::memcpy(bytes, &m, sizeof(double));
+      raw.insert(raw.end(), bytes, bytes + sizeof(double));
+      utils::appendVarint(raw, utils::zigzagEncode(p.getType()));
+    }
+    state.frame = frames;
+  }
+
+  const std::vector<std::uint8_t> encoded = utils::huffmanEncode(raw);
+  const std::uint64_t sizes[2] = {raw.size(), encoded.size()};
+  file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+  file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+  file.flush();
+  SPDLOG_DEBUG("Iteration {} written: {} particles in {} bytes", iteration, particles.size(), encoded.size());
+}
+
+}  // namespace outputWriter
@@ -1,10 +1,15 @@
 #include "io/FileReader.h"
 #include "utils/MaxwellBoltzmannDistribution.h"  // include for testing (? TODO)
 
-#include <cstdlib>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #ifndef SPDLOG_ACTIVE_LEVEL
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
@@ -35,6 +40,7 @@ void BaseFileReader::readFile(ParticleContainer& particles) {
     std::istringstream numstream(tmp_string);
     numstream >> num_particles;
     SPDLOG_DEBUG("Reading {}.", tmp_string);
+    particles.reserve(particles.size() + num_particles);
     getline(input_file, tmp_string);
     SPDLOG_DEBUG("Read line: {}", tmp_string);
 
@@ -48,8 +54,8 @@ void BaseFileReader::readFile(ParticleContainer& particles) {
         datastream >> vj;
       }
       if (datastream.eof()) {
-        SPDLOG_ERROR("Error reading file: eof reached unexpectedly reading from line {}", i);
-        exit(-1);
+        throw std::runtime_error("Error reading " + filename + ": eof reached unexpectedly reading from line " +
+                                 std::to_string(i));
       }
       datastream >> m;
       particles.addParticle(x, v, m);
@@ -60,13 +66,20 @@ void BaseFileReader::readFile(ParticleContainer& particles) {
       SPDLOG_DEBUG("Read line: {}", tmp_string);
     }
   } else {
-    SPDLOG_ERROR("Error: could not open file {}", filename);
-    exit(-1);
+    throw std::runtime_error("Could not open input file " + filename);
   }
 }
 
 // CuboidFileReader class definition
-void CuboidFileReader::readFile(ParticleContainer& particles) {
+std::vector<Species> CuboidFileReader::getSpecies(const Species& fallback) const {
+  std::vector<Species> result(maxType + 1, fallback);
+  for (const auto& [type, typeSpecies] : species) {
+    result[type] = typeSpecies;
+  }
+  return result;
+}
+
+std::vector<CuboidFileReader::CuboidSpec> CuboidFileReader::parseCuboids() {
   std::array<double, 3> cx{};
   std::array<double, 3> cv{};
   std::array<int, 3> n{};
@@ -79,69 +92,157 @@ void CuboidFileReader::readFile(ParticleContainer& particles) {
   std::ifstream input_file(filename);
   std::string tmp_string;
 
-  if (input_file.is_open()) {
+  if (not input_file.is_open()) {
+    throw std::runtime_error("Could not open input file " + filename);
+  }
+
+  getline(input_file, tmp_string);
+
+  while (tmp_string.empty() or tmp_string[0] == '#') {
     getline(input_file, tmp_string);
+  }
+  SPDLOG_DEBUG("Read line: {}", tmp_string);
 
-    while (tmp_string.empty() or tmp_string[0] == '#') {
-      getline(input_file, tmp_string);
+  std::istringstream numstream(tmp_string);
+  numstream >> num_cuboids;
+
+  SPDLOG_DEBUG("Reading {} cuboids.", num_cuboids);
+  getline(input_file, tmp_string);
+  SPDLOG_DEBUG("Read line: {}", tmp_string);
+
+  std::vector<CuboidSpec> cuboids;
+  cuboids.reserve(num_cuboids);
+  for (int i = 0; i < num_cuboids; i++) {
+    std::istringstream datastream(tmp_string);
+
+    for (auto& cxj : cx) {
+      datastream >> cxj;
+    }
+    for (auto& cvj : cv) {
+      datastream >> cvj;
+    }
+    for (auto& nj : n) {
+      datastream >> nj;
+    }
+    if (datastream.eof()) {
+      throw std::runtime_error("Error reading " + filename + ": eof reached unexpectedly reading from line " +
+                               std::to_string(i));
+    }
+    datastream >> h;
+    datastream >> m;
+    datastream >> t;
+
+    // optional: particle type with its Lennard-Jones parameters
+    int type = 0;
+    if (datastream >> type) {
+      Species typeSpecies{};
+      if (type < 0 or not(datastream >> typeSpecies.epsilon >> typeSpecies.sigma)) {
+        throw std::runtime_error("Error reading " + filename +
+                                 ": expected a non-negative type, epsilon and sigma in line " + std::to_string(i));
+      }
+      if (const auto [it, inserted] = species.emplace(type, typeSpecies);
+          not inserted and (it->second.epsilon != typeSpecies.epsilon or it->second.sigma != typeSpecies.sigma)) {
+        throw std::runtime_error("Error reading " + filename + ": conflicting parameters for particle type " +
+                                 std::to_string(type) + " in line " + std::to_string(i));
+      }
+      maxType = std::max(maxType, type);
     }
-    SPDLOG_DEBUG("Read line: {}", tmp_string);
 
-    std::istringstream numstream(tmp_string);
-    numstream >> num_cuboids;
+    cuboids.push_back({cx, cv, n, h, m, t, type});
+    if (n[2] != 1 or cv[2] != 0 or cx[2] != cuboids.front().x[2]) {
+      dimensions = 3;
+    }
 
-    SPDLOG_DEBUG("Reading {} cuboids.", num_cuboids);
     getline(input_file, tmp_string);
     SPDLOG_DEBUG("Read line: {}", tmp_string);
+  }
+  return cuboids;
+}
 
-    for (int i = 0; i < num_cuboids; i++) {
-      std::istringstream datastream(tmp_string);
+std::size_t CuboidFileReader::countParticles() {
+  std::size_t num_particles = 0;
+  for (const auto& cuboid : parseCuboids()) {
+    num_particles += static_cast<std::size_t>(cuboid.n[0]) * cuboid.n[1] * cuboid.n[2];
+  }
+  return num_particles;
+}
 
-      for (auto& cxj : cx) {
-        datastream >> cxj;
-      }
-      for (auto& cvj : cv) {
-        datastream >> cvj;
-      }
-      for (auto& nj : n) {
-        datastream >> nj;
-      }
-      if (datastream.eof()) {
-        SPDLOG_ERROR("Error reading file: eof reached unexpectedly reading from line {}", i);
-        exit(-1);
-      }
-      datastream >> h;
-      datastream >> m;
-      datastream >> t;
-
-      //code for generating particles:
-      for (int nx = 0; nx < n[0]; nx++) {
-        for (int ny = 0; ny < n[1]; ny++) {
-          for (int nz = 0; nz < n[2]; nz++) {
-
-            std::array<double, 3> tempx = {cx[0] + h * nx, cx[1] + h * ny, cx[2] + h * nz};
-            std::array<double, 3> tempv = {cv[0], cv[1], cv[2]};
-            std::array<double, 3> temperatureVel = maxwellBoltzmannDistributedVelocity(t, 2);
-            tempv[0] += temperatureVel[0];
-            tempv[1] += temperatureVel[1];
-            tempv[2] += temperatureVel[2];
-            particles.addParticle(tempx, tempv, m);
-            //            SPDLOG_DEBUG("Generated particle with x={{{0:.2f}, {0:.2f}, {0:.2f}}}, v={{{0:.2f}, {0:.2f}, {0:.2f}}}, m={0:.2f}",
-            //                   tempx[0], tempx[1], tempx[2],
-            //                   tempv[0], tempv[1], tempv[2], m);
-          }
+namespace {
+/**
+ * @brief Seed of the random velocities of every read
+ */
+constexpr unsigned randomSeed = 42;
+
+/**
+ * @brief Describes everything besides the file contents that the generated particles depend on, any change to the
+ * generation must also change this string to invalidate cached states
+ */
+const std::string generatorParameters = "cuboid generator v1, seed " + std::to_string(randomSeed) +
+                                        ", Maxwell-Boltzmann in 2 dimensions, std::default_random_engine";
+}  // namespace
+
+void CuboidFileReader::readFile(ParticleContainer& particles) {
+  generate(parseCuboids(), particles);
+}
+
+void CuboidFileReader::readFile(ParticleContainer& particles, const InitialStateCache& cache) {
+  const std::vector<CuboidSpec> cuboids = parseCuboids();
+  std::ifstream input_file(filename, std::ios::binary);
+  const std::string contents{std::istreambuf_iterator<char>(input_file), std::istreambuf_iterator<char>()};
+  const std::uint64_t key = InitialStateCache::hash(generatorParameters, InitialStateCache::hash(contents));
+
+  if (cache.load(key, particles)) {
+    SPDLOG_INFO("Loaded initial state of {} from {}", filename, cache.path(key));
+    return;
+  }
+  // the cached state must not contain particles that were in the container before
+  ParticleContainer generated;
+  generate(cuboids, generated);
+  if (cache.store(key, generated)) {
+    SPDLOG_INFO("Stored initial state of {} in {}", filename, cache.path(key));
+  }
+  if (particles.size() == 0) {
+    particles = std::move(generated);
+    return;
+  }
+  particles.reserve(particles.size() + generated.size());
+  for (const auto& p : generated) {
+    particles.addParticle(p.getX(), p.getV(), p.getM(), p.getType());
+  }
+}
+
+void CuboidFileReader::generate(const std::vector<CuboidSpec>& cuboids, ParticleContainer& particles) {
+  // all cuboids are parsed first so the container can be sized once before generating the particles
+  std::size_t num_particles = 0;
+  for (const auto& cuboid : cuboids) {
+    num_particles += static_cast<std::size_t>(cuboid.n[0]) * cuboid.n[1] * cuboid.n[2];
+  }
+  particles.reserve(particles.size() + num_particles);
+
+  // every read draws the same velocities, independent of other readers running in the same process
+  std::default_random_engine randomEngine(randomSeed);
+  for (const auto& cuboid : cuboids) {
+    //code for generating particles:
+    for (int nx = 0; nx < cuboid.n[0]; nx++) {
+      for (int ny = 0; ny < cuboid.n[1]; ny++) {
+        for (int nz = 0; nz < cuboid.n[2]; nz++) {
+
+          std::array<double, 3> tempx = {cuboid.x[0] + cuboid.h * nx, cuboid.x[1] + cuboid.h * ny,
+                                         cuboid.x[2] + cuboid.h * nz};
+          std::array<double, 3> tempv = {cuboid.v[0], cuboid.v[1], cuboid.v[2]};
+          std::array<double, 3> temperatureVel = maxwellBoltzmannDistributedVelocity(cuboid.t, 2, randomEngine);
+          tempv[0] += temperatureVel[0];
+          tempv[1] += temperatureVel[1];
+          tempv[2] += temperatureVel[2];
+          particles.addParticle(tempx, tempv, cuboid.m, cuboid.type);
         }
       }
-
-      getline(input_file, tmp_string);
-      SPDLOG_DEBUG("Read line: {}", tmp_string);
-      SPDLOG_DEBUG(
-          "Generated cuboid of {} particles with position {{{}, {}, {}}}, velocity {{{}, {}, {}}}, particle separation "
-          "{} and average brownian motion velocity {}",
-          n[0] * n[1] * n[2], cx[0], cx[1], cx[2], cv[0], cv[1], cv[2], h, t);
     }
-  } else {
-    SPDLOG_ERROR("Error: could not open file {}", filename);
-    exit(-1);
+
+    SPDLOG_DEBUG(
+        "Generated cuboid of {} particles with position {{{}, {}, {}}}, velocity {{{}, {}, {}}}, particle separation "
+        "{} and average brownian motion velocity {}",
+        cuboid.n[0] * cuboid.n[1] * cuboid.n[2], cuboid.x[0], cuboid.x[1], cuboid.x[2], cuboid.v[0], cuboid.v[1],
+        cuboid.v[2], cuboid.h, cuboid.t);
   }
 }
@@ -0,0 +1,117 @@
+#include "io/InitialStateCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+InitialStateCache::InitialStateCache(std::string directory, const bool refresh)
+    : directory(std::move(directory)), refresh(refresh) {}
+
+std::uint64_t InitialStateCache::hash(const std::string& bytes, std::uint64_t hash) {
+  for (const char c : bytes) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+std::string InitialStateCache::path(const std::uint64_t key) const {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << key << ".state";
+  return (std::filesystem::path(directory) / name.str()).string();
+}
+
+bool InitialStateCache::load(const std::uint64_t key, ParticleContainer& particles) const {
+  if (refresh) {
+    return false;
+  }
+  const std::string file = path(key);
+  const int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status {};
+  void* mapping = MAP_FAILED;
+  std::size_t bytes = 0;
+  if (::fstat(fd, &status) == 0 and static_cast<std::size_t>(status.st_size) >= sizeof(Header)) {
+    bytes = static_cast<std::size_t>(status.st_size);
+    mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    SPDLOG_WARN("Ignoring unreadable initial state {}", file);
+    return false;
+  }
+  // the records are only read once, front to back
+  ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+  const auto* header = static_cast<const Header*>(mapping);
+  const auto* records = reinterpret_cast<const Record*>(header + 1);
+  const bool valid = header->magic == magic and header->key == key and
+                     (bytes - sizeof(Header)) / sizeof(Record) == header->count and
+                     (bytes - sizeof(Header)) % sizeof(Record) == 0;
+  if (valid) {
+    particles.reserve(particles.size() + header->count);
+    for (std::size_t i = 0; i < header->count; i++) {
+      const Record& r = records[i];
+      particles.addParticle({r.x[0], r.x[1], r.x[2]}, {r.v[0], r.v[1], r.v[2]}, r.m, r.type);
+    }
+  } else {
+    SPDLOG_WARN("Ignoring invalid initial state {}", file);
+  }
+  ::munmap(mapping, bytes);
+  return valid;
+}
+
+bool InitialStateCache::store(const std::uint64_t key, const ParticleContainer& particles) const {
+  try {
+    std::filesystem::create_directories(directory);
+  } catch (const std::filesystem::filesystem_error& err) {
+    SPDLOG_ERROR("Error while creating directory {}:{}", directory, err.what());
+    return false;
+  }
+
+  std::vector<Record> records;
+  records.reserve(particles.size());
+  for (const auto& p : particles) {
+    const auto& x = p.getX();
+    const auto& v = p.getV();
+    records.push_back({{x[0], x[1], x[2]}, {v[0], v[1], v[2]}, p.getM(), p.getType(), 0});
+  }
+  const Header header{magic, key, records.size()};
+
+  // unique per process and thread, as ensemble members may store the same state concurrently
+  const std::string file = path(key);
+  const std::string temporary = file + ".tmp" + std::to_string(::getpid()) + "_" +
+                                std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream out(temporary, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(Record)));
+    if (not out) {
+      SPDLOG_ERROR("Could not write initial state {}", temporary);
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  if (std::rename(temporary.c_str(), file.c_str()) != 0) {
+    SPDLOG_ERROR("Could not move initial state {} to {}", temporary, file);
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,81 @@
+#include "io/PartitionedVTUWriter.h"
+
+#include "io/VTUWriter.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace outputWriter {
+
+namespace {
+std::string snapshotName(const std::string& name, const int iteration) {
+  std::stringstream strstr;
+  strstr << name << "_" << std::setfill('0') << std::setw(4) << iteration;
+  return strstr.str();
+}
+}  // namespace
+
+PartitionedVTUWriter::PartitionedVTUWriter(const int pieces)
+    : pieces(pieces > 0 ? pieces : omp_get_max_threads()) {}
+
+std::pair<std::size_t, std::size_t> PartitionedVTUWriter::pieceRange(const std::size_t count, const int pieces,
+                                                                     const int piece) {
+  const auto n = static_cast<std::size_t>(pieces);
+  const auto p = static_cast<std::size_t>(piece);
+  // the first count % pieces pieces get one particle more
+  const std::size_t base = count / n;
+  const std::size_t remainder = count % n;
+  const std::size_t first = p * base + std::min(p, remainder);
+  return {first, base + (p < remainder ? 1 : 0)};
+}
+
+std::string PartitionedVTUWriter::pieceFilename(const std::string& name, const int iteration, const int piece) {
+  return snapshotName(name, iteration) + "_" + std::to_string(piece) + ".vtu";
+}
+
+bool PartitionedVTUWriter::writePiece(const Particle* particles, const std::size_t count,
+                                      const std::string& outputDirectory, const std::string& name,
+                                      const int iteration, const int piece) {
+  return VTUWriter::writeAppended(particles, count, outputDirectory + "/" + pieceFilename(name, iteration, piece));
+}
+
+bool PartitionedVTUWriter::writeMaster(const std::string& outputDirectory, const std::string& name,
+                                       const int iteration, const int pieces) {
+  std::vector<std::string> sources;
+  sources.reserve(pieces);
+  for (int piece = 0; piece < pieces; piece++) {
+    sources.push_back(pieceFilename(name, iteration, piece));
+  }
+  return VTUWriter::writeMaster(outputDirectory + "/" + snapshotName(name, iteration) + ".pvtu", sources);
+}
+
+void PartitionedVTUWriter::plotParticles(const ParticleContainer& particles, const std::string& name,
+                                         const int iteration, const std::string& outputDirectory) const {
+  try {
+    std::filesystem::create_directories(outputDirectory);
+  } catch (const std::filesystem::filesystem_error& err) {
+    SPDLOG_ERROR("Error while creating directory {}:{}", outputDirectory, err.what());
+    return;
+  }
+
+  const Particle* const data = particles.size() > 0 ? &particles[0] : nullptr;
+  bool written = true;
+#pragma omp parallel for schedule(static, 1) reduction(&& : written)
+  for (int piece = 0; piece < pieces; piece++) {
+    const auto [first, count] = pieceRange(particles.size(), pieces, piece);
+    written = writePiece(data + first, count, outputDirectory, name, iteration, piece) && written;
+  }
+  if (written) {
+    writeMaster(outputDirectory, name, iteration, pieces);
+    SPDLOG_DEBUG("Iteration {} written in {} pieces", iteration, pieces);
+  }
+}
+
+}  // namespace outputWriter
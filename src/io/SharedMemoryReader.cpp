@@ -0,0 +1,113 @@
+#include "io/SharedMemoryReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+SharedMemoryReader::SharedMemoryReader(const std::string& name) {
+  const std::string path = "/" + name;
+  const int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open shared memory segment " + path + ": " + std::strerror(errno));
+  }
+  struct stat status {};
+  void* mapping = MAP_FAILED;
+  if (::fstat(fd, &status) == 0 and
+      static_cast<std::size_t>(status.st_size) >= sizeof(outputWriter::SharedStreamHeader)) {
+    mappingBytes = static_cast<std::size_t>(status.st_size);
+    mapping = ::mmap(nullptr, mappingBytes, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Could not map shared memory segment " + path);
+  }
+  header = static_cast<const outputWriter::SharedStreamHeader*>(mapping);
+
+  if (header->magic != outputWriter::sharedStreamMagic) {
+    ::munmap(mapping, mappingBytes);
+    throw std::runtime_error(path + " is not a live stream of MolSim or not initialized yet");
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  layout = outputWriter::SharedSlotLayout::forCapacity(header->capacity);
+  if (layout.bytes != header->slotBytes or
+      mappingBytes < sizeof(outputWriter::SharedStreamHeader) + header->slots * layout.bytes) {
+    ::munmap(mapping, mappingBytes);
+    throw std::runtime_error("Shared memory segment " + path + " is truncated");
+  }
+}
+
+SharedMemoryReader::~SharedMemoryReader() {
+  ::munmap(const_cast<outputWriter::SharedStreamHeader*>(header), mappingBytes);
+}
+
+std::uint64_t SharedMemoryReader::published() const {
+  return header->published.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryReader::finished() const {
+  return header->finished.load(std::memory_order_acquire) != 0;
+}
+
+std::optional<SharedMemoryReader::FrameView> SharedMemoryReader::latestView() const {
+  const std::uint64_t frames = published();
+  // newest first; a frame is only gone if the writer has lapped the ring since it was published
+  for (std::uint64_t age = 0; age < header->slots and age < frames; age++) {
+    const std::uint64_t frame = frames - 1 - age;
+    const char* const slot = reinterpret_cast<const char*>(header) + sizeof(outputWriter::SharedStreamHeader) +
+                             frame % header->slots * layout.bytes;
+    const auto* const slotHeader = reinterpret_cast<const outputWriter::SharedSlotHeader*>(slot);
+    const std::uint64_t sequence = slotHeader->sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * frame + 2) {
+      continue;
+    }
+    FrameView view{frame,
+                   sequence,
+                   static_cast<int>(slotHeader->iteration),
+                   static_cast<std::size_t>(slotHeader->count),
+                   reinterpret_cast<const double*>(slot + layout.positions),
+                   reinterpret_cast<const float*>(slot + layout.velocities),
+                   reinterpret_cast<const float*>(slot + layout.forces),
+                   reinterpret_cast<const float*>(slot + layout.masses),
+                   reinterpret_cast<const std::int32_t*>(slot + layout.types)};
+    if (view.count <= header->capacity and isIntact(view)) {
+      return view;
+    }
+  }
+  return std::nullopt;
+}
+
+bool SharedMemoryReader::isIntact(const FrameView& view) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const auto* const slotHeader = reinterpret_cast<const outputWriter::SharedSlotHeader*>(
+      reinterpret_cast<const char*>(header) + sizeof(outputWriter::SharedStreamHeader) +
+      view.frame % header->slots * layout.bytes);
+  return slotHeader->sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+std::optional<SharedMemoryReader::Frame> SharedMemoryReader::latestFrame() const {
+  while (published() > 0) {
+    const auto view = latestView();
+    if (not view) {
+      continue;
+    }
+    Frame frame{view->frame, view->iteration, {}};
+    frame.particles.reserve(view->count);
+    for (std::size_t i = 0; i < view->count; i++) {
+      const double* x = view->positions + 3 * i;
+      const float* v = view->velocities + 3 * i;
+      const float* f = view->forces + 3 * i;
+      frame.particles.emplace_back(std::array<double, 3>{x[0], x[1], x[2]}, std::array<double, 3>{v[0], v[1], v[2]},
+                                   view->masses[i], view->types[i]);
+      frame.particles.back().setF({f[0], f[1], f[2]});
+    }
+    if (isIntact(*view)) {
+      return frame;
+    }
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,99 @@
+#include "io/SharedMemoryWriter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace outputWriter {
+
+SharedMemoryWriter::SharedMemoryWriter(std::string name, const std::size_t capacity, const std::uint32_t slots)
+    : name(std::move(name)), layout(SharedSlotLayout::forCapacity(capacity)) {
+  const std::string path = "/" + this->name;
+  // a segment left behind by a crashed run would otherwise be shared with its stale contents
+  ::shm_unlink(path.c_str());
+  const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("Could not create shared memory segment " + path + ": " + std::strerror(errno));
+  }
+  mappingBytes = sizeof(SharedStreamHeader) + slots * layout.bytes;
+  void* mapping = MAP_FAILED;
+  if (::ftruncate(fd, static_cast<off_t>(mappingBytes)) == 0) {
+    mapping = ::mmap(nullptr, mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  const int error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    throw std::runtime_error("Could not map shared memory segment " + path + ": " + std::strerror(error));
+  }
+
+  // ftruncate zero-fills the segment, so all sequences start even and no frame is published
+  header = new (mapping) SharedStreamHeader{};
+  header->slots = slots;
+  header->capacity = capacity;
+  header->slotBytes = layout.bytes;
+  for (std::uint32_t slot = 0; slot < slots; slot++) {
+    new (reinterpret_cast<char*>(header) + sizeof(SharedStreamHeader) + slot * layout.bytes) SharedSlotHeader{};
+  }
+  // the magic is written last, a reader attaching earlier rejects the segment
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = sharedStreamMagic;
+  SPDLOG_INFO("Streaming frames of up to {} particles to shared memory segment {}", capacity, path);
+}
+
+SharedMemoryWriter::~SharedMemoryWriter() {
+  header->finished.store(1, std::memory_order_release);
+  ::munmap(header, mappingBytes);
+  ::shm_unlink(("/" + name).c_str());
+  if (dropped > 0) {
+    SPDLOG_WARN("{} frames exceeded the capacity of shared memory segment /{} and were dropped", dropped, name);
+  }
+}
+
+bool SharedMemoryWriter::publish(const ParticleContainer& particles, const int iteration) {
+  const std::size_t count = particles.size();
+  if (count > header->capacity) {
+    dropped++;
+    return false;
+  }
+  const std::uint64_t frame = header->published.load(std::memory_order_relaxed);
+  char* const slot =
+      reinterpret_cast<char*>(header) + sizeof(SharedStreamHeader) + frame % header->slots * layout.bytes;
+  auto* const slotHeader = reinterpret_cast<SharedSlotHeader*>(slot);
+
+  // seqlock write: odd sequence, data, even sequence
+  slotHeader->sequence.store(2 * frame + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slotHeader->iteration = iteration;
+  slotHeader->count = count;
+  auto* const positions = reinterpret_cast<double*>(slot + layout.positions);
+  auto* const velocities = reinterpret_cast<float*>(slot + layout.velocities);
+  auto* const forces = reinterpret_cast<float*>(slot + layout.forces);
+  auto* const masses = reinterpret_cast<float*>(slot + layout.masses);
+  auto* const types = reinterpret_cast<std::int32_t*>(slot + layout.types);
+  for (std::size_t i = 0; i < count; i++) {
+    const Particle& p = particles[i];
+    for (std::size_t d = 0; d < 3; d++) {
+      positions[3 * i + d] = p.getX()[d];
+      velocities[3 * i + d] = static_cast<float>(p.getV()[d]);
+      forces[3 * i + d] = static_cast<float>(p.getF()[d]);
+    }
+    masses[i] = static_cast<float>(p.getM());
+    types[i] = p.getType();
+  }
+
+  slotHeader->sequence.store(2 * frame + 2, std::memory_order_release);
+  header->published.store(frame + 1, std::memory_order_release);
+  return true;
+}
+
+}  // namespace outputWriter
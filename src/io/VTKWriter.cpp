@@ -23,9 +23,9 @@
 
 namespace outputWriter {
 
-void VTKWriter::plotParticles(const ParticleContainer& particles, const std::string& filename, const int iteration) {
+void VTKWriter::plotParticles(const ParticleContainer& particles, const std::string& filename, const int iteration,
+                              const std::string& output_directory) {
   // create separate output directory
-  const std::string output_directory = "output";
   try {
     std::filesystem::create_directories(output_directory);
   } catch (const std::filesystem::filesystem_error& err) {
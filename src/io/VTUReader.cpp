@@ -0,0 +1,176 @@
+#include "io/VTUReader.h"
+
+#include <cstring>
+#include <regex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+/**
+ * @brief Size in bytes of a value of a VTK type
+ */
+std::size_t typeSize(const std::string& type) {
+  if (type == "Float64" or type == "Int64" or type == "UInt64") {
+    return 8;
+  }
+  if (type == "Float32" or type == "Int32" or type == "UInt32") {
+    return 4;
+  }
+  if (type == "Int8" or type == "UInt8") {
+    return 1;
+  }
+  throw std::runtime_error("Unsupported VTK data type " + type);
+}
+
+double toDouble(const std::string& type, const char* bytes) {
+  const auto load = [bytes](auto value) {
+    std::memcpy(&value, bytes, sizeof(value));
+    return static_cast<double>(value);
+  };
+  if (type == "Float64") {
+    return load(double{});
+  }
+  if (type == "Float32") {
+    return load(float{});
+  }
+  if (type == "Int64") {
+    return load(std::int64_t{});
+  }
+  if (type == "UInt64") {
+    return load(std::uint64_t{});
+  }
+  if (type == "Int32") {
+    return load(std::int32_t{});
+  }
+  if (type == "UInt32") {
+    return load(std::uint32_t{});
+  }
+  if (type == "Int8") {
+    return load(std::int8_t{});
+  }
+  return load(std::uint8_t{});
+}
+
+/**
+ * @brief Value of an attribute in the text of an XML tag, empty if it is not present
+ */
+std::string attribute(const std::string& tag, const std::string& name) {
+  std::smatch match;
+  if (std::regex_search(tag, match, std::regex("\\b" + name + "=\"([^\"]*)\""))) {
+    return match[1];
+  }
+  return "";
+}
+
+const char* hostByteOrder() {
+  const std::uint16_t probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1 ? "LittleEndian" : "BigEndian";
+}
+}  // namespace
+
+VTUReader::VTUReader(std::string filename) : filename(std::move(filename)), file(this->filename, std::ios::binary) {
+  if (not file) {
+    throw std::runtime_error("Could not open " + this->filename);
+  }
+  // the XML header is small, read it in chunks until the start of the appended data
+  const std::string marker = "<AppendedData encoding=\"raw\">";
+  std::string header;
+  std::size_t markerPosition = std::string::npos;
+  char chunk[4096];
+  while (markerPosition == std::string::npos and file.read(chunk, sizeof(chunk)).gcount() > 0) {
+    header.append(chunk, static_cast<std::size_t>(file.gcount()));
+    markerPosition = header.find(marker);
+  }
+  const std::size_t dataStart =
+      markerPosition == std::string::npos ? std::string::npos : header.find('_', markerPosition + marker.size());
+  if (dataStart == std::string::npos) {
+    throw std::runtime_error(this->filename + " is not a .vtu file with raw appended data");
+  }
+  header.resize(dataStart);
+  file.clear();
+
+  std::smatch match;
+  if (not std::regex_search(header, match, std::regex("<VTKFile[^>]*>")) or
+      attribute(match[0], "byte_order") != hostByteOrder() or attribute(match[0], "header_type") != "UInt64") {
+    throw std::runtime_error(this->filename + " uses another byte order or header type than this machine");
+  }
+  if (not std::regex_search(header, match, std::regex("NumberOfPoints=\"(\\d+)\""))) {
+    throw std::runtime_error(this->filename + " does not contain a piece");
+  }
+  points = std::stoul(match[1]);
+
+  const std::regex dataArray("<DataArray[^>]*>");
+  for (auto it = std::sregex_iterator(header.begin(), header.end(), dataArray); it != std::sregex_iterator(); ++it) {
+    const std::string tag = it->str();
+    if (attribute(tag, "format") != "appended") {
+      continue;
+    }
+    const std::string name = attribute(tag, "Name");
+    const std::string components = attribute(tag, "NumberOfComponents");
+    // every block is preceded by its size in bytes
+    arrays.push_back({name.empty() ? "points" : name, attribute(tag, "type"),
+                      components.empty() ? 1 : std::stoul(components),
+                      dataStart + 1 + std::stoull(attribute(tag, "offset")) + sizeof(std::uint64_t)});
+  }
+}
+
+std::optional<VTUReader::Array> VTUReader::find(const std::string& name) const {
+  for (const auto& array : arrays) {
+    if (array.name == name) {
+      return array;
+    }
+  }
+  return std::nullopt;
+}
+
+void VTUReader::read(const Array& array, const std::size_t first, const std::size_t count, double* values) const {
+  const std::size_t size = typeSize(array.type);
+  std::vector<char> bytes(count * array.components * size);
+  file.seekg(static_cast<std::streamoff>(array.offset + first * array.components * size));
+  if (not file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+    file.clear();
+    throw std::runtime_error(filename + " is truncated");
+  }
+  for (std::size_t i = 0; i < count * array.components; i++) {
+    values[i] = toDouble(array.type, bytes.data() + i * size);
+  }
+}
+
+std::vector<double> VTUReader::readArray(const std::string& name) const {
+  const auto array = find(name);
+  if (not array) {
+    throw std::runtime_error(filename + " has no array " + name);
+  }
+  std::vector<double> values(points * array->components);
+  read(*array, 0, points, values.data());
+  return values;
+}
+
+std::array<double, 3> VTUReader::readTuple(const Array& array, const std::size_t index) const {
+  std::array<double, 3> values{};
+  if (array.components > values.size()) {
+    throw std::runtime_error("Array " + array.name + " has more than 3 components");
+  }
+  read(array, index, 1, values.data());
+  return values;
+}
+
+std::vector<Particle> VTUReader::readParticles() const {
+  const std::vector<double> x = readArray("points");
+  const std::vector<double> v = readArray("velocity");
+  const std::vector<double> f = readArray("force");
+  const std::vector<double> m = readArray("mass");
+  const std::vector<double> type = readArray("type");
+  const std::vector<double> id = find("id") ? readArray("id") : std::vector<double>{};
+
+  std::vector<Particle> particles;
+  particles.reserve(points);
+  for (std::size_t i = 0; i < points; i++) {
+    auto& p = particles.emplace_back(std::array<double, 3>{x[3 * i], x[3 * i + 1], x[3 * i + 2]},
+                                     std::array<double, 3>{v[3 * i], v[3 * i + 1], v[3 * i + 2]}, m[i],
+                                     static_cast<int>(type[i]));
+    p.setF({f[3 * i], f[3 * i + 1], f[3 * i + 2]});
+    p.setId(id.empty() ? i : static_cast<std::size_t>(id[i]));
+  }
+  return particles;
+}
@@ -0,0 +1,260 @@
+#include "io/VTUWriter.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+namespace outputWriter {
+
+namespace {
+/**
+ * @brief Point data arrays of every file, as (type, name, number of components, ASCII value of a particle)
+ */
+struct ArrayDescription {
+  const char* type;
+  const char* name;
+  int components;
+  void (*writeAscii)(std::ostream& out, const Particle& p);
+};
+constexpr ArrayDescription pointDataArrays[] = {
+    {"Float32", "mass", 1, [](std::ostream& out, const Particle& p) { out << static_cast<float>(p.getM()); }},
+    {"Float32", "velocity", 3,
+     [](std::ostream& out, const Particle& p) { out << p.getV()[0] << ' ' << p.getV()[1] << ' ' << p.getV()[2]; }},
+    {"Float32", "force", 3,
+     [](std::ostream& out, const Particle& p) { out << p.getF()[0] << ' ' << p.getF()[1] << ' ' << p.getF()[2]; }},
+    {"Int32", "type", 1, [](std::ostream& out, const Particle& p) { out << p.getType(); }},
+    {"UInt64", "id", 1, [](std::ostream& out, const Particle& p) { out << p.getId(); }}};
+
+/**
+ * @brief Byte order of the host, which the binary blocks are written in
+ */
+const char* byteOrder() {
+  const std::uint16_t probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1 ? "LittleEndian" : "BigEndian";
+}
+
+/**
+ * @brief Writes all buffers to the file, resuming after partial writes and splitting at IOV_MAX buffers
+ */
+bool writeAll(const int fd, std::vector<iovec>& buffers) {
+  std::size_t first = 0;
+  while (first < buffers.size()) {
+    const auto chunk = static_cast<int>(std::min<std::size_t>(buffers.size() - first, IOV_MAX));
+    ssize_t written = ::writev(fd, buffers.data() + first, chunk);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    while (first < buffers.size() and static_cast<std::size_t>(written) >= buffers[first].iov_len) {
+      written -= static_cast<ssize_t>(buffers[first].iov_len);
+      first++;
+    }
+    if (written > 0) {
+      buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) + written;
+      buffers[first].iov_len -= static_cast<std::size_t>(written);
+    }
+  }
+  return true;
+}
+}  // namespace
+
+void VTUWriter::plotParticles(const ParticleContainer& particles, const std::string& filename, const int iteration,
+                              const std::string& outputDirectory) {
+  try {
+    std::filesystem::create_directories(outputDirectory);
+  } catch (const std::filesystem::filesystem_error& err) {
+    SPDLOG_ERROR("Error while creating directory {}:{}", outputDirectory, err.what());
+    return;
+  }
+  std::stringstream strstr;
+  strstr << outputDirectory << "/" << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".vtu";
+  writeAppended(particles.size() > 0 ? &particles[0] : nullptr, particles.size(), strstr.str());
+}
+
+bool VTUWriter::writeAppended(const Particle* particles, const std::size_t count, const std::string& filename) {
+  // structure of arrays in the layout of the file
+  std::vector<float> mass(count);
+  std::vector<float> velocity(3 * count);
+  std::vector<float> force(3 * count);
+  std::vector<std::int32_t> type(count);
+  std::vector<std::uint64_t> id(count);
+  std::vector<double> points(3 * count);
+  for (std::size_t i = 0; i < count; i++) {
+    const Particle& p = particles[i];
+    mass[i] = static_cast<float>(p.getM());
+    for (std::size_t d = 0; d < 3; d++) {
+      velocity[3 * i + d] = static_cast<float>(p.getV()[d]);
+      force[3 * i + d] = static_cast<float>(p.getF()[d]);
+      points[3 * i + d] = p.getX()[d];
+    }
+    type[i] = p.getType();
+    id[i] = p.getId();
+  }
+
+  // point data in the order of pointDataArrays, then the points and the empty cell arrays
+  struct Block {
+    void* data;
+    std::uint64_t bytes;
+  };
+  std::array<Block, 9> blocks{{{mass.data(), count * sizeof(float)},
+                               {velocity.data(), 3 * count * sizeof(float)},
+                               {force.data(), 3 * count * sizeof(float)},
+                               {type.data(), count * sizeof(std::int32_t)},
+                               {id.data(), count * sizeof(std::uint64_t)},
+                               {points.data(), 3 * count * sizeof(double)},
+                               {nullptr, 0},
+                               {nullptr, 0},
+                               {nullptr, 0}}};
+  // every block is preceded by its size, offsets are relative to the '_' starting the appended data
+  std::array<std::uint64_t, blocks.size()> offsets{};
+  for (std::size_t b = 1; b < blocks.size(); b++) {
+    offsets[b] = offsets[b - 1] + sizeof(std::uint64_t) + blocks[b - 1].bytes;
+  }
+
+  std::stringstream header;
+  header << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"" << byteOrder()
+         << "\" header_type=\"UInt64\">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << count << "\" NumberOfCells=\"0\">\n"
+         << "      <PointData>\n";
+  std::size_t b = 0;
+  for (const auto& array : pointDataArrays) {
+    header << "        <DataArray type=\"" << array.type << "\" Name=\"" << array.name << "\" NumberOfComponents=\""
+           << array.components << "\" format=\"appended\" offset=\"" << offsets[b] << "\"/>\n";
+    b++;
+  }
+  header << "      </PointData>\n"
+         << "      <Points>\n"
+         << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\""
+         << offsets[b] << "\"/>\n"
+         << "      </Points>\n"
+         << "      <Cells>\n"
+         << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << offsets[b + 1]
+         << "\"/>\n"
+         << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << offsets[b + 2]
+         << "\"/>\n"
+         << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offsets[b + 3]
+         << "\"/>\n"
+         << "      </Cells>\n"
+         << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\"raw\">\n"
+         << "_";
+  std::string head = header.str();
+  std::string tail = "\n  </AppendedData>\n</VTKFile>\n";
+
+  std::vector<iovec> buffers;
+  buffers.reserve(2 * blocks.size() + 2);
+  buffers.push_back({head.data(), head.size()});
+  for (auto& block : blocks) {
+    buffers.push_back({&block.bytes, sizeof(block.bytes)});
+    if (block.bytes > 0) {
+      buffers.push_back({block.data, block.bytes});
+    }
+  }
+  buffers.push_back({tail.data(), tail.size()});
+
+  const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    SPDLOG_ERROR("Could not open {}", filename);
+    return false;
+  }
+  const bool written = writeAll(fd, buffers);
+  if (::close(fd) != 0 or not written) {
+    SPDLOG_ERROR("Could not write {}", filename);
+    return false;
+  }
+  return true;
+}
+
+bool VTUWriter::writeAscii(const std::vector<Particle>& particles, const std::string& filename) {
+  return writeAscii(particles.data(), particles.size(), filename);
+}
+
+bool VTUWriter::writeMaster(const std::string& filename, const std::vector<std::string>& pieceSources) {
+  std::ofstream file(filename);
+  if (not file) {
+    SPDLOG_ERROR("Could not open {}", filename);
+    return false;
+  }
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"" << byteOrder() << "\">\n"
+       << "  <PUnstructuredGrid GhostLevel=\"0\">\n"
+       << "    <PPointData>\n";
+  for (const auto& array : pointDataArrays) {
+    file << "      <PDataArray type=\"" << array.type << "\" Name=\"" << array.name << "\" NumberOfComponents=\""
+         << array.components << "\"/>\n";
+  }
+  file << "    </PPointData>\n"
+       << "    <PPoints>\n"
+       << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+       << "    </PPoints>\n";
+  for (const auto& source : pieceSources) {
+    file << "    <Piece Source=\"" << source << "\"/>\n";
+  }
+  file << "  </PUnstructuredGrid>\n"
+       << "</VTKFile>\n";
+  return static_cast<bool>(file);
+}
+
+bool VTUWriter::writeAscii(const Particle* particles, const std::size_t count, const std::string& filename) {
+  const Particle* const first = particles;
+  const Particle* const last = particles + count;
+  std::ofstream file(filename);
+  if (not file) {
+    SPDLOG_ERROR("Could not open {}", filename);
+    return false;
+  }
+  file.precision(std::numeric_limits<double>::max_digits10);
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n"
+       << "  <UnstructuredGrid>\n"
+       << "    <Piece NumberOfPoints=\"" << count << "\" NumberOfCells=\"0\">\n"
+       << "      <PointData>\n";
+
+  for (const auto& array : pointDataArrays) {
+    file << "        <DataArray type=\"" << array.type << "\" Name=\"" << array.name << "\" NumberOfComponents=\""
+         << array.components << "\" format=\"ascii\">\n";
+    for (const Particle* p = first; p != last; ++p) {
+      array.writeAscii(file, *p);
+      file << '\n';
+    }
+    file << "        </DataArray>\n";
+  }
+  file << "      </PointData>\n"
+       << "      <Points>\n"
+       << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n";
+  for (const Particle* p = first; p != last; ++p) {
+    file << p->getX()[0] << ' ' << p->getX()[1] << ' ' << p->getX()[2] << '\n';
+  }
+  file << "        </DataArray>\n"
+       << "      </Points>\n"
+       << "      <Cells>\n"
+       << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\"/>\n"
+       << "        <DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\"/>\n"
+       << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\"/>\n"
+       << "      </Cells>\n"
+       << "    </Piece>\n"
+       << "  </UnstructuredGrid>\n"
+       << "</VTKFile>\n";
+  return static_cast<bool>(file);
+}
+
+}  // namespace outputWriter
@@ -7,52 +7,78 @@
 
 #include "io/XYZWriter.h"
 
+#include <charconv>
 #include <filesystem>
 #include <iomanip>
-#include <iostream>
 #include <sstream>
 
 #include <spdlog/spdlog.h>
 
 namespace outputWriter {
 
-XYZWriter::XYZWriter() = default;
-
-XYZWriter::~XYZWriter() = default;
+namespace {
+/**
+ * @brief Upper bound of the length of a particle line, the shortest round trip representation of a double has at
+ * most 24 characters
+ */
+constexpr std::size_t maxLineLength = 3 + 3 * (24 + 1) + 1;
+}  // namespace
 
-void XYZWriter::plotParticles(const std::vector<Particle>& particles, const std::string& filename, int iteration) {
-  // create separate output directory
-  const std::string output_directory = "output";
-  try {
-    std::filesystem::create_directories(output_directory);
-  } catch (const std::filesystem::filesystem_error& err) {
-    SPDLOG_ERROR("Error while creating directory {}:{}", output_directory, err.what());
-    return;
+XYZWriter::XYZWriter(const std::string& filename, const bool append) {
+  const std::filesystem::path path(filename);
+  if (path.has_parent_path()) {
+    try {
+      std::filesystem::create_directories(path.parent_path());
+    } catch (const std::filesystem::filesystem_error& err) {
+      SPDLOG_ERROR("Error while creating directory {}:{}", path.parent_path().string(), err.what());
+    }
   }
+  file.open(filename, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+  if (not file) {
+    SPDLOG_ERROR("Could not open {}", filename);
+  }
+}
+
+bool XYZWriter::appendFrame(const ParticleContainer& particles, const int iteration) {
+  buffer.clear();
+  formatFrame(particles.size() > 0 ? &particles[0] : nullptr, particles.size(), iteration, buffer);
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  file.flush();
+  return static_cast<bool>(file);
+}
 
-  std::ofstream file;
+void XYZWriter::plotParticles(const ParticleContainer& particles, const std::string& filename, int iteration,
+                              const std::string& output_directory) {
   std::stringstream strstr;
   strstr << output_directory << "/" << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".xyz";
+  XYZWriter writer(strstr.str());
+  if (not writer.appendFrame(particles, iteration)) {
+    SPDLOG_ERROR("Could not write {}", strstr.str());
+  }
+}
 
-  file.open(strstr.str().c_str());
-  file << particles.size() << std::endl;
-  file << "Generated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for "
-          "file format doku."
-       << std::endl;
-
-  for (auto& p : particles) {
-    std::array<double, 3> x = p.getX();
-    file << "Ar ";
-    file.setf(std::ios_base::showpoint);
+void XYZWriter::formatFrame(const Particle* particles, const std::size_t count, const int iteration,
+                            std::string& buffer) {
+  buffer += std::to_string(count);
+  buffer += "\nGenerated by MolSim, iteration ";
+  buffer += std::to_string(iteration);
+  buffer += '\n';
 
-    for (auto& xi : x) {
-      file << xi << " ";
+  // format into a tail of the maximum frame length and cut it to the written length afterwards
+  const std::size_t start = buffer.size();
+  buffer.resize(start + count * maxLineLength);
+  char* out = buffer.data() + start;
+  char* const end = buffer.data() + buffer.size();
+  for (std::size_t i = 0; i < count; i++) {
+    *out++ = 'A';
+    *out++ = 'r';
+    for (const double x : particles[i].getX()) {
+      *out++ = ' ';
+      out = std::to_chars(out, end, x).ptr;
     }
-
-    file << std::endl;
+    *out++ = '\n';
   }
-
-  file.close();
+  buffer.resize(out - buffer.data());
 }
 
 }  // namespace outputWriter
@@ -1,4 +1,6 @@
+#include "Ensemble.h"
 #include "Simulation.h"
+#include "SimulationOptions.h"
 
 #include <iostream>
 
@@ -7,29 +9,30 @@
 #endif                                          // SPDLOG_ACTIVE_LEVEL
 #include "spdlog/spdlog.h"
 
-int main(const int argc, char* argsv[]) {
-  SPDLOG_INFO("Hello from MolSim for PSE!");
-  // Read arguments from the command line
-  if (argc != 7) {
-    SPDLOG_ERROR("Erroneous programme call!");
-    SPDLOG_ERROR(
-        "./MolSim filename t_end delta_t [file | benchmark] [off | error | debug | trace | info] [P:OFF | "
-        "P:ON]");
-    return 1;
-  }
-
-  SimulationMode simulation_mode;
-  if (std::string mode_arg = argsv[4]; mode_arg == "file") {
+namespace {
+/**
+ * @brief Parses the simulation mode argument
+ * @return false if the argument is invalid
+ */
+bool parseSimulationMode(const std::string& mode_arg, SimulationMode& simulation_mode) {
+  if (mode_arg == "file") {
     simulation_mode = SimulationMode::FILE_OUTPUT;
   } else if (mode_arg == "benchmark") {
     simulation_mode = SimulationMode::BENCHMARK;
   } else {
     SPDLOG_ERROR("Invalid simulation mode provided: {}", mode_arg);
     SPDLOG_ERROR("Please use 'file' or 'benchmark'");
-    return 1;
+    return false;
   }
+  return true;
+}
 
-  if (std::string log_level = argsv[5]; log_level == "info") {
+/**
+ * @brief Parses the log level argument and applies it
+ * @return false if the argument is invalid
+ */
+bool parseLogLevel(const std::string& log_level) {
+  if (log_level == "info") {
     spdlog::set_level(spdlog::level::info);
   } else if (log_level == "off") {
     spdlog::set_level(spdlog::level::off);
@@ -43,17 +46,100 @@ int main(const int argc, char* argsv[]) {
     spdlog::set_level(spdlog::level::trace);
   } else {
     SPDLOG_ERROR("Invalid log level. Valid options are off, error, warn, info, debug and trace.");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Runs all simulations of an ensemble manifest: ./MolSim ensemble manifest [file | benchmark] [log level]
+ * [LARGE:<particles>]
+ */
+int runEnsemble(const int argc, char* argsv[]) {
+  if (argc < 5) {
+    SPDLOG_ERROR("Erroneous programme call!");
+    SPDLOG_ERROR(
+        "./MolSim ensemble manifest [file | benchmark] [off | error | debug | trace | info] [LARGE:<particles>]");
+    return 1;
+  }
+  SimulationMode simulation_mode;
+  if (not parseSimulationMode(argsv[3], simulation_mode) or not parseLogLevel(argsv[4])) {
     return 1;
   }
 
-  if (std::string parallelization = argsv[6]; parallelization == "P:OFF") {
-    CollisionSimulation simulation(argsv[1], std::stod(argsv[2]), std::stod(argsv[3]), simulation_mode);
-    simulation.run();
-  } else if (parallelization == "P:ON") {
-    CollisionSimulationParallel simulation(argsv[1], std::stod(argsv[2]), std::stod(argsv[3]), simulation_mode);
-    simulation.run();
-  } else {
-    SPDLOG_ERROR("Invalid parallelization option. Valid options are P:OFF and P:ON.");
+  std::size_t large_particles = 2000;
+  for (int i = 5; i < argc; i++) {
+    if (std::string option = argsv[i]; option.rfind("LARGE:", 0) == 0) {
+      try {
+        large_particles = std::stoul(option.substr(6));
+      } catch (const std::logic_error&) {
+        SPDLOG_ERROR("Invalid option: {}", option);
+        return 1;
+      }
+    } else {
+      SPDLOG_ERROR("Invalid option: {}", option);
+      return 1;
+    }
+  }
+
+  std::vector<EnsembleMember> members;
+  try {
+    members = EnsembleRunner::readManifest(argsv[2]);
+  } catch (const std::invalid_argument& err) {
+    SPDLOG_ERROR("Invalid ensemble manifest: {}", err.what());
+    return 1;
+  }
+  EnsembleRunner runner(std::move(members), simulation_mode, "output", large_particles);
+  return runner.run() ? 0 : 1;
+}
+}  // namespace
+
+int main(const int argc, char* argsv[]) {
+  SPDLOG_INFO("Hello from MolSim for PSE!");
+  if (argc > 1 and std::string(argsv[1]) == "ensemble") {
+    return runEnsemble(argc, argsv);
+  }
+
+  // Read arguments from the command line
+  if (argc < 7) {
+    SPDLOG_ERROR("Erroneous programme call!");
+    SPDLOG_ERROR(
+        "./MolSim filename t_end delta_t [file | benchmark] [off | error | debug | trace | info] [P:OFF "
+        "[CLUSTER:4|8 [SLEEP:<steps>[,<displacement>,<force change>][,verify][,strict]]] | P:ON | P:DET | P:AUTO "
+        "[AUTOTUNE:<interval>]] [BC:<faces> DOMAIN:<x0,y0,z0,x1,y1,z1>] [SORT:TYPE] [CACHE:<directory>[,refresh]] "
+        "[SCHEDULE:GUIDED|STEAL] [INTEGRATOR:VERLET|FOREST_RUTH] [ANALYSIS:<interval>[,csv|,bin]] "
+        "[FRAMES:iterations|time|budget|change,<value>] "
+        "[OUTPUT:vtu|vtk|xyz[,single]|compressed[,<precision>]|pvtu[,<pieces>]|live[,<name>]]");
+    SPDLOG_ERROR(
+        "./MolSim ensemble manifest [file | benchmark] [off | error | debug | trace | info] [LARGE:<particles>]");
+    return 1;
+  }
+
+  SimulationMode simulation_mode;
+  if (not parseSimulationMode(argsv[4], simulation_mode) or not parseLogLevel(argsv[5])) {
+    return 1;
+  }
+
+  if (std::string parallelization = argsv[6]; parallelization != "P:OFF" and parallelization != "P:ON" and
+                                             parallelization != "P:DET" and parallelization != "P:AUTO") {
+    SPDLOG_ERROR("Invalid parallelization option. Valid options are P:OFF, P:ON, P:DET and P:AUTO.");
+    return 1;
+  }
+
+  // Optional arguments
+  SimulationOptions options;
+  try {
+    options = SimulationOptions::parse(std::vector<std::string>(argsv + 6, argsv + argc));
+  } catch (const std::invalid_argument& err) {
+    SPDLOG_ERROR("{}", err.what());
+    return 1;
+  }
+
+  try {
+    options.createSimulation(argsv[1], std::stod(argsv[2]), std::stod(argsv[3]), simulation_mode)->run();
+  } catch (const std::runtime_error& err) {
+    SPDLOG_ERROR("{}", err.what());
+    return 1;
   }
 
   return 0;
@@ -0,0 +1,187 @@
+#include "utils/Compression.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace utils {
+
+namespace {
+constexpr std::size_t alphabetSize = 256;
+constexpr unsigned maxCodeLength = 15;
+constexpr std::size_t lengthTableSize = alphabetSize / 2;
+
+/**
+ * @brief Huffman code lengths of all byte values, limited to maxCodeLength by flattening the frequencies
+ */
+std::array<std::uint8_t, alphabetSize> codeLengths(std::array<std::uint64_t, alphabetSize> frequencies) {
+  std::array<std::uint8_t, alphabetSize> lengths{};
+  const auto used = static_cast<std::size_t>(
+      std::count_if(frequencies.begin(), frequencies.end(), [](std::uint64_t f) { return f > 0; }));
+  if (used == 0) {
+    return lengths;
+  }
+  if (used == 1) {
+    for (std::size_t s = 0; s < alphabetSize; s++) {
+      lengths[s] = frequencies[s] > 0 ? 1 : 0;
+    }
+    return lengths;
+  }
+
+  while (true) {
+    // nodes 0..255 are leaves, the following ones inner nodes
+    std::vector<std::size_t> parent(2 * alphabetSize, 0);
+    using Node = std::pair<std::uint64_t, std::size_t>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<>> queue;
+    for (std::size_t s = 0; s < alphabetSize; s++) {
+      if (frequencies[s] > 0) {
+        queue.emplace(frequencies[s], s);
+      }
+    }
+    std::size_t next = alphabetSize;
+    while (queue.size() > 1) {
+      const auto [weightA, nodeA] = queue.top();
+      queue.pop();
+      const auto [weightB, nodeB] = queue.top();
+      queue.pop();
+      parent[nodeA] = next;
+      parent[nodeB] = next;
+      queue.emplace(weightA + weightB, next++);
+    }
+    const std::size_t root = next - 1;
+
+    unsigned longest = 0;
+    for (std::size_t s = 0; s < alphabetSize; s++) {
+      if (frequencies[s] == 0) {
+        continue;
+      }
+      unsigned depth = 0;
+      for (std::size_t node = s; node != root; node = parent[node]) {
+        depth++;
+      }
+      lengths[s] = static_cast<std::uint8_t>(std::min(depth, 255u));
+      longest = std::max(longest, depth);
+    }
+    if (longest <= maxCodeLength) {
+      return lengths;
+    }
+    // too skewed: flatten the distribution and try again
+    for (auto& f : frequencies) {
+      if (f > 0) {
+        f = std::max<std::uint64_t>(1, f >> 1);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Symbols ordered by code length and value, the order in which canonical codes are assigned
+ */
+std::vector<std::uint8_t> canonicalOrder(const std::array<std::uint8_t, alphabetSize>& lengths) {
+  std::vector<std::uint8_t> symbols;
+  for (std::size_t s = 0; s < alphabetSize; s++) {
+    if (lengths[s] > 0) {
+      symbols.push_back(static_cast<std::uint8_t>(s));
+    }
+  }
+  std::stable_sort(symbols.begin(), symbols.end(),
+                   [&lengths](std::uint8_t a, std::uint8_t b) { return lengths[a] < lengths[b]; });
+  return symbols;
+}
+}  // namespace
+
+std::vector<std::uint8_t> huffmanEncode(const std::vector<std::uint8_t>& data) {
+  std::array<std::uint64_t, alphabetSize> frequencies{};
+  for (const std::uint8_t byte : data) {
+    frequencies[byte]++;
+  }
+  const auto lengths = codeLengths(frequencies);
+
+  std::vector<std::uint8_t> out(lengthTableSize);
+  for (std::size_t s = 0; s < alphabetSize; s += 2) {
+    out[s / 2] = static_cast<std::uint8_t>(lengths[s] << 4 | lengths[s + 1]);
+  }
+
+  // canonical codes
+  std::array<std::uint32_t, alphabetSize> codes{};
+  std::uint32_t code = 0;
+  unsigned previousLength = 0;
+  for (const std::uint8_t symbol : canonicalOrder(lengths)) {
+    code <<= lengths[symbol] - previousLength;
+    codes[symbol] = code++;
+    previousLength = lengths[symbol];
+  }
+
+  std::uint64_t buffer = 0;
+  unsigned bits = 0;
+  out.reserve(out.size() + data.size() / 2);
+  for (const std::uint8_t byte : data) {
+    buffer = buffer << lengths[byte] | codes[byte];
+    bits += lengths[byte];
+    while (bits >= 8) {
+      bits -= 8;
+      out.push_back(static_cast<std::uint8_t>(buffer >> bits));
+    }
+  }
+  if (bits > 0) {
+    out.push_back(static_cast<std::uint8_t>(buffer << (8 - bits)));
+  }
+  return out;
+}
+
+std::vector<std::uint8_t> huffmanDecode(const std::vector<std::uint8_t>& encoded, const std::size_t size) {
+  if (encoded.size() < lengthTableSize) {
+    throw std::runtime_error("Huffman data is missing its code lengths");
+  }
+  std::array<std::uint8_t, alphabetSize> lengths{};
+  for (std::size_t s = 0; s < alphabetSize; s += 2) {
+    lengths[s] = encoded[s / 2] >> 4;
+    lengths[s + 1] = encoded[s / 2] & 0x0f;
+  }
+  const std::vector<std::uint8_t> symbols = canonicalOrder(lengths);
+
+  // first canonical code and index into symbols for every code length
+  std::array<std::uint32_t, maxCodeLength + 1> count{};
+  for (const std::uint8_t symbol : symbols) {
+    count[lengths[symbol]]++;
+  }
+  std::array<std::uint32_t, maxCodeLength + 2> firstCode{};
+  std::array<std::uint32_t, maxCodeLength + 2> firstIndex{};
+  std::uint32_t code = 0;
+  std::uint32_t index = 0;
+  for (unsigned length = 1; length <= maxCodeLength; length++) {
+    code = (code + count[length - 1]) << 1;
+    firstCode[length] = code;
+    firstIndex[length] = index;
+    index += count[length];
+  }
+
+  std::vector<std::uint8_t> out;
+  out.reserve(size);
+  std::size_t position = lengthTableSize;
+  unsigned bit = 0;
+  while (out.size() < size) {
+    std::uint32_t current = 0;
+    unsigned length = 0;
+    while (true) {
+      if (position >= encoded.size() or length == maxCodeLength) {
+        throw std::runtime_error("Corrupt Huffman data");
+      }
+      current = current << 1 | ((encoded[position] >> (7 - bit)) & 1);
+      if (++bit == 8) {
+        bit = 0;
+        position++;
+      }
+      length++;
+      if (current - firstCode[length] < count[length]) {
+        out.push_back(symbols[firstIndex[length] + current - firstCode[length]]);
+        break;
+      }
+    }
+  }
+  return out;
+}
+
+}  // namespace utils
@@ -0,0 +1,92 @@
+#include "utils/MemoryStats.h"
+
+#include <linux/perf_event.h>
+#include <omp.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace utils {
+
+namespace {
+int openDtlbCounter() {
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // count the OpenMP worker threads as well
+  attr.inherit = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+long readAnonHugePagesKB() {
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  std::string line;
+  while (std::getline(smaps, line)) {
+    if (line.rfind("AnonHugePages:", 0) == 0) {
+      std::istringstream stream(line.substr(std::strlen("AnonHugePages:")));
+      long kb = -1;
+      stream >> kb;
+      return kb;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Resource usage of the calling thread inside a parallel region, e.g. of a serial ensemble member, and of the
+ * whole process otherwise
+ */
+rusage readUsage() {
+  rusage usage{};
+  getrusage(omp_in_parallel() ? RUSAGE_THREAD : RUSAGE_SELF, &usage);
+  return usage;
+}
+}  // namespace
+
+MemoryStatsRecorder::~MemoryStatsRecorder() {
+  if (dtlbFd >= 0) {
+    close(dtlbFd);
+  }
+}
+
+void MemoryStatsRecorder::start() {
+  if (dtlbFd < 0) {
+    dtlbFd = openDtlbCounter();
+  }
+  if (dtlbFd >= 0) {
+    ioctl(dtlbFd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(dtlbFd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  const rusage usage = readUsage();
+  startMinorFaults = usage.ru_minflt;
+  startMajorFaults = usage.ru_majflt;
+}
+
+MemoryStats MemoryStatsRecorder::stop() {
+  MemoryStats stats;
+  if (dtlbFd >= 0) {
+    ioctl(dtlbFd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(dtlbFd, &count, sizeof(count)) == sizeof(count)) {
+      stats.dtlbLoadMisses = count;
+    }
+  }
+  const rusage usage = readUsage();
+  stats.minorPageFaults = usage.ru_minflt - startMinorFaults;
+  stats.majorPageFaults = usage.ru_majflt - startMajorFaults;
+  stats.anonHugePagesKB = readAnonHugePagesKB();
+  return stats;
+}
+
+}  // namespace utils
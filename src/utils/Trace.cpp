@@ -0,0 +1,171 @@
+#include "utils/Trace.h"
+
+#include <omp.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <utility>
+
+namespace utils::trace {
+
+namespace {
+/**
+ * @brief Buffers of all threads that recorded, kept until exit since the trace is written after the threads ended
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+/**
+ * @brief Incremented by reset(), buffers of older generations are no longer registered
+ */
+std::atomic<unsigned> generation{0};
+
+/**
+ * @brief Thread that initialized the library, the one that runs main() and becomes OpenMP thread 0
+ */
+const std::thread::id mainThread = std::this_thread::get_id();
+
+/**
+ * @brief Offset of the trace ids of threads outside of OpenMP, so they do not share a lane with an OpenMP thread
+ */
+constexpr int otherThreads = 1000;
+
+#ifdef ENABLE_TRACING
+void writeAtExit() {
+  const char* variable = std::getenv("MOLSIM_TRACE");
+  const std::string path = variable ? variable : "molsim_trace.json";
+  std::ofstream file(path);
+  writeChromeTrace(file);
+  if (file) {
+    SPDLOG_INFO("Wrote trace to {}", path);
+  } else {
+    SPDLOG_ERROR("Could not write trace to {}", path);
+  }
+}
+#endif  // ENABLE_TRACING
+
+void writeString(std::ostream& out, const std::string& text) {
+  out << '"';
+  for (const char c : text) {
+    if (c == '"' or c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+/**
+ * @brief Writes a non-negative duration in nanoseconds as microseconds, the time unit of the format
+ */
+void writeMicroseconds(std::ostream& out, const std::int64_t nanoseconds) {
+  const std::string fraction = std::to_string(1000 + nanoseconds % 1000);
+  out << nanoseconds / 1000 << '.' << fraction.substr(1);
+}
+}  // namespace
+
+ThreadBuffer::ThreadBuffer(const int id, std::string name) : id(id), name(std::move(name)) {}
+
+std::vector<Event> ThreadBuffer::snapshot() const {
+  const std::uint64_t n = recorded.load(std::memory_order_acquire);
+  const std::uint64_t first = n > capacity ? n - capacity : 0;
+  std::vector<Event> result;
+  result.reserve(n - first);
+  for (std::uint64_t i = first; i < n; i++) {
+    result.push_back(events[i % capacity]);
+  }
+  return result;
+}
+
+std::uint64_t ThreadBuffer::dropped() const {
+  const std::uint64_t n = recorded.load(std::memory_order_acquire);
+  return n > capacity ? n - capacity : 0;
+}
+
+std::int64_t now() noexcept {
+  using Clock = std::chrono::steady_clock;
+  static const Clock::time_point epoch = Clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+ThreadBuffer& threadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  thread_local unsigned bufferGeneration = 0;
+  if (not buffer or bufferGeneration != generation.load(std::memory_order_relaxed)) {
+    auto& [mutex, buffers] = registry();
+    const std::lock_guard lock(mutex);
+#ifdef ENABLE_TRACING
+    static const bool scheduled = std::atexit(writeAtExit) == 0;
+    static_cast<void>(scheduled);
+#endif  // ENABLE_TRACING
+    // the OpenMP thread number is stable, no matter whether the first event is recorded inside a parallel region
+    int id;
+    std::string name;
+    if (omp_in_parallel() or std::this_thread::get_id() == mainThread) {
+      id = omp_get_thread_num();
+      name = "OpenMP thread " + std::to_string(id);
+    } else {
+      id = otherThreads + static_cast<int>(buffers.size());
+      name = "thread " + std::to_string(id);
+    }
+    buffers.push_back(std::make_unique<ThreadBuffer>(id, name));
+    buffer = buffers.back().get();
+    bufferGeneration = generation.load(std::memory_order_relaxed);
+  }
+  return *buffer;
+}
+
+void reset() {
+  auto& [mutex, buffers] = registry();
+  const std::lock_guard lock(mutex);
+  buffers.clear();
+  generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void writeChromeTrace(std::ostream& out) {
+  auto& [mutex, buffers] = registry();
+  const std::lock_guard lock(mutex);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  const auto separator = [&] {
+    out << (first ? "\n" : ",\n");
+    first = false;
+  };
+  for (const auto& buffer : buffers) {
+    separator();
+    out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->getId() << R"(,"args":{"name":)";
+    writeString(out, buffer->getName());
+    out << "}}";
+    if (buffer->dropped() > 0) {
+      SPDLOG_WARN("Trace of {} lost its {} oldest events", buffer->getName(), buffer->dropped());
+    }
+    for (const auto& event : buffer->snapshot()) {
+      separator();
+      out << "{\"name\":";
+      writeString(out, event.name);
+      out << R"(,"ph":"X","pid":1,"tid":)" << buffer->getId() << ",\"ts\":";
+      writeMicroseconds(out, event.begin);
+      out << ",\"dur\":";
+      writeMicroseconds(out, event.end - event.begin);
+      out << '}';
+    }
+  }
+  out << "\n]}\n";
+}
+
+}  // namespace utils::trace
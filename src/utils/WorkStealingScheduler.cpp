@@ -0,0 +1,112 @@
+#include "utils/WorkStealingScheduler.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace utils {
+
+namespace {
+constexpr std::uint64_t pack(const std::uint64_t begin, const std::uint64_t end) {
+  return begin << 32 | end;
+}
+constexpr std::uint64_t rangeBegin(const std::uint64_t range) {
+  return range >> 32;
+}
+constexpr std::uint64_t rangeEnd(const std::uint64_t range) {
+  return range & 0xffffffffu;
+}
+}  // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(const int threads)
+    : threads(threads > 0 ? threads : omp_get_max_threads()), ranges(new TaskRange[this->threads]) {}
+
+bool WorkStealingScheduler::pop(const int thread, std::size_t& task) {
+  auto& own = ranges[thread].range;
+  std::uint64_t range = own.load(std::memory_order_acquire);
+  while (rangeBegin(range) < rangeEnd(range)) {
+    if (own.compare_exchange_weak(range, pack(rangeBegin(range) + 1, rangeEnd(range)), std::memory_order_acq_rel)) {
+      task = rangeBegin(range);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t WorkStealingScheduler::steal(const int thread) {
+  for (int offset = 1; offset < threads; offset++) {
+    auto& victim = ranges[(thread + offset) % threads].range;
+    std::uint64_t range = victim.load(std::memory_order_acquire);
+    while (rangeBegin(range) < rangeEnd(range)) {
+      const std::uint64_t begin = rangeBegin(range);
+      const std::uint64_t end = rangeEnd(range);
+      // the victim keeps the front half, which it is working towards
+      const std::uint64_t middle = begin + (end - begin) / 2;
+      if (victim.compare_exchange_weak(range, pack(begin, middle), std::memory_order_acq_rel)) {
+        ranges[thread].range.store(pack(middle, end), std::memory_order_release);
+        return end - middle;
+      }
+    }
+  }
+  return 0;
+}
+
+void WorkStealingScheduler::run(const std::size_t tasks, const std::function<void(std::size_t, int)>& task,
+                                std::vector<ThreadLoad>* loads) {
+  if (tasks > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("Too many tasks for the work stealing scheduler");
+  }
+  // contiguous initial ranges, the first tasks % threads ranges being one task longer
+  const std::size_t base = tasks / threads;
+  const std::size_t remainder = tasks % threads;
+  std::size_t begin = 0;
+  for (int t = 0; t < threads; t++) {
+    const std::size_t end = begin + base + (static_cast<std::size_t>(t) < remainder ? 1 : 0);
+    ranges[t].range.store(pack(begin, end), std::memory_order_relaxed);
+    begin = end;
+  }
+  if (loads) {
+    loads->resize(std::max(loads->size(), static_cast<std::size_t>(threads)));
+  }
+
+  const double start = omp_get_wtime();
+  std::vector<double> busy(threads, 0.0);
+#pragma omp parallel num_threads(threads)
+  {
+    const int thread = omp_get_thread_num();
+    ThreadLoad load;
+    std::size_t index = 0;
+    // if fewer threads are started than requested, the ranges of the missing ones are stolen
+    std::size_t stolen = 0;
+    do {
+      load.stolenTasks += stolen;
+      while (pop(thread, index)) {
+        const double taskStart = loads ? omp_get_wtime() : 0.0;
+        task(index, thread);
+        if (loads) {
+          load.busySeconds += omp_get_wtime() - taskStart;
+        }
+        load.tasks++;
+      }
+      stolen = steal(thread);
+    } while (stolen > 0);
+
+    if (loads) {
+      busy[thread] = load.busySeconds;
+      ThreadLoad& total = (*loads)[thread];
+      total.busySeconds += load.busySeconds;
+      total.tasks += load.tasks;
+      total.stolenTasks += load.stolenTasks;
+    }
+  }
+  if (loads) {
+    const double elapsed = omp_get_wtime() - start;
+    for (int t = 0; t < threads; t++) {
+      (*loads)[t].idleSeconds += elapsed - busy[t];
+    }
+  }
+}
+
+}  // namespace utils
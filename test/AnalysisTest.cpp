@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "ParticleContainer.h"
+#include "analysis/AnalysisPipeline.h"
+#include "analysis/Observables.h"
+
+class AnalysisTest : public ::testing::Test {
+ protected:
+  analysis::Snapshot snapshot{0, 0.0, {}, {}};
+
+  void SetUp() override {
+    snapshot.particles.emplace_back(std::array<double, 3>{0., 0., 0.}, std::array<double, 3>{1., 0., 0.}, 2.);
+    snapshot.particles.emplace_back(std::array<double, 3>{std::pow(2., 1. / 6.), 0., 0.},
+                                    std::array<double, 3>{0., -2., 0.}, 1.);
+  }
+};
+
+// Tests kinetic energy, temperature and momentum of two particles
+TEST_F(AnalysisTest, KineticObservables) {
+  EXPECT_DOUBLE_EQ(analysis::KineticEnergy().evaluate(snapshot)[0], 3.);
+  EXPECT_DOUBLE_EQ(analysis::Temperature(3).evaluate(snapshot)[0], 1.);
+  EXPECT_DOUBLE_EQ(analysis::Temperature(2).evaluate(snapshot)[0], 1.5);
+  EXPECT_EQ(analysis::Momentum().evaluate(snapshot), (std::vector<double>{2., -2., 0.}));
+}
+
+// Tests that the potential energy at the minimum of the Lennard-Jones potential equals -epsilon
+TEST_F(AnalysisTest, PotentialEnergyMinimum) {
+  EXPECT_NEAR(analysis::PotentialEnergy(MixingTable(5., 1.), 2.5).evaluate(snapshot)[0], -5., 1e-12);
+  EXPECT_EQ(analysis::PotentialEnergy(MixingTable(5., 1.), 1.).evaluate(snapshot)[0], 0.);
+}
+
+// Tests that all pairs end up in the radial distribution histogram
+TEST_F(AnalysisTest, RadialDistributionBins) {
+  analysis::RadialDistribution rdf(2., 4, 3);
+  EXPECT_EQ(rdf.columns().size(), 4);
+  const auto g = rdf.evaluate(snapshot);
+  ASSERT_EQ(g.size(), 4);
+  EXPECT_EQ(g[0], 0.);
+  EXPECT_GT(g[2], 0.);
+  EXPECT_EQ(g[3], 0.);
+
+  // the density of a domain eight times as large is an eighth
+  const auto unitDomain = analysis::RadialDistribution(2., 4, 3, std::array<double, 3>{1., 1., 1.}).evaluate(snapshot);
+  const auto largeDomain = analysis::RadialDistribution(2., 4, 3, std::array<double, 3>{2., 2., 2.}).evaluate(snapshot);
+  EXPECT_DOUBLE_EQ(largeDomain[2], 8. * unitDomain[2]);
+}
+
+// Tests that the pipeline writes one CSV row per due iteration
+TEST_F(AnalysisTest, PipelineWritesSeries) {
+  const std::string directory = testing::TempDir() + "/molsim_analysis_test";
+  std::filesystem::remove_all(directory);
+
+  ParticleContainer pc;
+  for (const auto& p : snapshot.particles) {
+    pc.addParticle(&p);
+  }
+  {
+    analysis::AnalysisPipeline pipeline(directory, 5);
+    pipeline.addObservable(std::make_unique<analysis::KineticEnergy>());
+    for (int iteration = 0; iteration <= 20; iteration++) {
+      if (pipeline.isDue(iteration)) {
+        pipeline.submit(iteration, 0.1 * iteration, pc);
+      }
+    }
+    pipeline.finish();
+  }
+
+  std::ifstream csv(directory + "/kinetic_energy.csv");
+  std::string line;
+  std::getline(csv, line);
+  EXPECT_EQ(line, "iteration,time,E_kin");
+  int rows = 0;
+  while (std::getline(csv, line)) {
+    rows++;
+  }
+  EXPECT_EQ(rows, 5);
+  std::filesystem::remove_all(directory);
+}
+
+// Tests that the pressure uses the virial of the force calculation and is NaN without it
+TEST_F(AnalysisTest, PressureFromVirial) {
+  analysis::Pressure pressure(3);
+  EXPECT_EQ(pressure.columns().size(), 10);
+  EXPECT_TRUE(std::isnan(pressure.evaluate(snapshot)[0]));
+
+  snapshot.particles[1].setX({1., 1., 1.});
+  snapshot.forces.valid = true;
+  snapshot.forces.virial[0][0] = 1.;
+  snapshot.forces.virial[2][2] = 2.;
+  const auto values = pressure.evaluate(snapshot);
+  // E_kin = 3, V = 1
+  EXPECT_DOUBLE_EQ(values[0], (2. * 3. + 3.) / 3.);
+  EXPECT_DOUBLE_EQ(values[1], 1.);
+  EXPECT_DOUBLE_EQ(values[9], 2.);
+
+  // a domain of volume 4 replaces the bounding box
+  analysis::Pressure inDomain(3, std::array<double, 3>{1., 2., 2.});
+  EXPECT_DOUBLE_EQ(inDomain.evaluate(snapshot)[0], (2. * 3. + 3.) / 12.);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include "utils/ArrayExpressions.h"
+#include "utils/ArrayUtils.h"
+
+using ArrayUtils::view;
+using Vector = std::array<double, 3>;
+
+// Tests that fused expressions give bitwise the same result as the temporary creating operators
+TEST(ArrayExpressionsTest, MatchesOperators) {
+  const Vector x{1.5, -2.25, 3.0};
+  const Vector v{0.1, 0.2, -0.3};
+  const Vector f{-4.0, 5.5, 0.75};
+  const double dt = 0.01;
+  const double m = 3.0;
+
+  const Vector expected = x + dt * v + (dt * dt / (2 * m)) * f;
+  EXPECT_EQ(ArrayUtils::eval(view(x) + dt * view(v) + (dt * dt / (2 * m)) * view(f)), expected);
+  EXPECT_EQ(ArrayUtils::eval(view(x) - view(v)), x - v);
+  EXPECT_EQ(ArrayUtils::eval(view(x) * view(v)), x * v);
+  EXPECT_EQ(ArrayUtils::eval(view(x) * 2.0), 2.0 * x);
+  EXPECT_EQ(ArrayUtils::eval(-view(x)), -1.0 * x);
+  EXPECT_EQ(ArrayUtils::norm(view(x)), ArrayUtils::L2Norm(x));
+  EXPECT_EQ(ArrayUtils::dot(view(x), view(v)), 1.5 * 0.1 + -2.25 * 0.2 + 3.0 * -0.3);
+}
+
+// Tests that the target of an assignment may appear in the expression
+TEST(ArrayExpressionsTest, Assign) {
+  Vector x{1., 2., 3.};
+  const Vector v{1., 1., 1.};
+  ArrayUtils::assign(x, view(v) - view(x) + view(x) * view(x));
+  EXPECT_EQ(x, (Vector{1., 3., 7.}));
+  ArrayUtils::addTo(x, 2.0 * view(v));
+  EXPECT_EQ(x, (Vector{3., 5., 9.}));
+}
+
+// Tests that expressions can be evaluated at compile time
+TEST(ArrayExpressionsTest, Constexpr) {
+  static constexpr std::array<int, 2> a{1, 2};
+  static constexpr std::array<int, 2> b{3, 5};
+  constexpr auto sum = ArrayUtils::eval(view(a) + 2 * view(b));
+  static_assert(sum[0] == 7 and sum[1] == 12);
+  static_assert(ArrayUtils::dot(view(a), view(b)) == 13);
+  EXPECT_EQ(sum, (std::array<int, 2>{7, 12}));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AutoTunedForce.h"
+#include "ForceCalc.h"
+#include "ParticleContainer.h"
+
+namespace {
+/**
+ * Force calculation that advances a fake clock by a fixed time and counts its calls
+ */
+class TimedForce final : public ForceCalc {
+ public:
+  double& now;
+  const double duration;
+  int calls = 0;
+
+  TimedForce(ParticleContainer& particles, double& now, const double duration)
+      : ForceCalc(particles), now(now), duration(duration) {}
+
+  void calculateF() override {
+    now += duration;
+    calls++;
+  }
+};
+}  // namespace
+
+class AutoTunedForceTest : public ::testing::Test {
+ protected:
+  ParticleContainer pc;
+};
+
+// Tests that the fastest candidate is selected after the trials and used until the next trial
+TEST_F(AutoTunedForceTest, SelectsFastest) {
+  double now = 0;
+  auto slow = std::make_unique<TimedForce>(pc, now, 5e-3);
+  auto fast = std::make_unique<TimedForce>(pc, now, 1e-3);
+  TimedForce& slowRef = *slow;
+  TimedForce& fastRef = *fast;
+  std::vector<AutoTunedForce::Candidate> candidates;
+  candidates.push_back({"slow", std::move(slow)});
+  candidates.push_back({"fast", std::move(fast)});
+  AutoTunedForce force(pc, std::move(candidates), 20, 2, [&now] { return now; });
+
+  // 2 trial steps per candidate, then the selection
+  for (int step = 0; step < 20; step++) {
+    force.calculateF();
+  }
+  EXPECT_EQ(force.getSelected(), "fast");
+  EXPECT_EQ(slowRef.calls, 2);
+  EXPECT_EQ(fastRef.calls, 18);
+
+  // the next trial starts after the interval
+  for (int step = 0; step < 2; step++) {
+    force.calculateF();
+  }
+  EXPECT_EQ(slowRef.calls, 4);
+}
+
+// Tests that the autotuned Lennard-Jones forces match the serial kernel whichever candidate runs
+TEST_F(AutoTunedForceTest, LennardJonesCandidates) {
+  for (int i = 0; i < 30; i++) {
+    pc.addParticle({1.1 * (i % 6), 1.1 * (i / 6), 0.}, {}, 1.);
+  }
+  ParticleContainer reference = pc;
+  LennardJonesForce(reference, 5., 1., 2.5).calculateF();
+
+  const MixingTable mixing(5., 1.);
+  std::vector<AutoTunedForce::Candidate> candidates;
+  candidates.push_back({"P:OFF", std::make_unique<LennardJonesForce>(pc, mixing, 2.5)});
+  candidates.push_back({"P:ON", std::make_unique<LennardJonesForceParallel>(pc, mixing, 2.5)});
+  candidates.push_back({"P:DET", std::make_unique<LennardJonesForceDeterministic>(pc, mixing, 2.5)});
+  AutoTunedForce force(pc, std::move(candidates), 10, 1);
+  for (int step = 0; step < 4; step++) {
+    force.calculateF();
+    for (std::size_t i = 0; i < pc.size(); i++) {
+      for (std::size_t d = 0; d < 3; d++) {
+        EXPECT_NEAR(pc[i].getF()[d], reference[i].getF()[d], 1e-9) << "step " << step;
+      }
+    }
+  }
+}
+
+// Tests that trials longer than the retune interval are rejected
+TEST_F(AutoTunedForceTest, InvalidInterval) {
+  std::vector<AutoTunedForce::Candidate> candidates;
+  candidates.push_back({"a", std::make_unique<LennardJonesForce>(pc, 5., 1., 2.5)});
+  candidates.push_back({"b", std::make_unique<LennardJonesForce>(pc, 5., 1., 2.5)});
+  EXPECT_THROW(AutoTunedForce(pc, std::move(candidates), 5, 3), std::invalid_argument);
+  EXPECT_THROW(AutoTunedForce(pc, {}, 5, 3), std::invalid_argument);
+}
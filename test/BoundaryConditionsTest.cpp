@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BoundaryConditions.h"
+#include "ForceCalc.h"
+#include "ParticleContainer.h"
+#include "utils/ArrayUtils.h"
+
+class BoundaryConditionsTest : public ::testing::Test {
+ protected:
+  ParticleContainer pc;
+  static constexpr double epsilon = 5.0;
+  static constexpr double sigma = 1.0;
+  static constexpr double cutoffRadius = 2.5;
+
+  static BoundaryConfig boxOf(BoundaryType type) {
+    return {{0., 0., 0.}, {10., 10., 10.}, {type, type, type, type, type, type}};
+  }
+};
+
+// Tests the parsing of the command line representation
+TEST_F(BoundaryConditionsTest, ParseConfig) {
+  const auto config = BoundaryConfig::parse("orppoo", "0,-1,0,10,9,1.5");
+  EXPECT_EQ(config.faces[0], BoundaryType::OUTFLOW);
+  EXPECT_EQ(config.faces[1], BoundaryType::REFLECTING);
+  EXPECT_EQ(config.faces[2], BoundaryType::PERIODIC);
+  EXPECT_EQ(config.lowerCorner, (std::array<double, 3>{0., -1., 0.}));
+  EXPECT_EQ(config.upperCorner, (std::array<double, 3>{10., 9., 1.5}));
+
+  EXPECT_THROW(BoundaryConfig::parse("orpp", "0,0,0,1,1,1"), std::invalid_argument);
+  EXPECT_THROW(BoundaryConfig::parse("oooxoo", "0,0,0,1,1,1"), std::invalid_argument);
+  EXPECT_THROW(BoundaryConfig::parse("oooooo", "0,0,0,1,1"), std::invalid_argument);
+}
+
+// Tests that periodic faces must be paired and the domain must be large enough for the halo
+TEST_F(BoundaryConditionsTest, InvalidPeriodicConfig) {
+  BoundaryConfig unpaired = boxOf(BoundaryType::OUTFLOW);
+  unpaired.faces[0] = BoundaryType::PERIODIC;
+  EXPECT_THROW(BoundaryConditions(unpaired, epsilon, sigma, cutoffRadius), std::invalid_argument);
+  EXPECT_THROW(BoundaryConditions(boxOf(BoundaryType::PERIODIC), epsilon, sigma, 6.), std::invalid_argument);
+}
+
+// Tests that outflow removes exactly the particles outside the domain
+TEST_F(BoundaryConditionsTest, OutflowRemovesParticles) {
+  BoundaryConditions boundary(boxOf(BoundaryType::OUTFLOW), epsilon, sigma, cutoffRadius);
+  pc.addParticle({-0.1, 5., 5.}, {}, 1.);
+  pc.addParticle({5., 5., 5.}, {}, 1.);
+  pc.addParticle({5., 10., 5.}, {}, 1.);
+  pc.addParticle({5., 5., 9.9}, {}, 1.);
+
+  boundary.applyAfterPositionUpdate(pc);
+  boundary.applyAfterForceUpdate(pc);
+  ASSERT_EQ(pc.size(), 2);
+  EXPECT_EQ(pc[0].getId(), 3);
+  EXPECT_EQ(pc[1].getId(), 1);
+}
+
+// Tests that a particle close to a reflecting face is pushed away from it and a particle that crossed it is mirrored
+TEST_F(BoundaryConditionsTest, ReflectingRepels) {
+  BoundaryConditions boundary(boxOf(BoundaryType::REFLECTING), epsilon, sigma, cutoffRadius);
+  pc.addParticle({0.4, 5., 5.}, {}, 1.);
+  pc.addParticle({5., 9.7, 5.}, {}, 1.);
+  pc.addParticle({5., 5., -0.2}, {0., 0., -1.}, 1.);
+
+  boundary.applyAfterPositionUpdate(pc);
+  for (auto& p : pc) {
+    p.setF({});
+  }
+  boundary.applyAfterForceUpdate(pc);
+
+  ASSERT_EQ(pc.size(), 3);
+  // force of a mirror particle at distance 0.8
+  const double s6 = std::pow(sigma / 0.8, 6);
+  const double expected = 24. * epsilon / 0.8 * s6 * (2. * s6 - 1.);
+  EXPECT_NEAR(pc[0].getF()[0], expected, 1e-12 * expected);
+  EXPECT_EQ(pc[0].getF()[1], 0.);
+  EXPECT_LT(pc[1].getF()[1], 0.);
+  EXPECT_DOUBLE_EQ(pc[2].getX()[2], 0.2);
+  EXPECT_EQ(pc[2].getV()[2], 1.);
+  EXPECT_GT(pc[2].getF()[2], 0.);
+}
+
+// Tests wrapping across periodic faces and that forces across them match the minimum-image distance
+TEST_F(BoundaryConditionsTest, PeriodicMinimumImage) {
+  BoundaryConditions boundary(boxOf(BoundaryType::PERIODIC), epsilon, sigma, cutoffRadius);
+  pc.addParticle({10.5, 5., 5.}, {}, 1.);
+  pc.addParticle({8.9, 5., 5.}, {}, 1.);
+  pc.addParticle({5., 0.5, 0.5}, {}, 1.);
+  pc.addParticle({5., 9.5, 9.5}, {}, 1.);
+
+  boundary.applyAfterPositionUpdate(pc);
+  EXPECT_DOUBLE_EQ(pc[0].getX()[0], 0.5);
+  EXPECT_GT(pc.size(), 4);
+  LennardJonesForce(pc, epsilon, sigma, cutoffRadius).calculateF();
+  boundary.applyAfterForceUpdate(pc);
+  ASSERT_EQ(pc.size(), 4);
+
+  // reference: the same pairs placed next to each other without boundaries
+  ParticleContainer reference;
+  reference.addParticle({10.5, 5., 5.}, {}, 1.);
+  reference.addParticle({8.9, 5., 5.}, {}, 1.);
+  reference.addParticle({5., 10.5, 10.5}, {}, 1.);
+  reference.addParticle({5., 9.5, 9.5}, {}, 1.);
+  LennardJonesForce(reference, epsilon, sigma, cutoffRadius).calculateF();
+
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    for (std::size_t d = 0; d < 3; d++) {
+      EXPECT_NEAR(pc[i].getF()[d], reference[i].getF()[d], 1e-12);
+    }
+  }
+}
+
+// Tests that halo copies keep the id of the particle they copy and use up no new ids
+TEST_F(BoundaryConditionsTest, HalosKeepIds) {
+  BoundaryConditions boundary(boxOf(BoundaryType::PERIODIC), epsilon, sigma, cutoffRadius);
+  pc.addParticle({5., 5., 5.}, {}, 1.);
+  pc.addParticle({0.5, 0.5, 5.}, {}, 1.);
+  for (int step = 0; step < 3; step++) {
+    boundary.applyAfterPositionUpdate(pc);
+    // one copy across each of the two faces and one across their edge
+    ASSERT_EQ(pc.size(), 5);
+    for (std::size_t i = boundary.getFirstHalo(); i < pc.size(); i++) {
+      EXPECT_EQ(pc[i].getId(), 1);
+    }
+    boundary.applyAfterForceUpdate(pc);
+  }
+  pc.addParticle({5., 5., 2.}, {}, 1.);
+  EXPECT_EQ(pc[2].getId(), 2);
+}
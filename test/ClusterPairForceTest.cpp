@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BoundaryConditions.h"
+#include "ForceCalc.h"
+#include "LennardJonesForceClusterPair.h"
+#include "ParticleContainer.h"
+
+template <typename ClusterSize>
+class ClusterPairForceTest : public ::testing::Test {
+ protected:
+  using Force = LennardJonesForceClusterPair<ClusterSize::value>;
+
+  ParticleContainer pc;
+  const MixingTable mixing{std::vector<Species>{{5., 1.}, {2., 1.2}}};
+
+  // irregular lattice of two types whose size is no multiple of the cluster size
+  void fillLattice(int nx, int ny, int nz) {
+    for (int x = 0; x < nx; x++) {
+      for (int y = 0; y < ny; y++) {
+        for (int z = 0; z < nz; z++) {
+          pc.addParticle({1.15 * x + 0.03 * y, 1.1 * y + 0.02 * z, 1.2 * z + 0.01 * x * z}, {}, 1., (x + y + z) % 2);
+        }
+      }
+    }
+    pc.removeParticle(pc.size() / 2);
+  }
+
+  void expectSameForces(const ParticleContainer& reference) const {
+    ASSERT_EQ(pc.size(), reference.size());
+    for (std::size_t i = 0; i < pc.size(); i++) {
+      for (std::size_t d = 0; d < 3; d++) {
+        EXPECT_NEAR(pc[i].getF()[d], reference[i].getF()[d], 1e-9 * (1. + std::abs(reference[i].getF()[d])));
+      }
+    }
+  }
+};
+
+using ClusterSizes = ::testing::Types<std::integral_constant<std::size_t, 4>, std::integral_constant<std::size_t, 8>>;
+TYPED_TEST_SUITE(ClusterPairForceTest, ClusterSizes);
+
+// Tests the forces of all cluster pairs against the plain pair loop in 3D and, with the 2D kernel, in a plane
+TYPED_TEST(ClusterPairForceTest, MatchesLennardJonesForce) {
+  for (const int nz : {1, 4}) {
+    this->pc = ParticleContainer();
+    this->fillLattice(7, 6, nz);
+    ParticleContainer reference = this->pc;
+
+    typename TestFixture::Force force(this->pc, this->mixing, 2.5);
+    force.setDimensions(nz == 1 ? 2 : 3);
+    force.calculateF();
+    LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+    this->expectSameForces(reference);
+  }
+}
+
+// Tests that potential energy and virial equal those of the plain pair loop, including the weights of halo copies
+TYPED_TEST(ClusterPairForceTest, Observables) {
+  this->fillLattice(5, 5, 3);
+  ParticleContainer reference = this->pc;
+
+  ForceObservables observables;
+  ForceObservables referenceObservables;
+  observables.ownedParticles = referenceObservables.ownedParticles = this->pc.size() - 10;
+  typename TestFixture::Force(this->pc, this->mixing, 2.5).calculateF(observables);
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF(referenceObservables);
+
+  EXPECT_TRUE(observables.valid);
+  EXPECT_NEAR(observables.potentialEnergy, referenceObservables.potentialEnergy, 1e-9);
+  for (std::size_t a = 0; a < 3; a++) {
+    for (std::size_t b = 0; b < 3; b++) {
+      EXPECT_NEAR(observables.virial[a][b], referenceObservables.virial[a][b], 1e-9);
+    }
+  }
+  this->expectSameForces(reference);
+}
+
+// Tests that the clusters are kept while the particles stay within half the buffer and rebuilt otherwise
+TYPED_TEST(ClusterPairForceTest, RebuildAfterMovement) {
+  this->fillLattice(6, 6, 3);
+  typename TestFixture::Force force(this->pc, this->mixing, 2.5, 0.4);
+  force.calculateF();
+  EXPECT_EQ(force.getRebuilds(), 1);
+
+  // within half the buffer: pairs that moved into the cutoff must still be found in the old list
+  for (std::size_t i = 0; i < this->pc.size(); i++) {
+    auto x = this->pc[i].getX();
+    x[i % 3] += (i % 2 == 0 ? 0.19 : -0.19);
+    this->pc[i].setX(x);
+  }
+  ParticleContainer reference = this->pc;
+  force.calculateF();
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+  EXPECT_EQ(force.getRebuilds(), 1);
+  this->expectSameForces(reference);
+
+  auto x = this->pc[3].getX();
+  x[0] += 0.5;
+  this->pc[3].setX(x);
+  reference = this->pc;
+  force.calculateF();
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+  EXPECT_EQ(force.getRebuilds(), 2);
+  this->expectSameForces(reference);
+
+  // outflow moves the last particle to the removed index
+  this->pc.removeParticle(0);
+  reference = this->pc;
+  force.calculateF();
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+  EXPECT_EQ(force.getRebuilds(), 3);
+  this->expectSameForces(reference);
+}
+
+// Tests that two particles at the same position are reported like in the plain pair loop
+TYPED_TEST(ClusterPairForceTest, ExpectNormError) {
+  this->pc.addParticle({0., 0., 0.}, {}, 1.);
+  this->pc.addParticle({1., 0., 0.}, {}, 1.);
+  this->pc.addParticle({0., 0., 0.}, {}, 1.);
+  EXPECT_THROW(typename TestFixture::Force(this->pc, this->mixing, 2.5).calculateF(), std::overflow_error);
+}
+
+// Tests that clusters at rest fall asleep without changing the forces, and that a moving particle wakes its cluster
+TYPED_TEST(ClusterPairForceTest, SleepingClusters) {
+  this->fillLattice(6, 6, 3);
+  typename TestFixture::Force force(this->pc, this->mixing, 2.5);
+  SleepSettings settings;
+  settings.quietSteps = 3;
+  force.enableSleeping(settings);
+  for (int step = 0; step < 5; step++) {
+    force.calculateF();
+  }
+  const std::size_t clusters = (this->pc.size() + TypeParam::value - 1) / TypeParam::value;
+  EXPECT_EQ(force.getSleepingClusters(), clusters);
+  EXPECT_GT(force.getSkippedFraction(), 0.);
+  ParticleContainer reference = this->pc;
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+  this->expectSameForces(reference);
+
+  auto x = this->pc[7].getX();
+  x[1] += 0.1;
+  this->pc[7].setX(x);
+  force.calculateF();
+  EXPECT_EQ(force.getSleepingClusters(), clusters - 1);
+  reference = this->pc;
+  LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+  this->expectSameForces(reference);
+}
+
+// Tests that clusters fall asleep while periodic halo copies and outflow change the number of particles every step
+TYPED_TEST(ClusterPairForceTest, SleepingWithBoundaries) {
+  constexpr double h = 1.12;
+  constexpr int n = 8;
+  BoundaryConditions boundary({{0., 0., 0.}, {n * h, n * h, 20.}, {BoundaryType::PERIODIC, BoundaryType::PERIODIC,
+                                                                    BoundaryType::PERIODIC, BoundaryType::PERIODIC,
+                                                                    BoundaryType::OUTFLOW, BoundaryType::OUTFLOW}},
+                              5., 1., 2.5);
+  for (int x = 0; x < n; x++) {
+    for (int y = 0; y < n; y++) {
+      for (int z = 0; z < 2; z++) {
+        this->pc.addParticle({h * (x + 0.5), h * (y + 0.5), 1. + h * z}, {}, 1.);
+      }
+    }
+  }
+  // far above the lattice, alternately inside and outside of the halo width of the x faces
+  this->pc.addParticle({n * h - 3., 1., 15.}, {}, 1.);
+  const std::size_t tracer = this->pc.size() - 1;
+  // leaves through the upper z face in the first step, which moves the tracer to another index
+  this->pc.addParticle({1., 1., 19.99}, {0., 0., 1.}, 1.);
+
+  typename TestFixture::Force force(this->pc, this->mixing, 2.5);
+  SleepSettings settings;
+  settings.quietSteps = 3;
+  settings.forceTolerance = 1e9;
+  force.enableSleeping(settings);
+  std::size_t previousSize = 0;
+  bool sizeChanged = true;
+  for (int step = 0; step < 8; step++) {
+    for (auto& p : this->pc) {
+      auto x = p.getX();
+      x[2] += 0.1 * p.getV()[2];
+      if (p.getX()[2] > 10.) {
+        x[0] = step % 2 == 0 ? n * h - 2. : n * h - 3.;
+      }
+      p.setX(x);
+    }
+    boundary.applyAfterPositionUpdate(this->pc);
+    if (step > 0) {
+      sizeChanged = sizeChanged and this->pc.size() != previousSize;
+    }
+    previousSize = this->pc.size();
+    force.calculateF();
+    boundary.applyAfterForceUpdate(this->pc);
+  }
+  EXPECT_TRUE(sizeChanged);
+  EXPECT_LT(this->pc.size(), tracer + 2);
+  EXPECT_GT(force.getSleepingClusters(), 0);
+}
+
+// Tests that a periodic verification replaces cached forces that drifted from the full calculation
+TYPED_TEST(ClusterPairForceTest, VerifiedSleepingCorrectsError) {
+  this->fillLattice(6, 6, 3);
+  SleepSettings settings;
+  settings.quietSteps = 2;
+  settings.forceTolerance = 1e9;
+  settings.verifyInterval = 4;
+  settings.maxForceError = 1e-6;
+  for (const bool verified : {false, true}) {
+    ParticleContainer initial = this->pc;
+    typename TestFixture::Force force(initial, this->mixing, 2.5);
+    settings.verifyPeriodically = verified;
+    force.enableSleeping(settings);
+    for (int step = 0; step < 3; step++) {
+      force.calculateF();
+    }
+    // shifts within the displacement tolerance keep the clusters asleep with outdated forces between them
+    for (std::size_t i = 0; i < initial.size(); i++) {
+      auto x = initial[i].getX();
+      x[0] += i % 2 == 0 ? 0.004 : -0.004;
+      initial[i].setX(x);
+    }
+    force.calculateF();
+    ParticleContainer reference = initial;
+    LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+
+    double error = 0;
+    for (std::size_t i = 0; i < initial.size(); i++) {
+      for (std::size_t d = 0; d < 3; d++) {
+        error = std::max(error, std::abs(initial[i].getF()[d] - reference[i].getF()[d]));
+      }
+    }
+    if (verified) {
+      EXPECT_LE(error, settings.maxForceError);
+      EXPECT_GT(force.getLargestVerifiedError(), settings.maxForceError);
+      EXPECT_EQ(force.getSleepingClusters(), 0);
+    } else {
+      EXPECT_GT(error, settings.maxForceError);
+    }
+  }
+}
+
+// Tests that strict sleeping keeps every force component within the bound on every step, while clusters that barely
+// moved stay asleep
+TYPED_TEST(ClusterPairForceTest, StrictSleepingBoundsError) {
+  this->fillLattice(6, 6, 3);
+  SleepSettings settings;
+  settings.quietSteps = 2;
+  settings.forceTolerance = 1e9;
+  settings.strict = true;
+  settings.maxForceError = 1e-3;
+  typename TestFixture::Force force(this->pc, this->mixing, 2.5);
+  force.enableSleeping(settings);
+  const std::size_t clusters = (this->pc.size() + TypeParam::value - 1) / TypeParam::value;
+  for (int step = 0; step < 12; step++) {
+    // still steps, tiny shifts that the bound tolerates, and shifts within the displacement tolerance that it does not
+    const double shift = step < 4 ? 0. : step < 8 ? 1e-9 : 0.004;
+    for (std::size_t i = 0; i < this->pc.size(); i++) {
+      auto x = this->pc[i].getX();
+      x[0] += i % 2 == step % 2 ? shift : -shift;
+      this->pc[i].setX(x);
+    }
+    force.calculateF();
+    ParticleContainer reference = this->pc;
+    LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+    for (std::size_t i = 0; i < this->pc.size(); i++) {
+      for (std::size_t d = 0; d < 3; d++) {
+        ASSERT_LE(std::abs(this->pc[i].getF()[d] - reference[i].getF()[d]), settings.maxForceError)
+            << "step " << step;
+      }
+    }
+    if (step == 3 or step == 7) {
+      EXPECT_EQ(force.getSleepingClusters(), clusters) << "step " << step;
+    }
+    if (step == 8) {
+      EXPECT_LT(force.getSleepingClusters(), clusters);
+    }
+  }
+}
+
+// Tests that clusters containing periodic halo copies fall asleep, since the copies keep the ids of their particles
+TYPED_TEST(ClusterPairForceTest, SleepingHalos) {
+  constexpr double h = 1.12;
+  constexpr int n = 6;
+  BoundaryConditions boundary({{0., 0., 0.}, {n * h, n * h, n * h}, {BoundaryType::PERIODIC, BoundaryType::PERIODIC,
+                                                                    BoundaryType::PERIODIC, BoundaryType::PERIODIC,
+                                                                    BoundaryType::PERIODIC, BoundaryType::PERIODIC}},
+                              5., 1., 2.5);
+  for (int x = 0; x < n; x++) {
+    for (int y = 0; y < n; y++) {
+      for (int z = 0; z < n; z++) {
+        this->pc.addParticle({h * (x + 0.5), h * (y + 0.5), h * (z + 0.5)}, {}, 1.);
+      }
+    }
+  }
+  typename TestFixture::Force force(this->pc, this->mixing, 2.5);
+  SleepSettings settings;
+  settings.quietSteps = 3;
+  force.enableSleeping(settings);
+  for (int step = 0; step < 5; step++) {
+    boundary.applyAfterPositionUpdate(this->pc);
+    force.calculateF();
+    if (step == 4) {
+      EXPECT_EQ(force.getSleepingClusters(), (this->pc.size() + TypeParam::value - 1) / TypeParam::value);
+      ParticleContainer reference = this->pc;
+      LennardJonesForce(reference, this->mixing, 2.5).calculateF();
+      this->expectSameForces(reference);
+    }
+    boundary.applyAfterForceUpdate(this->pc);
+  }
+  EXPECT_GT(force.getSkippedFraction(), 0.);
+}
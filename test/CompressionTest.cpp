@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <random>
+
+#include "ParticleContainer.h"
+#include "io/CompressedReader.h"
+#include "io/CompressedWriter.h"
+#include "utils/ArrayUtils.h"
+#include "utils/Compression.h"
+
+class CompressionTest : public ::testing::Test {
+ protected:
+  std::string directory = testing::TempDir() + "/molsim_compression_test";
+
+  void SetUp() override { std::filesystem::remove_all(directory); }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+};
+
+// Tests that zigzag varints round trip for small and extreme values
+TEST_F(CompressionTest, ZigzagVarint) {
+  std::vector<std::uint8_t> bytes;
+  const std::vector<std::int64_t> values = {0, -1, 1, 63, -64, 64, 1 << 20, -(1LL << 40), INT64_MAX, INT64_MIN};
+  for (const auto value : values) {
+    utils::appendVarint(bytes, utils::zigzagEncode(value));
+  }
+  EXPECT_EQ(bytes[0], 0);
+  EXPECT_EQ(bytes[1], 1);
+  EXPECT_EQ(bytes[2], 2);
+
+  std::size_t position = 0;
+  for (const auto value : values) {
+    EXPECT_EQ(utils::zigzagDecode(utils::readVarint(bytes, position)), value);
+  }
+  EXPECT_EQ(position, bytes.size());
+  EXPECT_THROW(utils::readVarint(bytes, position), std::runtime_error);
+}
+
+// Tests that Huffman coding round trips and shrinks skewed data
+TEST_F(CompressionTest, HuffmanRoundTrip) {
+  std::mt19937 engine(1);
+  std::geometric_distribution<int> skewed(0.3);
+  std::uniform_int_distribution<int> uniform(0, 255);
+  std::vector<std::uint8_t> data;
+  for (int i = 0; i < 100000; i++) {
+    data.push_back(static_cast<std::uint8_t>(i % 3 == 0 ? uniform(engine) : std::min(skewed(engine), 255)));
+  }
+  const auto encoded = utils::huffmanEncode(data);
+  EXPECT_LT(encoded.size(), data.size() * 3 / 4);
+  EXPECT_EQ(utils::huffmanDecode(encoded, data.size()), data);
+
+  // a single symbol and no data at all
+  const std::vector<std::uint8_t> single(1000, 7);
+  EXPECT_EQ(utils::huffmanDecode(utils::huffmanEncode(single), single.size()), single);
+  EXPECT_TRUE(utils::huffmanDecode(utils::huffmanEncode({}), 0).empty());
+
+  // a geometric distribution over all byte values exceeds the maximum code length without limiting
+  std::vector<std::uint8_t> extreme;
+  for (int symbol = 0; symbol < 40; symbol++) {
+    extreme.insert(extreme.end(), std::size_t{1} << (symbol / 2), static_cast<std::uint8_t>(symbol));
+  }
+  EXPECT_EQ(utils::huffmanDecode(utils::huffmanEncode(extreme), extreme.size()), extreme);
+}
+
+// Tests that frames decode within the quantization error, also when particles leave the simulation
+TEST_F(CompressionTest, WriterReaderRoundTrip) {
+  ParticleContainer pc;
+  for (int i = 0; i < 200; i++) {
+    pc.addParticle({0.37 * (i % 20), 0.41 * (i / 20), 0.}, {0.01 * i, -0.5, 0.}, 1. + (i % 3), i % 2);
+    pc[i].setF({1.5 * i, -2.25, 0.});
+  }
+
+  const std::string filename = directory + "/MD.mdc";
+  outputWriter::CompressionSettings settings;
+  settings.positionPrecision = 1e-4;
+  {
+    outputWriter::CompressedWriter writer(filename, settings);
+    writer.setDomain({0., 0., 0.}, {10., 10., 0.});
+    writer.plotParticles(pc, 0);
+    for (auto& p : pc) {
+      p.setX(p.getX() + std::array<double, 3>{0.001, 0.002, 0.});
+    }
+    pc.removeParticles([](const Particle& p) { return p.getId() % 7 == 0; });
+    pc.addParticle({5., 5., 0.}, {}, 4., 3);
+    writer.plotParticles(pc, 10);
+  }
+
+  CompressedReader reader(filename);
+  const auto step = reader.getHeader().positionStep;
+  EXPECT_DOUBLE_EQ(step[0], 1e-3);
+  EXPECT_DOUBLE_EQ(step[2], 1e-3);
+
+  const auto first = reader.nextFrame();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->iteration, 0);
+  EXPECT_EQ(first->particles.size(), 200);
+  const auto second = reader.nextFrame();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(second->iteration, 10);
+  ASSERT_EQ(second->particles.size(), pc.size());
+  EXPECT_FALSE(reader.nextFrame().has_value());
+
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    const Particle& decoded = second->particles[i];
+    EXPECT_EQ(decoded.getId(), pc[i].getId());
+    EXPECT_EQ(decoded.getM(), pc[i].getM());
+    EXPECT_EQ(decoded.getType(), pc[i].getType());
+    for (std::size_t d = 0; d < 3; d++) {
+      EXPECT_NEAR(decoded.getX()[d], pc[i].getX()[d], step[d] / 2 + 1e-12);
+      EXPECT_NEAR(decoded.getV()[d], pc[i].getV()[d], settings.velocityStep / 2 + 1e-12);
+      EXPECT_NEAR(decoded.getF()[d], pc[i].getF()[d], settings.forceStep / 2 + 1e-12);
+    }
+  }
+
+  // far smaller than 10 doubles per particle and frame
+  EXPECT_LT(std::filesystem::file_size(filename), 2 * 200 * 10 * sizeof(double) / 4);
+}
+
+// Tests that files of another format are rejected
+TEST_F(CompressionTest, RejectsOtherFiles) {
+  EXPECT_THROW(CompressedReader(directory + "/missing.mdc"), std::runtime_error);
+  std::filesystem::create_directories(directory);
+  std::ofstream(directory + "/other.mdc") << "not a snapshot file at all, but long enough for a header";
+  EXPECT_THROW(CompressedReader(directory + "/other.mdc"), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include "ParticleContainer.h"
 #include "Simulation.h"
 #include "io/FileReader.h"
@@ -20,4 +22,99 @@ TEST_F(CuboidFileReaderTest, BasicRead) {
             "Particle: X:[0, 0, 0] v: [-0.171411, 0.0178057, 0] f: [0, 0, 0] old_f: [0, 0, 0] type: 0");
   EXPECT_EQ(pc[1].toString(),
             "Particle: X:[0, 1.1225, 0] v: [0.00571789, -0.14098, 0] f: [0, 0, 0] old_f: [0, 0, 0] type: 0");
-}
\ No newline at end of file
+}
+// Tests that particle types and their Lennard-Jones parameters are read per cuboid
+TEST_F(CuboidFileReaderTest, TypedRead) {
+  CuboidFileReader reader(project_dir + "/input/eingabe-mixed.txt");
+  reader.readFile(pc);
+  ASSERT_EQ(pc.size(), 40 * 8 + 8 * 8);
+  EXPECT_EQ(pc[0].getType(), 0);
+  EXPECT_EQ(pc[40 * 8].getType(), 1);
+  EXPECT_EQ(pc[40 * 8].getM(), 2.0);
+
+  const auto species = reader.getSpecies({3.0, 0.5});
+  ASSERT_EQ(species.size(), 2);
+  EXPECT_EQ(species[0].epsilon, 5.0);
+  EXPECT_EQ(species[1].epsilon, 1.0);
+  EXPECT_EQ(species[1].sigma, 1.1);
+}
+
+// Tests that cuboids without a type use type 0 and the fallback parameters
+TEST_F(CuboidFileReaderTest, UntypedReadUsesFallback) {
+  CuboidFileReader reader(inputFilename);
+  reader.readFile(pc);
+  const auto species = reader.getSpecies({3.0, 0.5});
+  ASSERT_EQ(species.size(), 1);
+  EXPECT_EQ(species[0].epsilon, 3.0);
+  EXPECT_EQ(species[0].sigma, 0.5);
+}
+
+// Tests that the cached initial state is identical to the generated one and replaces the generation in later reads
+TEST_F(CuboidFileReaderTest, InitialStateCache) {
+  const auto directory = std::filesystem::temp_directory_path() / "molsim_initial_state_test";
+  std::filesystem::remove_all(directory);
+  const std::string input = (directory / "input.txt").string();
+  std::filesystem::create_directories(directory);
+  std::filesystem::copy_file(project_dir + "/input/eingabe-mixed.txt", input);
+  const InitialStateCache cache((directory / "cache").string());
+
+  CuboidFileReader(input).readFile(pc);
+  ParticleContainer stored;
+  CuboidFileReader(input).readFile(stored, cache);
+  ASSERT_EQ(std::distance(std::filesystem::directory_iterator(directory / "cache"), {}), 1);
+
+  // a changed blob shows that the second read takes the particles from the cache
+  const auto blob = std::filesystem::directory_iterator(directory / "cache")->path();
+  {
+    std::fstream file(blob, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(InitialStateCache::Header));
+    const double x = 1234.5;
+    file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+  }
+  ParticleContainer loaded;
+  CuboidFileReader reader(input);
+  reader.readFile(loaded, cache);
+  ASSERT_EQ(loaded.size(), pc.size());
+  EXPECT_EQ(loaded[0].getX()[0], 1234.5);
+  for (std::size_t i = 1; i < pc.size(); i++) {
+    EXPECT_EQ(loaded[i], pc[i]);
+    EXPECT_EQ(stored[i], pc[i]);
+  }
+  // the parameters of the particle types still come from the input file
+  EXPECT_EQ(reader.getSpecies({3.0, 0.5}).size(), 2);
+
+  // refreshing regenerates the particles
+  ParticleContainer refreshed;
+  CuboidFileReader(input).readFile(refreshed, InitialStateCache((directory / "cache").string(), true));
+  EXPECT_EQ(refreshed[0], pc[0]);
+
+  // a changed input file gets a blob of its own
+  std::ofstream(input, std::ios::app) << "\n";
+  ParticleContainer changed;
+  CuboidFileReader(input).readFile(changed, cache);
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory / "cache"), {}), 2);
+  std::filesystem::remove_all(directory);
+}
+
+// Tests that truncated or foreign blobs are ignored
+TEST_F(CuboidFileReaderTest, InitialStateCacheRejectsInvalidBlobs) {
+  const auto directory = std::filesystem::temp_directory_path() / "molsim_initial_state_invalid";
+  std::filesystem::remove_all(directory);
+  const InitialStateCache cache(directory.string());
+  pc.addParticle({1., 2., 3.}, {4., 5., 6.}, 7., 1);
+  pc.addParticle({8., 9., 10.}, {11., 12., 13.}, 14., 2);
+  ASSERT_TRUE(cache.store(42, pc));
+
+  ParticleContainer loaded;
+  EXPECT_FALSE(cache.load(43, loaded));
+  ASSERT_TRUE(cache.load(42, loaded));
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded[1].getType(), 2);
+  EXPECT_EQ(loaded[1].getV()[2], 13.);
+
+  std::filesystem::resize_file(cache.path(42), std::filesystem::file_size(cache.path(42)) - 8);
+  ParticleContainer truncated;
+  EXPECT_FALSE(cache.load(42, truncated));
+  EXPECT_EQ(truncated.size(), 0);
+  std::filesystem::remove_all(directory);
+}
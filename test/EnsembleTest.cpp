@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "Ensemble.h"
+#include "SimulationOptions.h"
+
+class EnsembleTest : public ::testing::Test {
+ protected:
+  std::string project_dir = PROJ_SRC_DIR;
+  std::string directory = testing::TempDir() + "/molsim_ensemble_test";
+
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+  }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  std::string writeManifest(const std::string& content) const {
+    const std::string filename = directory + "/manifest.txt";
+    std::ofstream(filename) << content;
+    return filename;
+  }
+};
+
+// Tests that the command line options are parsed as before
+TEST_F(EnsembleTest, ParseOptions) {
+  const auto options =
+      SimulationOptions::parse({"P:ON", "BC:oopprr", "DOMAIN:0,0,0,10,10,1", "SORT:TYPE", "ANALYSIS:100,bin"});
+  EXPECT_EQ(options.parallelization, Parallelization::ON);
+  ASSERT_TRUE(options.boundaryConfig.has_value());
+  EXPECT_EQ(options.boundaryConfig->faces[2], BoundaryType::PERIODIC);
+  EXPECT_TRUE(options.sortByType);
+  EXPECT_EQ(options.analysisInterval, 100);
+  EXPECT_EQ(options.analysisFormat, analysis::SeriesFormat::BINARY);
+  EXPECT_EQ(options.outputSchedule.periodicSize, (std::array<double, 3>{0., 10., 0.}));
+
+  EXPECT_EQ(SimulationOptions::parse({}).parallelization, Parallelization::OFF);
+  EXPECT_EQ(SimulationOptions::parse({"P:DET"}).parallelization, Parallelization::DETERMINISTIC);
+  EXPECT_THROW(SimulationOptions::parse({"BC:oooooo"}), std::invalid_argument);
+  EXPECT_THROW(SimulationOptions::parse({"ANALYSIS:0"}), std::invalid_argument);
+  EXPECT_THROW(SimulationOptions::parse({"FOO:BAR"}), std::invalid_argument);
+  EXPECT_EQ(SimulationOptions::parse({"CLUSTER:8", "P:OFF"}).clusterSize, 8);
+  EXPECT_THROW(SimulationOptions::parse({"CLUSTER:4", "P:ON"}), std::invalid_argument);
+  EXPECT_TRUE(SimulationOptions::parse({"CLUSTER:4", "SLEEP:20,verify"}).sleepSettings->verifyPeriodically);
+  EXPECT_TRUE(SimulationOptions::parse({"CLUSTER:4", "SLEEP:20,verify,strict"}).sleepSettings->strict);
+  EXPECT_THROW(SimulationOptions::parse({"SLEEP:20"}), std::invalid_argument);
+  EXPECT_EQ(SimulationOptions::parse({"INTEGRATOR:FOREST_RUTH"}).integrator, IntegrationScheme::FOREST_RUTH);
+  EXPECT_EQ(SimulationOptions::parse({}).integrator, IntegrationScheme::VERLET);
+  EXPECT_EQ(SimulationOptions::parse({"CACHE:states,refresh"}).cacheDirectory, "states");
+  EXPECT_TRUE(SimulationOptions::parse({"CACHE:states,refresh"}).refreshCache);
+  EXPECT_FALSE(SimulationOptions::parse({"CACHE:/tmp/a,b"}).refreshCache);
+  EXPECT_THROW(SimulationOptions::parse({"CACHE:"}), std::invalid_argument);
+  EXPECT_EQ(SimulationOptions::parse({"FRAMES:change,0.2"}).outputSchedule.trigger, OutputTrigger::DISPLACEMENT);
+  EXPECT_EQ(SimulationOptions::parse({"FRAMES:time,0.5"}).outputSchedule.value, 0.5);
+  EXPECT_THROW(SimulationOptions::parse({"FRAMES:budget,150"}), std::invalid_argument);
+  EXPECT_THROW(SimulationOptions::parse({"FRAMES:iterations,2.5"}), std::invalid_argument);
+#ifdef ENABLE_VTK_OUTPUT
+  EXPECT_EQ(SimulationOptions::parse({"OUTPUT:vtk"}).outputFormat, OutputFormat::VTK);
+#else
+  EXPECT_THROW(SimulationOptions::parse({"OUTPUT:vtk"}), std::invalid_argument);
+#endif
+  EXPECT_THROW(SimulationOptions::parse({"FRAMES:often"}), std::invalid_argument);
+}
+
+// Tests reading a manifest with comments, options and invalid lines
+TEST_F(EnsembleTest, ReadManifest) {
+  const std::string input = project_dir + "/input/cuboid-test.txt";
+  const auto members = EnsembleRunner::readManifest(
+      writeManifest("# name input t_end delta_t\n\na " + input + " 0.1 0.01\nb " + input + " 0.2 0.01 SORT:TYPE\n"));
+  ASSERT_EQ(members.size(), 2);
+  EXPECT_EQ(members[0].name, "a");
+  EXPECT_EQ(members[1].end_time, 0.2);
+  EXPECT_TRUE(members[1].options.sortByType);
+
+  // every member streams live output into its own segment
+  const auto live = EnsembleRunner::readManifest(
+      writeManifest("a " + input + " 0.1 0.01 OUTPUT:live\nb " + input + " 0.1 0.01 OUTPUT:live,sweep\n"));
+  EXPECT_EQ(live[0].options.streamName, "molsim_a");
+  EXPECT_EQ(live[1].options.streamName, "sweep_b");
+
+  EXPECT_THROW(EnsembleRunner::readManifest(writeManifest("a " + input + " 0.1 0.01\na " + input + " 0.1 0.01\n")),
+               std::invalid_argument);
+  EXPECT_THROW(EnsembleRunner::readManifest(writeManifest("a " + input + " 0.1\n")), std::invalid_argument);
+  EXPECT_THROW(EnsembleRunner::readManifest(writeManifest("a missing.txt 0.1 0.01\n")), std::invalid_argument);
+}
+
+// Tests that all members run and write into their own output directories
+TEST_F(EnsembleTest, RunWritesPerMemberOutput) {
+  const std::string input = project_dir + "/input/cuboid-test.txt";
+  auto members = EnsembleRunner::readManifest(
+      writeManifest("a " + input + " 0.01 0.001 ANALYSIS:5\nb " + input + " 0.01 0.001 ANALYSIS:5\n"));
+  EnsembleRunner runner(std::move(members), SimulationMode::BENCHMARK, directory);
+  EXPECT_TRUE(runner.run());
+
+  ASSERT_EQ(runner.getResults().size(), 2);
+  for (const auto& result : runner.getResults()) {
+    EXPECT_GT(result.particles, 0);
+    // small members run on a single thread each
+    EXPECT_EQ(result.threads, 1);
+  }
+  EXPECT_TRUE(std::filesystem::exists(directory + "/a/kinetic_energy.csv"));
+  EXPECT_TRUE(std::filesystem::exists(directory + "/b/kinetic_energy.csv"));
+  EXPECT_TRUE(std::filesystem::exists(directory + "/ensemble.csv"));
+}
+
+// Tests that a malformed input file only fails its own member
+TEST_F(EnsembleTest, MalformedInputFailsOnlyItsMember) {
+  const std::string input = project_dir + "/input/cuboid-test.txt";
+  const std::string malformed = directory + "/malformed.txt";
+  std::ofstream(malformed) << "1\n0 0 0 0 0\n";
+  auto members = EnsembleRunner::readManifest(
+      writeManifest("a " + input + " 0.01 0.001\nbad " + malformed + " 0.01 0.001\n"));
+  EnsembleRunner runner(std::move(members), SimulationMode::BENCHMARK, directory);
+  EXPECT_FALSE(runner.run());
+
+  ASSERT_EQ(runner.getResults().size(), 2);
+  EXPECT_TRUE(runner.getResults()[0].succeeded);
+  EXPECT_FALSE(runner.getResults()[1].succeeded);
+  std::ifstream summary(directory + "/ensemble.csv");
+  const std::string contents((std::istreambuf_iterator<char>(summary)), std::istreambuf_iterator<char>());
+  EXPECT_NE(contents.find("bad,0,1,OFF,"), std::string::npos);
+  EXPECT_NE(contents.find(",failed\n"), std::string::npos);
+}
+
+// Tests that members keep their force calculation, including the options only available with P:OFF
+TEST_F(EnsembleTest, KeepsParallelization) {
+  const std::string input = project_dir + "/input/cuboid-test.txt";
+  const std::string manifest = "a " + input + " 0.01 0.001 P:OFF CLUSTER:4 SLEEP:5\nb " + input + " 0.01 0.001 P:DET\n";
+  for (const std::size_t largeParticles : {1, 1000000}) {
+    EnsembleRunner runner(EnsembleRunner::readManifest(writeManifest(manifest)), SimulationMode::BENCHMARK,
+                          directory, largeParticles);
+    EXPECT_TRUE(runner.run());
+    ASSERT_EQ(runner.getResults().size(), 2);
+    EXPECT_EQ(runner.getResults()[0].parallelization, Parallelization::OFF);
+    EXPECT_EQ(runner.getResults()[0].threads, 1);
+    EXPECT_EQ(runner.getResults()[1].parallelization, Parallelization::DETERMINISTIC);
+    EXPECT_EQ(runner.getResults()[1].threads, largeParticles == 1 ? omp_get_max_threads() : 1);
+  }
+  std::ifstream summary(directory + "/ensemble.csv");
+  const std::string contents((std::istreambuf_iterator<char>(summary)), std::istreambuf_iterator<char>());
+  EXPECT_NE(contents.find(",1,OFF,"), std::string::npos);
+  EXPECT_NE(contents.find(",1,DET,"), std::string::npos);
+}
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <omp.h>
+
 #include <cmath>
+#include <memory>
 
 #include "ForceCalc.h"
+#include "Integrator.h"
 #include "ParticleContainer.h"
 #include "utils/ArrayUtils.h"
 
@@ -94,3 +98,234 @@ TEST_F(ForceCalcTest, LJ_F_TwoBody) {
     EXPECT_NEAR(pc[1].getF()[i], -1. * F[i], 10e-6);
   }
 }
+
+// Tests the Lorentz-Berthelot mixing rules and the precomputed kernel factors
+TEST_F(ForceCalcTest, MixingTable) {
+  const MixingTable mixing({{4., 1.}, {1., 2.}});
+  ASSERT_EQ(mixing.size(), 2);
+  EXPECT_DOUBLE_EQ(mixing(0, 0).epsilon24, 24. * 4.);
+  EXPECT_DOUBLE_EQ(mixing(1, 1).sigma6, 64.);
+  EXPECT_DOUBLE_EQ(mixing(0, 1).epsilon24, 24. * 2.);
+  EXPECT_DOUBLE_EQ(mixing(1, 0).sigma6, std::pow(1.5, 6));
+
+  // a single species applies to every type
+  const MixingTable single(5., 1.);
+  EXPECT_DOUBLE_EQ(single(3, 7).epsilon24, 24. * 5.);
+}
+
+// Tests that particles of different types interact with the mixed parameters
+TEST_F(ForceCalcTest, LJ_F_MixedTypes) {
+  pc.addParticle({0., 0., 0.}, {}, 1., 0);
+  pc.addParticle({1.5, 0., 0.}, {}, 1., 1);
+  ParticleContainer reference;
+  reference.addParticle({0., 0., 0.}, {}, 1.);
+  reference.addParticle({1.5, 0., 0.}, {}, 1.);
+
+  LennardJonesForce(pc, MixingTable({{4., 1.}, {1., 2.}}), INFINITY).calculateF();
+  LennardJonesForce(reference, 2., 1.5, INFINITY).calculateF();
+  for (std::size_t d = 0; d < 3; d++) {
+    EXPECT_DOUBLE_EQ(pc[0].getF()[d], reference[0].getF()[d]);
+    EXPECT_DOUBLE_EQ(pc[1].getF()[d], reference[1].getF()[d]);
+  }
+}
+
+// Tests the potential energy and virial accumulated by the force calculation at the minimum of the potential
+TEST_F(ForceCalcTest, LJ_Observables_TwoBody) {
+  const double r_min = std::pow(2., 1. / 6.);
+  pc.addParticle({0., 0., 0.}, {}, 1.);
+  pc.addParticle({r_min, 0., 0.}, {}, 1.);
+
+  ForceObservables observables;
+  LennardJonesForce(pc, 5., 1., INFINITY).calculateF(observables);
+  ASSERT_TRUE(observables.valid);
+  EXPECT_NEAR(observables.potentialEnergy, -5., 1e-12);
+  // the force vanishes at the minimum, and so does the virial
+  for (const auto& row : observables.virial) {
+    for (const double w : row) {
+      EXPECT_NEAR(w, 0., 1e-12);
+    }
+  }
+
+  // a compressed pair is repulsive and has a positive virial along its axis
+  pc[1].setX({1., 0., 0.});
+  LennardJonesForce(pc, 5., 1., INFINITY).calculateF(observables);
+  EXPECT_DOUBLE_EQ(observables.potentialEnergy, 0.);
+  EXPECT_DOUBLE_EQ(observables.virial[0][0], 120.);
+  EXPECT_DOUBLE_EQ(observables.virial[1][1], 0.);
+}
+
+// Tests that the serial and the parallel kernel accumulate the same observables and forces as without them
+TEST_F(ForceCalcTest, LJ_Observables_ParallelMatchesSerial) {
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      pc.addParticle({1.1 * i + 0.01 * j, 1.1 * j, 0.02 * i * j}, {}, 1.);
+    }
+  }
+  ParticleContainer reference = pc;
+  ParticleContainer parallel = pc;
+
+  ForceObservables serialObservables;
+  ForceObservables parallelObservables;
+  LennardJonesForce(pc, 5., 1., 2.5).calculateF(serialObservables);
+  LennardJonesForce(reference, 5., 1., 2.5).calculateF();
+  LennardJonesForceParallel(parallel, 5., 1., 2.5).calculateF(parallelObservables);
+
+  EXPECT_NEAR(parallelObservables.potentialEnergy, serialObservables.potentialEnergy, 1e-9);
+  for (std::size_t a = 0; a < 3; a++) {
+    for (std::size_t b = 0; b < 3; b++) {
+      EXPECT_NEAR(parallelObservables.virial[a][b], serialObservables.virial[a][b], 1e-9);
+    }
+  }
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    EXPECT_EQ(pc[i].getF(), reference[i].getF());
+    for (std::size_t d = 0; d < 3; d++) {
+      EXPECT_NEAR(parallel[i].getF()[d], reference[i].getF()[d], 1e-9);
+    }
+  }
+}
+
+// Tests that the work stealing schedule computes the same forces and observables as the serial kernel
+TEST_F(ForceCalcTest, LJ_WorkStealing_MatchesSerial) {
+  for (int i = 0; i < 100; i++) {
+    pc.addParticle({1.1 * (i % 10) + 0.01 * i, 1.1 * (i / 10), 0.03 * (i % 3)}, {}, 1.);
+  }
+  ParticleContainer parallel = pc;
+  ForceObservables serialObservables;
+  LennardJonesForce(pc, 5., 1., 2.5).calculateF(serialObservables);
+
+  const int maxThreads = omp_get_max_threads();
+  for (const int threads : {1, 3}) {
+    omp_set_num_threads(threads);
+    LennardJonesForceParallel force(parallel, MixingTable(5., 1.), 2.5, Schedule::WORK_STEALING);
+    ForceObservables observables;
+    force.calculateF(observables);
+    EXPECT_NEAR(observables.potentialEnergy, serialObservables.potentialEnergy, 1e-9);
+    EXPECT_NEAR(observables.virial[0][1], serialObservables.virial[0][1], 1e-9);
+    for (std::size_t i = 0; i < pc.size(); i++) {
+      for (std::size_t d = 0; d < 3; d++) {
+        EXPECT_NEAR(parallel[i].getF()[d], pc[i].getF()[d], 1e-9);
+      }
+    }
+
+    // 100 particles in blocks of 16 rows
+    std::size_t tasks = 0;
+    ASSERT_EQ(force.getThreadLoads().size(), static_cast<std::size_t>(threads));
+    for (const auto& load : force.getThreadLoads()) {
+      tasks += load.tasks;
+    }
+    EXPECT_EQ(tasks, 7);
+  }
+  omp_set_num_threads(maxThreads);
+}
+
+// Tests that pairs with halo copies count half and pairs of halo copies not at all
+TEST_F(ForceCalcTest, Gravity_Observables_HaloWeights) {
+  pc.addParticle({0., 0., 0.}, {}, 1.);
+  pc.addParticle({1., 0., 0.}, {}, 1.);
+  pc.addParticle({0., 2., 0.}, {}, 1.);
+
+  ForceObservables observables;
+  GravityForce(pc).calculateF(observables);
+  EXPECT_DOUBLE_EQ(observables.potentialEnergy, -1. - 0.5 - 1. / std::sqrt(5.));
+
+  observables.ownedParticles = 1;
+  GravityForce(pc).calculateF(observables);
+  EXPECT_DOUBLE_EQ(observables.potentialEnergy, 0.5 * (-1. - 0.5));
+}
+
+// Tests that the deterministic parallel kernel reproduces the serial trajectory bitwise for any number of threads
+TEST_F(ForceCalcTest, LJ_Deterministic_MatchesSerialBitwise) {
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      pc.addParticle({1.1225 * i + 0.013 * j, 1.1225 * j - 0.007 * i, 0.}, {0.3 * (i % 2), -0.2 * (j % 3), 0.}, 1.,
+                     (i + j) % 2);
+    }
+  }
+  const MixingTable mixing({{5., 1.}, {2., 1.2}});
+
+  ParticleContainer serial = pc;
+  LennardJonesForce serialForce(serial, mixing, 3.);
+  const VelocityVerlet verlet;
+  for (int step = 0; step < 50; step++) {
+    verlet.step(serial, 0.0005, [&serialForce](bool) { serialForce.calculateF(); });
+  }
+
+  const int maxThreads = omp_get_max_threads();
+  for (const int threads : {1, 2, 3, 7}) {
+    omp_set_num_threads(threads);
+    ParticleContainer parallel = pc;
+    LennardJonesForceDeterministic parallelForce(parallel, mixing, 3.);
+    for (int step = 0; step < 50; step++) {
+      verlet.step(parallel, 0.0005, [&parallelForce](bool) { parallelForce.calculateF(); });
+    }
+    for (std::size_t i = 0; i < pc.size(); i++) {
+      EXPECT_EQ(parallel[i].getX(), serial[i].getX()) << threads << " threads, particle " << i;
+      EXPECT_EQ(parallel[i].getV(), serial[i].getV()) << threads << " threads, particle " << i;
+      EXPECT_EQ(parallel[i].getF(), serial[i].getF()) << threads << " threads, particle " << i;
+    }
+  }
+  omp_set_num_threads(maxThreads);
+}
+
+// Tests that the observables of the deterministic kernel do not depend on the number of threads
+TEST_F(ForceCalcTest, LJ_Deterministic_ObservablesIndependentOfThreads) {
+  for (int i = 0; i < 40; i++) {
+    pc.addParticle({1.1 * (i % 7) + 0.01 * i, 1.1 * (i / 7), 0.}, {}, 1.);
+  }
+  ForceObservables serialObservables;
+  LennardJonesForce(pc, 5., 1., 2.5).calculateF(serialObservables);
+
+  const int maxThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  ForceObservables reference;
+  LennardJonesForceDeterministic(pc, MixingTable(5., 1.), 2.5).calculateF(reference);
+  EXPECT_NEAR(reference.potentialEnergy, serialObservables.potentialEnergy, 1e-9);
+
+  for (const int threads : {2, 5}) {
+    omp_set_num_threads(threads);
+    ForceObservables observables;
+    LennardJonesForceDeterministic(pc, MixingTable(5., 1.), 2.5).calculateF(observables);
+    EXPECT_EQ(observables.potentialEnergy, reference.potentialEnergy);
+    EXPECT_EQ(observables.virial, reference.virial);
+  }
+  omp_set_num_threads(maxThreads);
+}
+
+// Tests that the 2D instantiations of all Lennard-Jones kernels and the integration match 3D for particles in a plane
+TEST_F(ForceCalcTest, LJ_TwoDimensions_MatchesThreeDimensions) {
+  for (int i = 0; i < 50; i++) {
+    pc.addParticle({1.1 * (i % 8) + 0.02 * i, 1.1 * (i / 8), 0.5}, {0.1 * (i % 3), -0.2, 0.}, 1.);
+  }
+  std::vector<std::unique_ptr<ForceCalc>> forces;
+  forces.push_back(std::make_unique<LennardJonesForce>(pc, 5., 1., 2.5));
+  forces.push_back(std::make_unique<LennardJonesForceParallel>(pc, MixingTable(5., 1.), 2.5, Schedule::GUIDED));
+  forces.push_back(std::make_unique<LennardJonesForceParallel>(pc, MixingTable(5., 1.), 2.5, Schedule::WORK_STEALING));
+  forces.push_back(std::make_unique<LennardJonesForceDeterministic>(pc, MixingTable(5., 1.), 2.5));
+
+  const ParticleContainer initial = pc;
+  for (auto& force : forces) {
+    pc = initial;
+    ForceObservables observables3D;
+    VelocityVerlet verlet;
+    force->setDimensions(3);
+    force->calculateF(observables3D);
+    verlet.step(pc, 0.01, [&force](bool) { force->calculateF(); });
+    const ParticleContainer reference = pc;
+
+    pc = initial;
+    ForceObservables observables2D;
+    force->setDimensions(2);
+    verlet.setDimensions(2);
+    force->calculateF(observables2D);
+    verlet.step(pc, 0.01, [&force](bool) { force->calculateF(); });
+    EXPECT_NEAR(observables2D.potentialEnergy, observables3D.potentialEnergy, 1e-9);
+    for (std::size_t i = 0; i < pc.size(); i++) {
+      EXPECT_EQ(pc[i].getX()[2], 0.5);
+      for (std::size_t d = 0; d < 3; d++) {
+        EXPECT_NEAR(pc[i].getF()[d], reference[i].getF()[d], 1e-9);
+        EXPECT_NEAR(pc[i].getX()[d], reference[i].getX()[d], 1e-12);
+      }
+    }
+  }
+  EXPECT_THROW(forces.front()->setDimensions(1), std::invalid_argument);
+}
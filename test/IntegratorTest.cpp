@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "ForceCalc.h"
+#include "Integrator.h"
+#include "ParticleContainer.h"
+
+class IntegratorTest : public ::testing::Test {
+ protected:
+  ParticleContainer pc;
+
+  void SetUp() override {
+    // sun and a light planet on an orbit with eccentricity 0.36
+    pc.addParticle({0., 0., 0.}, {0., 0., 0.}, 1.);
+    pc.addParticle({1., 0., 0.}, {0., 0.8, 0.}, 1e-3);
+  }
+
+  static double totalEnergy(ParticleContainer& particles, GravityForce& force) {
+    ForceObservables observables;
+    force.calculateF(observables);
+    double energy = observables.potentialEnergy;
+    for (const auto& p : particles) {
+      const auto& v = p.getV();
+      energy += 0.5 * p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    }
+    return energy;
+  }
+
+  // largest relative energy error over the time 10 integrated with time step dt
+  double energyError(const Integrator& integrator, double dt) {
+    ParticleContainer particles = pc;
+    GravityForce force(particles);
+    const double initial = totalEnergy(particles, force);
+    double maxError = 0;
+    const int steps = static_cast<int>(std::lround(10. / dt));
+    for (int step = 0; step < steps; step++) {
+      integrator.step(particles, dt, [&force](bool) { force.calculateF(); });
+      if (step % 10 == 9) {
+        maxError = std::max(maxError, std::abs(totalEnergy(particles, force) - initial) / std::abs(initial));
+      }
+    }
+    return maxError;
+  }
+};
+
+// Tests that the velocity Verlet integrator reproduces the Störmer-Verlet update formulas
+TEST_F(IntegratorTest, VelocityVerletStep) {
+  GravityForce force(pc);
+  force.calculateF();
+  const auto x = pc[1].getX();
+  const auto v = pc[1].getV();
+  const auto F = pc[1].getF();
+  const double dt = 0.01;
+
+  int calls = 0;
+  VelocityVerlet().step(pc, dt, [&](bool last) {
+    EXPECT_TRUE(last);
+    calls++;
+    force.calculateF();
+  });
+  EXPECT_EQ(calls, 1);
+  for (std::size_t d = 0; d < 3; d++) {
+    const double expectedX = x[d] + dt * v[d] + 0.5 * dt * dt * F[d] / 1e-3;
+    EXPECT_DOUBLE_EQ(pc[1].getX()[d], expectedX);
+    EXPECT_DOUBLE_EQ(pc[1].getOldF()[d], F[d]);
+    EXPECT_DOUBLE_EQ(pc[1].getV()[d], v[d] + dt / (2 * 1e-3) * (F[d] + pc[1].getF()[d]));
+  }
+}
+
+// Tests that Forest-Ruth calculates the forces three times per step and marks only the last calculation
+TEST_F(IntegratorTest, ForestRuthForceEvaluations) {
+  GravityForce force(pc);
+  force.calculateF();
+  const ForestRuth integrator;
+  std::vector<bool> calls;
+  integrator.step(pc, 0.01, [&](bool last) {
+    calls.push_back(last);
+    force.calculateF();
+  });
+  EXPECT_EQ(calls, (std::vector<bool>{false, false, true}));
+  EXPECT_EQ(integrator.forceEvaluations(), 3);
+  EXPECT_EQ(VelocityVerlet().forceEvaluations(), 1);
+  EXPECT_EQ(createIntegrator(IntegrationScheme::FOREST_RUTH)->name(), "FOREST_RUTH");
+  EXPECT_EQ(createIntegrator(IntegrationScheme::VERLET)->name(), "VERLET");
+}
+
+// Tests that the energy error drops with the second power of the time step for Verlet and the fourth for Forest-Ruth
+TEST_F(IntegratorTest, OrderOfConvergence) {
+  const VelocityVerlet verlet;
+  const ForestRuth forestRuth;
+  const double verletRatio = energyError(verlet, 0.01) / energyError(verlet, 0.005);
+  const double forestRuthRatio = energyError(forestRuth, 0.01) / energyError(forestRuth, 0.005);
+  EXPECT_NEAR(verletRatio, 4., 0.5);
+  EXPECT_NEAR(forestRuthRatio, 16., 2.);
+  // at the same time step, Forest-Ruth is far more accurate
+  EXPECT_LT(energyError(forestRuth, 0.01), 0.01 * energyError(verlet, 0.01));
+}
+
+// Tests that a 2D integrator leaves the z components untouched
+TEST_F(IntegratorTest, TwoDimensions) {
+  pc[1].setV({0., 0.8, 0.1});
+  GravityForce force(pc);
+  force.calculateF();
+  ForestRuth integrator;
+  integrator.setDimensions(2);
+  for (int step = 0; step < 10; step++) {
+    integrator.step(pc, 0.01, [&force](bool) { force.calculateF(); });
+  }
+  EXPECT_EQ(pc[1].getX()[2], 0.);
+  EXPECT_EQ(pc[1].getV()[2], 0.1);
+  EXPECT_NE(pc[1].getX()[1], 0.);
+  EXPECT_THROW(integrator.setDimensions(4), std::invalid_argument);
+}
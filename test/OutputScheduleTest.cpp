@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "OutputSchedule.h"
+#include "ParticleContainer.h"
+
+class OutputScheduleTest : public ::testing::Test {
+ protected:
+  ParticleContainer pc;
+
+  void SetUp() override {
+    for (int i = 0; i < 4; i++) {
+      pc.addParticle({1.0 * i, 0., 0.}, {0., 0., 0.}, 1.);
+    }
+  }
+};
+
+// Tests that the iteration interval reproduces the former fixed output every 10 iterations
+TEST_F(OutputScheduleTest, IterationInterval) {
+  const auto schedule = createOutputSchedule({});
+  int frames = 0;
+  for (int iteration = 1; iteration <= 100; iteration++) {
+    frames += schedule->isDue(iteration, 0.0, pc) ? 1 : 0;
+  }
+  EXPECT_EQ(frames, 10);
+  EXPECT_TRUE(schedule->isDue(30, 0.0, pc));
+  EXPECT_THROW(createOutputSchedule({OutputTrigger::ITERATIONS, 0}), std::invalid_argument);
+}
+
+// Tests that the time interval writes once per interval for any time step
+TEST_F(OutputScheduleTest, TimeInterval) {
+  for (const double dt : {0.001, 0.003, 0.01}) {
+    TimeInterval schedule(0.1);
+    schedule.start(pc);
+    int frames = 0;
+    double time = 0;
+    for (int iteration = 1; time < 1.0 - 1e-12; iteration++) {
+      time += dt;
+      frames += schedule.isDue(iteration, time, pc) ? 1 : 0;
+    }
+    EXPECT_EQ(frames, 10) << dt;
+  }
+}
+
+// Tests that snapshots are only due when writing stays within the share of the wall time
+TEST_F(OutputScheduleTest, WallTimeBudget) {
+  double now = 100;
+  WallTimeBudget schedule(50, [&now] { return now; });
+  schedule.start(pc);
+  EXPECT_TRUE(schedule.isDue(1, 0.0, pc));
+  // a write of 10 ms, the next one is expected to take as long, so 40 ms must have passed
+  schedule.written(pc, 0.01);
+  now += 0.039;
+  EXPECT_FALSE(schedule.isDue(2, 0.0, pc));
+  now += 0.002;
+  EXPECT_TRUE(schedule.isDue(3, 0.0, pc));
+  // a slower write of 30 ms raises the estimate for the next one, so 140 ms must have passed in total
+  schedule.written(pc, 0.03);
+  now += 0.098;
+  EXPECT_FALSE(schedule.isDue(4, 0.0, pc));
+  now += 0.002;
+  EXPECT_TRUE(schedule.isDue(5, 0.0, pc));
+  EXPECT_THROW(WallTimeBudget(0), std::invalid_argument);
+  EXPECT_THROW(WallTimeBudget(101), std::invalid_argument);
+}
+
+// Tests that the displacement trigger compares with the last snapshot and ignores new particles
+TEST_F(OutputScheduleTest, DisplacementTrigger) {
+  DisplacementTrigger schedule(0.5);
+  schedule.start(pc);
+  pc[0].setX({0., 0.8, 0.});
+  // RMS of (0.8, 0, 0, 0) is 0.4
+  EXPECT_NEAR(schedule.rmsDisplacement(pc), 0.4, 1e-12);
+  EXPECT_FALSE(schedule.isDue(1, 0.0, pc));
+  pc[1].setX({1., 0.8, 0.});
+  pc[2].setX({2., 0.8, 0.});
+  EXPECT_TRUE(schedule.isDue(2, 0.0, pc));
+  schedule.written(pc, 0.0);
+  EXPECT_EQ(schedule.rmsDisplacement(pc), 0.0);
+
+  pc.addParticle({100., 0., 0.}, {0., 0., 0.}, 1.);
+  pc.removeParticle(0);
+  EXPECT_EQ(schedule.rmsDisplacement(pc), 0.0);
+}
+
+// Tests that particles wrapping across a periodic face only count their distance to the nearest image
+TEST_F(OutputScheduleTest, DisplacementAcrossPeriodicFace) {
+  DisplacementTrigger periodic(0.5, {4., 0., 0.});
+  DisplacementTrigger unbounded(0.5);
+  pc[3].setX({3.9, 0., 0.});
+  periodic.start(pc);
+  unbounded.start(pc);
+  // leaves through the upper x face at 4 and reappears at 0.1, a move of 0.2
+  pc[3].setX({0.1, 0., 0.});
+  EXPECT_NEAR(periodic.rmsDisplacement(pc), 0.1, 1e-12);
+  EXPECT_FALSE(periodic.isDue(1, 0.0, pc));
+  EXPECT_NEAR(unbounded.rmsDisplacement(pc), 1.9, 1e-12);
+  EXPECT_TRUE(unbounded.isDue(1, 0.0, pc));
+}
@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
 #include "ParticleContainer.h"
 // Check if ParticleContainer saves new particles
 
@@ -34,4 +38,95 @@ TEST_F(ParticleContainerTest, AccessParticles) {
   EXPECT_EQ(pc[0].getX()[0], 1.);
   EXPECT_EQ(pc[0].getX()[1], 2.);
   EXPECT_EQ(pc[0].getX()[2], 3.);
-}
\ No newline at end of file
+}
+// Tests that reserving storage does not change the size and keeps the particles in place while filling it
+TEST_F(ParticleContainerTest, ReserveAvoidsReallocation) {
+  pc.reserve(100);
+  EXPECT_EQ(pc.size(), 0);
+  EXPECT_GE(pc.capacity(), 100);
+
+  Particle p(0);
+  pc.addParticle(&p);
+  const Particle* first = &pc[0];
+  for (int i = 1; i < 100; i++) {
+    pc.addParticle(&p);
+  }
+  EXPECT_EQ(&pc[0], first);
+}
+
+// Tests the alignment of small (operator new) and large (huge page mapped) particle buffers
+TEST_F(ParticleContainerTest, StorageIsAligned) {
+  Particle p(0);
+  pc.reserve(10);
+  pc.addParticle(&p);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&pc[0]) % 64, 0);
+
+  ParticleContainer large;
+  large.reserve(2 * utils::HugePageAllocator<Particle>::hugePageSize / sizeof(Particle));
+  large.addParticle(&p);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&large[0]) % utils::HugePageAllocator<Particle>::hugePageSize, 0);
+}
+
+// Tests that ids are assigned in insertion order and survive removal of other particles
+TEST_F(ParticleContainerTest, StableIdsAfterRemoval) {
+  for (int i = 0; i < 4; i++) {
+    Particle p(i);
+    pc.addParticle(&p);
+  }
+  pc.removeParticle(1);
+  ASSERT_EQ(pc.size(), 3);
+  // the last particle was moved into the freed slot
+  EXPECT_EQ(pc[1].getId(), 3);
+  EXPECT_EQ(pc[1].getType(), 3);
+  EXPECT_EQ(pc[0].getId(), 0);
+  EXPECT_EQ(pc[2].getId(), 2);
+
+  // ids are never reused
+  Particle p(4);
+  pc.addParticle(&p);
+  EXPECT_EQ(pc[3].getId(), 4);
+}
+
+// Tests that removing a particle that does not exist throws and leaves the container unchanged
+TEST_F(ParticleContainerTest, RemoveOutOfRange) {
+  EXPECT_THROW(pc.removeParticle(0), std::out_of_range);
+  pc.addParticle({0., 0., 0.}, {0., 0., 0.}, 1.);
+  EXPECT_THROW(pc.removeParticle(1), std::out_of_range);
+  EXPECT_EQ(pc.size(), 1);
+  pc.removeParticle(0);
+  EXPECT_EQ(pc.size(), 0);
+}
+
+// Tests batched insertion and predicate based removal
+TEST_F(ParticleContainerTest, BatchedInsertRemove) {
+  std::vector<Particle> batch;
+  for (int i = 0; i < 6; i++) {
+    batch.emplace_back(std::array<double, 3>{static_cast<double>(i), 0., 0.}, std::array<double, 3>{}, 1., i % 2);
+  }
+  pc.addParticles(batch);
+  ASSERT_EQ(pc.size(), 6);
+
+  const std::size_t removed = pc.removeParticles([](const Particle& p) { return p.getType() == 1; });
+  EXPECT_EQ(removed, 3);
+  ASSERT_EQ(pc.size(), 3);
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    EXPECT_EQ(pc[i].getId(), 2 * i);
+    EXPECT_EQ(pc[i].getX()[0], 2. * i);
+  }
+
+  pc.truncate(1);
+  EXPECT_EQ(pc.size(), 1);
+  EXPECT_EQ(pc[0].getId(), 0);
+}
+
+// Tests that sorting by type is stable
+TEST_F(ParticleContainerTest, SortByType) {
+  for (int type : {2, 0, 1, 0, 2}) {
+    pc.addParticle({}, {}, 1., type);
+  }
+  pc.sortByType();
+  const std::vector<std::size_t> expectedIds = {1, 3, 2, 0, 4};
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    EXPECT_EQ(pc[i].getId(), expectedIds[i]);
+  }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "ParticleContainer.h"
+#include "io/SharedMemoryReader.h"
+#include "io/SharedMemoryWriter.h"
+
+class SharedMemoryTest : public ::testing::Test {
+ protected:
+  std::string name = "molsim_test_" + std::to_string(::getpid());
+  ParticleContainer pc;
+
+  void SetUp() override {
+    for (int i = 0; i < 10; i++) {
+      pc.addParticle({1. * i, 2. * i, 0.5}, {0.25, -1. * i, 0.}, 1. + i, i % 3);
+    }
+  }
+};
+
+// Tests that the reader sees the newest frame with all particle data
+TEST_F(SharedMemoryTest, LatestFrame) {
+  outputWriter::SharedMemoryWriter writer(name, pc.size(), 3);
+  SharedMemoryReader reader(name);
+  EXPECT_EQ(reader.published(), 0);
+  EXPECT_FALSE(reader.latestFrame().has_value());
+
+  // more frames than slots, the ring buffer wraps around
+  for (int iteration = 10; iteration <= 50; iteration += 10) {
+    pc[0].setX({1. * iteration, 0., 0.});
+    ASSERT_TRUE(writer.publish(pc, iteration));
+  }
+  EXPECT_EQ(reader.published(), 5);
+
+  const auto frame = reader.latestFrame();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->frame, 4);
+  EXPECT_EQ(frame->iteration, 50);
+  ASSERT_EQ(frame->particles.size(), pc.size());
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    EXPECT_EQ(frame->particles[i].getX(), pc[i].getX());
+    EXPECT_EQ(frame->particles[i].getV(), pc[i].getV());
+    EXPECT_EQ(frame->particles[i].getM(), pc[i].getM());
+    EXPECT_EQ(frame->particles[i].getType(), pc[i].getType());
+  }
+  EXPECT_FALSE(reader.finished());
+}
+
+// Tests that a view is no longer intact once the writer has reused its slot
+TEST_F(SharedMemoryTest, OverwrittenView) {
+  outputWriter::SharedMemoryWriter writer(name, pc.size(), 2);
+  SharedMemoryReader reader(name);
+  writer.publish(pc, 0);
+  const auto view = reader.latestView();
+  ASSERT_TRUE(view.has_value());
+  EXPECT_EQ(view->positions[3], 1.);
+  EXPECT_TRUE(reader.isIntact(*view));
+
+  writer.publish(pc, 1);
+  EXPECT_TRUE(reader.isIntact(*view));
+  writer.publish(pc, 2);
+  EXPECT_FALSE(reader.isIntact(*view));
+}
+
+// Tests that frames exceeding the capacity are dropped instead of published
+TEST_F(SharedMemoryTest, CapacityExceeded) {
+  outputWriter::SharedMemoryWriter writer(name, pc.size() - 1);
+  EXPECT_FALSE(writer.publish(pc, 0));
+  EXPECT_EQ(writer.getDropped(), 1);
+  SharedMemoryReader reader(name);
+  EXPECT_EQ(reader.published(), 0);
+}
+
+// Tests that the end of the stream is visible to attached readers and new readers cannot attach anymore
+TEST_F(SharedMemoryTest, Finished) {
+  auto writer = std::make_unique<outputWriter::SharedMemoryWriter>(name, pc.size());
+  SharedMemoryReader reader(name);
+  writer->publish(pc, 0);
+  writer.reset();
+  EXPECT_TRUE(reader.finished());
+  EXPECT_TRUE(reader.latestFrame().has_value());
+  EXPECT_THROW(SharedMemoryReader{name}, std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ForceCalc.h"
+#include "PairPotentials.h"
+#include "ParticleContainer.h"
+#include "TabulatedForce.h"
+
+class TabulatedForceTest : public ::testing::Test {
+ protected:
+  ParticleContainer pc;
+  const potentials::LennardJones lj{5., 1.};
+
+  // largest interpolation error relative to the largest force factor over the tabulated range
+  static double relativeError(const TabulatedForce& table, const potentials::LennardJones& lj, double rMin,
+                              double rCutoff) {
+    double maxError = 0;
+    double maxValue = 0;
+    for (int i = 0; i < 10000; i++) {
+      const double r = rMin + (rCutoff - rMin) * i / 10000.;
+      maxError = std::max(maxError, std::abs(table.interpolate(r * r) - lj.forceFactor(r * r)));
+      maxValue = std::max(maxValue, std::abs(lj.forceFactor(r * r)));
+    }
+    return maxError / maxValue;
+  }
+};
+
+// Tests that the interpolation error is small and decreases faster for cubic interpolation
+TEST_F(TabulatedForceTest, InterpolationError) {
+  const TabulatedForce linearCoarse(pc, lj, 0.8, 2.5, 1000, Interpolation::LINEAR);
+  const TabulatedForce linearFine(pc, lj, 0.8, 2.5, 4000, Interpolation::LINEAR);
+  const TabulatedForce cubicCoarse(pc, lj, 0.8, 2.5, 1000, Interpolation::CUBIC);
+  const TabulatedForce cubicFine(pc, lj, 0.8, 2.5, 4000, Interpolation::CUBIC);
+
+  EXPECT_LT(relativeError(linearFine, lj, 0.8, 2.5), relativeError(linearCoarse, lj, 0.8, 2.5) / 10.);
+  EXPECT_LT(relativeError(cubicFine, lj, 0.8, 2.5), relativeError(cubicCoarse, lj, 0.8, 2.5) / 30.);
+  EXPECT_LT(relativeError(cubicCoarse, lj, 0.8, 2.5), relativeError(linearCoarse, lj, 0.8, 2.5));
+  EXPECT_LT(relativeError(cubicFine, lj, 0.8, 2.5), 1e-6);
+}
+
+// Tests the tabulated forces against the analytic Lennard-Jones kernel on a small lattice
+TEST_F(TabulatedForceTest, MatchesLennardJonesForce) {
+  for (int x = 0; x < 4; x++) {
+    for (int y = 0; y < 4; y++) {
+      for (int z = 0; z < 2; z++) {
+        pc.addParticle({1.1225 * x + 0.01 * y, 1.1225 * y, 1.1225 * z + 0.02 * x}, {}, 1.);
+      }
+    }
+  }
+  ParticleContainer reference = pc;
+
+  TabulatedForce(pc, lj, 0.5, 2.5, 20000, Interpolation::CUBIC).calculateF();
+  LennardJonesForce(reference, lj.epsilon, lj.sigma, 2.5).calculateF();
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    for (std::size_t d = 0; d < 3; d++) {
+      EXPECT_NEAR(pc[i].getF()[d], reference[i].getF()[d], 1e-6);
+    }
+  }
+}
+
+// Tests that the smoothed Lennard-Jones force equals the plain one below r_l and vanishes continuously at r_c
+TEST_F(TabulatedForceTest, SmoothedLennardJones) {
+  const potentials::SmoothedLennardJones smoothed{5., 1., 1.9, 2.3};
+  EXPECT_DOUBLE_EQ(smoothed.forceFactor(1.5 * 1.5), lj.forceFactor(1.5 * 1.5));
+  EXPECT_EQ(smoothed.forceFactor(2.3 * 2.3), 0.);
+  EXPECT_NEAR(smoothed.forceFactor(2.2999 * 2.2999), 0., 1e-3);
+  EXPECT_NEAR(smoothed.forceFactor(1.9001 * 1.9001), lj.forceFactor(1.9001 * 1.9001), 1e-3);
+}
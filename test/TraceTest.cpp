@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <omp.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "utils/Trace.h"
+
+using namespace utils::trace;
+
+// Tests that a full buffer keeps the newest events in order
+TEST(TraceTest, RingBuffer) {
+  const auto buffer = std::make_unique<ThreadBuffer>(0, "test");
+  const std::int64_t n = ThreadBuffer::capacity + 10;
+  for (std::int64_t i = 0; i < n; i++) {
+    buffer->record({"event", i, i + 1});
+  }
+  const auto events = buffer->snapshot();
+  ASSERT_EQ(events.size(), ThreadBuffer::capacity);
+  EXPECT_EQ(buffer->dropped(), 10u);
+  EXPECT_EQ(events.front().begin, 10);
+  EXPECT_EQ(events.back().begin, n - 1);
+}
+
+// Tests that every thread records into its own buffer named by its OpenMP thread number
+TEST(TraceTest, ChromeTrace) {
+  reset();
+  // the main thread records outside of a parallel region first and still is OpenMP thread 0
+  { const Scope scope("TraceTest \"quoted\""); }
+  EXPECT_EQ(threadBuffer().getName(), "OpenMP thread 0");
+  EXPECT_EQ(threadBuffer().getId(), 0);
+#pragma omp parallel num_threads(2)
+  {
+    const Scope scope("TraceTest phase");
+    EXPECT_EQ(threadBuffer().getName(), "OpenMP thread " + std::to_string(omp_get_thread_num()));
+    EXPECT_EQ(threadBuffer().getId(), omp_get_thread_num());
+  }
+
+  std::ostringstream out;
+  writeChromeTrace(out);
+  const std::string json = out.str();
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find(R"("name":"TraceTest phase","ph":"X")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"TraceTest \"quoted\"")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"OpenMP thread 0"})"),
+            std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+// Tests that threads outside of OpenMP do not share a lane with the OpenMP threads
+TEST(TraceTest, OtherThreads) {
+  reset();
+  std::thread([] {
+    const Scope scope("TraceTest thread");
+    EXPECT_GE(threadBuffer().getId(), 1000);
+  }).join();
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "ParticleContainer.h"
+#include "analysis/TrajectoryIndex.h"
+#include "io/VTUWriter.h"
+
+class TrajectoryIndexTest : public ::testing::Test {
+ protected:
+  std::string directory = testing::TempDir() + "/molsim_trajectory_test";
+  ParticleContainer pc;
+
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+    for (int i = 0; i < 10; i++) {
+      pc.addParticle({1.0 * i, 0.0, 0.0}, {0.0, 0.0, 0.0}, 2.0);
+    }
+    // frame k: particle 3 moves with speed k, particle 0 is removed from frame 2 on
+    for (int k = 0; k < 4; k++) {
+      pc[3].setV({static_cast<double>(k), 0.0, 0.0});
+      pc[3].setX({3.0, 0.5 * k, 0.0});
+      if (k == 2) {
+        pc.removeParticle(0);
+      }
+      outputWriter::VTUWriter::plotParticles(pc, "MD_vtu", 10 * k, directory);
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+};
+
+// Tests the statistics of the frames and that they survive saving and loading
+TEST_F(TrajectoryIndexTest, BuildSaveLoad) {
+  const auto index = analysis::TrajectoryIndex::build(directory, 0.5);
+  index.save();
+  const auto loaded = analysis::TrajectoryIndex::load(directory);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(loaded->getFrames().size(), 4);
+  EXPECT_EQ(loaded->getTimeStep(), 0.5);
+  for (int k = 0; k < 4; k++) {
+    const auto& frame = loaded->getFrames()[k];
+    EXPECT_EQ(frame.iteration, 10 * k);
+    EXPECT_EQ(frame.time, 5.0 * k);
+    EXPECT_EQ(frame.particles, k < 2 ? 10 : 9);
+    EXPECT_EQ(frame.maxSpeed, k);
+    EXPECT_EQ(frame.kineticEnergy, k * k);
+    EXPECT_EQ(frame.lower[0], k < 2 ? 0.0 : 1.0);
+    EXPECT_EQ(frame.upper[1], 0.5 * k);
+    EXPECT_EQ(frame.file, index.getFrames()[k].file);
+    EXPECT_EQ(frame.idOffset, index.getFrames()[k].idOffset);
+  }
+  EXPECT_FALSE(analysis::TrajectoryIndex::load(directory + "/missing"));
+}
+
+// Tests that queries on the statistics select the matching frames
+TEST_F(TrajectoryIndexTest, Select) {
+  const auto index = analysis::TrajectoryIndex::build(directory, 1.0);
+  const auto fast = index.select("max_speed", ">", 1.5);
+  ASSERT_EQ(fast.size(), 2);
+  EXPECT_EQ(fast[0].iteration, 20);
+  EXPECT_EQ(index.select("particles", ">=", 10).size(), 2);
+  EXPECT_THROW(index.select("pressure", ">", 1), std::invalid_argument);
+  EXPECT_THROW(index.select("max_speed", "==", 1), std::invalid_argument);
+}
+
+// Tests that tracks follow particles by id, also after their storage index changed
+TEST_F(TrajectoryIndexTest, Track) {
+  const auto index = analysis::TrajectoryIndex::build(directory, 1.0);
+  // removing particle 0 moved the last particle (id 9) into its slot
+  const auto moved = index.track(9);
+  ASSERT_EQ(moved.size(), 4);
+  EXPECT_EQ(moved[3].x[0], 9.0);
+  const auto track = index.track(3);
+  ASSERT_EQ(track.size(), 4);
+  for (int k = 0; k < 4; k++) {
+    EXPECT_EQ(track[k].x[1], 0.5 * k);
+    EXPECT_EQ(track[k].v[0], k);
+  }
+  EXPECT_EQ(index.track(0).size(), 2);
+}
+
+// Tests that rebuilding indexes new and rewritten frames
+TEST_F(TrajectoryIndexTest, Update) {
+  const auto index = analysis::TrajectoryIndex::build(directory, 1.0);
+  outputWriter::VTUWriter::plotParticles(pc, "MD_vtu", 40, directory);
+  pc.addParticle({20.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 2.0);
+  outputWriter::VTUWriter::plotParticles(pc, "MD_vtu", 10, directory);
+  const auto updated = analysis::TrajectoryIndex::build(directory, 1.0, "MD_vtu", &index);
+  ASSERT_EQ(updated.getFrames().size(), 5);
+  EXPECT_EQ(updated.getFrames()[4].iteration, 40);
+  EXPECT_EQ(updated.getFrames()[1].particles, 10);
+  EXPECT_EQ(updated.getFrames()[1].upper[0], 20.0);
+  EXPECT_EQ(updated.getFrames()[0].maxSpeed, index.getFrames()[0].maxSpeed);
+}
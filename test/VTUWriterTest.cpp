@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+
+#include "ParticleContainer.h"
+#include "io/PartitionedVTUWriter.h"
+#include "io/VTUReader.h"
+#include "io/VTUWriter.h"
+
+class VTUWriterTest : public ::testing::Test {
+ protected:
+  std::string directory = testing::TempDir() + "/molsim_vtu_test";
+
+  void SetUp() override { std::filesystem::remove_all(directory); }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  static std::string readFile(const std::string& filename) {
+    std::ifstream file(filename);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+};
+
+// Tests that the piece ranges cover all particles without overlap and differ in size by at most one
+TEST_F(VTUWriterTest, PieceRanges) {
+  for (const std::size_t count : {0, 1, 7, 100, 101}) {
+    for (const int pieces : {1, 3, 8}) {
+      std::size_t next = 0;
+      for (int piece = 0; piece < pieces; piece++) {
+        const auto [first, size] = outputWriter::PartitionedVTUWriter::pieceRange(count, pieces, piece);
+        EXPECT_EQ(first, next);
+        EXPECT_LE(size, count / pieces + 1);
+        EXPECT_GE(size, count / pieces);
+        next = first + size;
+      }
+      EXPECT_EQ(next, count);
+    }
+  }
+}
+
+// Tests that every piece and the master file are written and reference each other
+TEST_F(VTUWriterTest, PartitionedOutput) {
+  ParticleContainer pc;
+  for (int i = 0; i < 10; i++) {
+    pc.addParticle({1. * i, 0., 0.}, {}, 1.);
+  }
+  outputWriter::PartitionedVTUWriter(3).plotParticles(pc, "MD", 20, directory);
+
+  const std::string master = readFile(directory + "/MD_0020.pvtu");
+  std::size_t points = 0;
+  for (int piece = 0; piece < 3; piece++) {
+    const std::string source = "MD_0020_" + std::to_string(piece) + ".vtu";
+    EXPECT_NE(master.find("<Piece Source=\"" + source + "\"/>"), std::string::npos);
+
+    std::smatch match;
+    const std::string content = readFile(directory + "/" + source);
+    ASSERT_TRUE(std::regex_search(content, match, std::regex("NumberOfPoints=\"(\\d+)\"")));
+    points += std::stoul(match[1]);
+  }
+  EXPECT_EQ(points, pc.size());
+  EXPECT_NE(master.find("Name=\"velocity\" NumberOfComponents=\"3\""), std::string::npos);
+
+  // the master file declares the byte order of its pieces
+  std::smatch order;
+  ASSERT_TRUE(std::regex_search(master, order, std::regex("byte_order=\"(\\w+)\"")));
+  EXPECT_NE(readFile(directory + "/MD_0020_0.vtu").find("byte_order=\"" + order[1].str() + "\""), std::string::npos);
+}
+
+// Tests that the raw appended blocks of a binary file contain the particle data at the offsets given in the header
+TEST_F(VTUWriterTest, AppendedBlocks) {
+  std::vector<Particle> particles;
+  for (int i = 0; i < 5; i++) {
+    particles.emplace_back(std::array<double, 3>{0.1 * i, 1.0 + i, -2.5}, std::array<double, 3>{1.0, -0.5 * i, 0.25},
+                           1.0 + i, i % 2);
+    particles.back().setF({2.0 * i, 0.0, -1.0});
+  }
+  std::filesystem::create_directories(directory);
+  const std::string filename = directory + "/appended.vtu";
+  ASSERT_TRUE(outputWriter::VTUWriter::writeAppended(particles.data(), particles.size(), filename));
+
+  const std::string content = readFile(filename);
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::size_t dataStart = content.find(marker);
+  ASSERT_NE(dataStart, std::string::npos);
+  const char* data = content.data() + dataStart + marker.size();
+  EXPECT_EQ(content.substr(content.size() - 11), "</VTKFile>\n");
+
+  // reads the block of the array whose DataArray tag contains the given attribute
+  const auto block = [&](const std::string& attribute) {
+    std::smatch match;
+    const std::regex tag("<DataArray[^>]*" + attribute + "[^>]*offset=\"(\\d+)\"/>");
+    EXPECT_TRUE(std::regex_search(content, match, tag)) << attribute;
+    const char* start = data + std::stoul(match[1]);
+    std::uint64_t bytes = 0;
+    std::memcpy(&bytes, start, sizeof(bytes));
+    return std::string(start + sizeof(bytes), bytes);
+  };
+
+  const std::string mass = block("Name=\"mass\"");
+  const std::string velocity = block("Name=\"velocity\"");
+  const std::string type = block("Name=\"type\"");
+  const std::string points = block("type=\"Float64\"");
+  ASSERT_EQ(mass.size(), particles.size() * sizeof(float));
+  ASSERT_EQ(velocity.size(), 3 * particles.size() * sizeof(float));
+  ASSERT_EQ(type.size(), particles.size() * sizeof(std::int32_t));
+  ASSERT_EQ(points.size(), 3 * particles.size() * sizeof(double));
+  EXPECT_TRUE(block("Name=\"connectivity\"").empty());
+
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    float m = 0;
+    std::int32_t t = 0;
+    std::memcpy(&m, mass.data() + i * sizeof(float), sizeof(float));
+    std::memcpy(&t, type.data() + i * sizeof(std::int32_t), sizeof(std::int32_t));
+    EXPECT_EQ(m, static_cast<float>(particles[i].getM()));
+    EXPECT_EQ(t, particles[i].getType());
+    for (std::size_t d = 0; d < 3; d++) {
+      float v = 0;
+      double x = 0;
+      std::memcpy(&v, velocity.data() + (3 * i + d) * sizeof(float), sizeof(float));
+      std::memcpy(&x, points.data() + (3 * i + d) * sizeof(double), sizeof(double));
+      EXPECT_EQ(v, static_cast<float>(particles[i].getV()[d]));
+      EXPECT_EQ(x, particles[i].getX()[d]);
+    }
+  }
+}
+
+// Tests that the reader restores the particles of a binary file and reads single tuples at their offsets
+TEST_F(VTUWriterTest, ReadBack) {
+  ParticleContainer pc;
+  for (int i = 0; i < 7; i++) {
+    pc.addParticle({0.1 * i, 1.0 + i, -2.5}, {1.0, -0.5 * i, 0.25}, 1.0 + i, i % 3);
+    pc[i].setF({2.0 * i, 0.0, -1.0});
+  }
+  pc.removeParticle(2);
+  std::filesystem::create_directories(directory);
+  const std::string filename = directory + "/readback.vtu";
+  ASSERT_TRUE(outputWriter::VTUWriter::writeAppended(&pc[0], pc.size(), filename));
+
+  const VTUReader reader(filename);
+  ASSERT_EQ(reader.size(), pc.size());
+  const auto particles = reader.readParticles();
+  for (std::size_t i = 0; i < pc.size(); i++) {
+    EXPECT_EQ(particles[i].getId(), pc[i].getId());
+    EXPECT_EQ(particles[i].getType(), pc[i].getType());
+    EXPECT_EQ(particles[i].getX(), pc[i].getX());
+    EXPECT_FLOAT_EQ(particles[i].getV()[1], pc[i].getV()[1]);
+    EXPECT_FLOAT_EQ(particles[i].getF()[0], pc[i].getF()[0]);
+  }
+  EXPECT_EQ(reader.readTuple(*reader.find("points"), 4), pc[4].getX());
+  EXPECT_EQ(reader.readTuple(*reader.find("id"), 2)[0], 6.0);
+  EXPECT_FALSE(reader.find("temperature"));
+  EXPECT_THROW(VTUReader(directory + "/missing.vtu"), std::runtime_error);
+}
+
+// Tests that ASCII and binary files contain the same point data arrays
+TEST_F(VTUWriterTest, AsciiMatchesAppendedArrays) {
+  ParticleContainer pc;
+  for (int i = 0; i < 3; i++) {
+    pc.addParticle({1. * i, 0., 0.}, {}, 1., i);
+  }
+  pc.removeParticle(0);
+  std::filesystem::create_directories(directory);
+  ASSERT_TRUE(outputWriter::VTUWriter::writeAscii(&pc[0], pc.size(), directory + "/ascii.vtu"));
+  ASSERT_TRUE(outputWriter::VTUWriter::writeAppended(&pc[0], pc.size(), directory + "/appended.vtu"));
+
+  const auto arrays = [](const std::string& content) {
+    std::string names;
+    const std::regex array("<DataArray type=\"(\\w+)\" Name=\"(\\w+)\" NumberOfComponents=\"(\\d)\"");
+    for (auto it = std::sregex_iterator(content.begin(), content.end(), array); it != std::sregex_iterator(); ++it) {
+      names += (*it)[1].str() + " " + (*it)[2].str() + " " + (*it)[3].str() + "\n";
+    }
+    return names;
+  };
+  const std::string ascii = readFile(directory + "/ascii.vtu");
+  EXPECT_EQ(arrays(ascii), arrays(readFile(directory + "/appended.vtu")));
+  EXPECT_NE(arrays(ascii).find("UInt64 id 1"), std::string::npos);
+  // the last particle was moved to the front
+  EXPECT_NE(ascii.find("Name=\"id\" NumberOfComponents=\"1\" format=\"ascii\">\n2\n1\n"), std::string::npos);
+}
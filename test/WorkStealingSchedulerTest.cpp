@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "utils/WorkStealingScheduler.h"
+
+// Tests that every task is executed exactly once, also with more threads than tasks
+TEST(WorkStealingSchedulerTest, ExecutesEveryTaskOnce) {
+  for (const int threads : {1, 2, 3, 8}) {
+    for (const std::size_t tasks : {0, 1, 5, 1000}) {
+      utils::WorkStealingScheduler scheduler(threads);
+      std::vector<std::atomic<int>> executed(tasks);
+      std::vector<utils::ThreadLoad> loads;
+      scheduler.run(
+          tasks,
+          [&](const std::size_t task, const int thread) {
+            EXPECT_GE(thread, 0);
+            EXPECT_LT(thread, threads);
+            executed[task]++;
+          },
+          &loads);
+
+      std::size_t counted = 0;
+      for (const auto& load : loads) {
+        counted += load.tasks;
+        EXPECT_GE(load.idleSeconds, 0.);
+      }
+      EXPECT_EQ(counted, tasks) << threads << " threads";
+      for (std::size_t task = 0; task < tasks; task++) {
+        EXPECT_EQ(executed[task], 1) << "task " << task << ", " << threads << " threads";
+      }
+    }
+  }
+}
+
+// Tests that the tasks of a slow thread are taken over by the other threads
+TEST(WorkStealingSchedulerTest, StealsFromBusyThread) {
+  utils::WorkStealingScheduler scheduler(2);
+  std::vector<utils::ThreadLoad> loads;
+  scheduler.run(
+      20,
+      [](const std::size_t task, int) {
+        // the first task, which belongs to thread 0, blocks it for a while
+        if (task == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+      },
+      &loads);
+  ASSERT_EQ(loads.size(), 2);
+  EXPECT_EQ(loads[0].tasks + loads[1].tasks, 20);
+  EXPECT_GT(loads[0].stolenTasks + loads[1].stolenTasks, 0);
+}
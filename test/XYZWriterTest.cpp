@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "ParticleContainer.h"
+#include "io/XYZWriter.h"
+
+class XYZWriterTest : public ::testing::Test {
+ protected:
+  std::string directory = testing::TempDir() + "/molsim_xyz_test";
+  ParticleContainer pc;
+
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+    pc.addParticle({0.1, -2.0, 1e-7}, {}, 1.);
+    pc.addParticle({1.0 / 3.0, 12345.678, -0.5}, {}, 1.);
+  }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+};
+
+// Tests that a formatted frame has the XYZ layout and that the positions read back exactly
+TEST_F(XYZWriterTest, FormatRoundTrip) {
+  std::string buffer;
+  outputWriter::XYZWriter::formatFrame(&pc[0], pc.size(), 42, buffer);
+
+  std::istringstream frame(buffer);
+  std::size_t count = 0;
+  std::string comment;
+  frame >> count;
+  std::getline(frame >> std::ws, comment);
+  EXPECT_EQ(count, pc.size());
+  EXPECT_EQ(comment, "Generated by MolSim, iteration 42");
+  for (const auto& p : pc) {
+    std::string element;
+    std::array<double, 3> x{};
+    frame >> element >> x[0] >> x[1] >> x[2];
+    EXPECT_EQ(element, "Ar");
+    EXPECT_EQ(x, p.getX());
+  }
+  EXPECT_EQ(buffer.back(), '\n');
+}
+
+// Tests that frames are appended to one file, also when it is reopened in append mode
+TEST_F(XYZWriterTest, AppendFrames) {
+  const std::string filename = directory + "/MD.xyz";
+  {
+    outputWriter::XYZWriter writer(filename);
+    ASSERT_TRUE(writer.appendFrame(pc, 10));
+    ASSERT_TRUE(writer.appendFrame(pc, 20));
+  }
+  {
+    outputWriter::XYZWriter writer(filename, true);
+    ASSERT_TRUE(writer.appendFrame(pc, 30));
+  }
+
+  std::ifstream file(filename);
+  std::string line;
+  std::size_t lines = 0;
+  std::size_t comments = 0;
+  while (std::getline(file, line)) {
+    lines++;
+    comments += line.rfind("Generated by MolSim", 0) == 0 ? 1 : 0;
+  }
+  EXPECT_EQ(comments, 3);
+  EXPECT_EQ(lines, 3 * (pc.size() + 2));
+
+  // without append, the file starts over
+  const auto threeFrames = std::filesystem::file_size(filename);
+  outputWriter::XYZWriter(filename).appendFrame(pc, 40);
+  EXPECT_EQ(3 * std::filesystem::file_size(filename), threeFrames);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file MolSimAnalyze.cpp
+ *
+ * Indexes the binary .vtu snapshots of a run and answers queries from the index: frames whose statistics exceed a
+ * threshold, and tracks of single particles that only read the particle's values from each snapshot.
+ */
+
+#include "analysis/TrajectoryIndex.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+void usage() {
+  SPDLOG_ERROR("Erroneous programme call!");
+  SPDLOG_ERROR("./MolSimAnalyze run_directory index [delta_t] [prefix]");
+  SPDLOG_ERROR("./MolSimAnalyze run_directory list");
+  SPDLOG_ERROR("./MolSimAnalyze run_directory where <statistic> <|<=|>|>= <value>");
+  SPDLOG_ERROR("./MolSimAnalyze run_directory track <particle id>");
+}
+
+void printFrames(const std::vector<analysis::FrameSummary>& frames) {
+  std::cout << "iteration\ttime";
+  for (const auto& field : analysis::TrajectoryIndex::fields()) {
+    if (field != "iteration" and field != "time") {
+      std::cout << '\t' << field;
+    }
+  }
+  std::cout << "\tfile\n";
+  for (const auto& frame : frames) {
+    std::cout << frame.iteration << '\t' << frame.time;
+    for (const auto& field : analysis::TrajectoryIndex::fields()) {
+      if (field != "iteration" and field != "time") {
+        std::cout << '\t' << analysis::TrajectoryIndex::value(frame, field);
+      }
+    }
+    std::cout << '\t' << frame.file << '\n';
+  }
+}
+}  // namespace
+
+int main(const int argc, char* argsv[]) {
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+  const std::string directory = argsv[1];
+  const std::string command = argsv[2];
+
+  try {
+    const auto index = analysis::TrajectoryIndex::load(directory);
+    if (command == "index" and argc <= 5) {
+      const double dt = argc > 3 ? std::stod(argsv[3]) : index ? index->getTimeStep() : 1.0;
+      const std::string prefix = argc > 4 ? argsv[4] : "MD_vtu";
+      const auto updated = analysis::TrajectoryIndex::build(directory, dt, prefix, index ? &*index : nullptr);
+      updated.save();
+      SPDLOG_INFO("Indexed {} frames in {}/{}", updated.getFrames().size(), directory,
+                  analysis::TrajectoryIndex::filename);
+      return 0;
+    }
+    if (not index) {
+      SPDLOG_ERROR("{} has no trajectory index, run ./MolSimAnalyze {} index first", directory, directory);
+      return 1;
+    }
+    if (command == "list" and argc == 3) {
+      printFrames(index->getFrames());
+    } else if (command == "where" and argc == 6) {
+      printFrames(index->select(argsv[3], argsv[4], std::stod(argsv[5])));
+    } else if (command == "track" and argc == 4) {
+      std::cout << "iteration\ttime\tx\ty\tz\tv_x\tv_y\tv_z\n";
+      for (const auto& point : index->track(std::stoul(argsv[3]))) {
+        std::cout << point.iteration << '\t' << point.time;
+        for (const double x : point.x) {
+          std::cout << '\t' << x;
+        }
+        for (const double v : point.v) {
+          std::cout << '\t' << v;
+        }
+        std::cout << '\n';
+      }
+    } else {
+      usage();
+      return 1;
+    }
+  } catch (const std::invalid_argument& err) {
+    SPDLOG_ERROR("{}", err.what());
+    return 1;
+  } catch (const std::runtime_error& err) {
+    SPDLOG_ERROR("{}", err.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file MolSimExport.cpp
+ *
+ * Converts a compressed snapshot file into one binary (or, with the ascii flag, human readable) .vtu file per frame.
+ */
+
+#include "io/CompressedReader.h"
+#include "io/VTUWriter.h"
+
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+int main(const int argc, char* argsv[]) {
+  const bool ascii = argc > 2 and std::string(argsv[argc - 1]) == "ascii";
+  const int positional = ascii ? argc - 1 : argc;
+  if (positional < 2 or positional > 3) {
+    SPDLOG_ERROR("Erroneous programme call!");
+    SPDLOG_ERROR("./MolSimExport compressed_file [output_prefix] [ascii]");
+    return 1;
+  }
+  const std::filesystem::path input(argsv[1]);
+  const std::string prefix = positional == 3 ? argsv[2] : (input.parent_path() / input.stem()).string();
+
+  try {
+    CompressedReader reader(input.string());
+    int frames = 0;
+    while (const auto frame = reader.nextFrame()) {
+      std::stringstream filename;
+      filename << prefix << "_" << std::setfill('0') << std::setw(4) << frame->iteration << ".vtu";
+      const auto& particles = frame->particles;
+      const bool written = ascii ? outputWriter::VTUWriter::writeAscii(particles, filename.str())
+                                 : outputWriter::VTUWriter::writeAppended(particles.data(), particles.size(),
+                                                                          filename.str());
+      if (not written) {
+        return 1;
+      }
+      frames++;
+    }
+    SPDLOG_INFO("Exported {} frames to {}_*.vtu", frames, prefix);
+  } catch (const std::runtime_error& err) {
+    SPDLOG_ERROR("{}", err.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file MolSimLive.cpp
+ *
+ * Follows the live output of a running simulation (OUTPUT:live) and keeps a .vtu file with its latest frame up to
+ * date, which ParaView shows on reload.
+ */
+
+#include "io/SharedMemoryReader.h"
+#include "io/VTUWriter.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+int main(const int argc, char* argsv[]) {
+  if (argc > 4) {
+    SPDLOG_ERROR("Erroneous programme call!");
+    SPDLOG_ERROR("./MolSimLive [stream_name] [poll_interval_ms] [output_file]");
+    return 1;
+  }
+  const std::string name = argc > 1 ? argsv[1] : "molsim";
+  int intervalMs = 200;
+  try {
+    intervalMs = argc > 2 ? std::stoi(argsv[2]) : intervalMs;
+  } catch (const std::logic_error&) {
+    intervalMs = 0;
+  }
+  if (intervalMs <= 0) {
+    SPDLOG_ERROR("Invalid poll interval: {}", argsv[2]);
+    return 1;
+  }
+  const std::string output = argc > 3 ? argsv[3] : name + "_live.vtu";
+  const auto interval = std::chrono::milliseconds(intervalMs);
+
+  // the simulation creates the stream with its first snapshot
+  std::unique_ptr<SharedMemoryReader> reader;
+  while (not reader) {
+    try {
+      reader = std::make_unique<SharedMemoryReader>(name);
+    } catch (const std::runtime_error& err) {
+      SPDLOG_DEBUG("{}", err.what());
+      std::this_thread::sleep_for(interval);
+    }
+  }
+  SPDLOG_INFO("Attached to live stream {}, writing the latest frame to {}", name, output);
+
+  std::uint64_t shown = 0;
+  std::uint64_t missed = 0;
+  while (true) {
+    const bool finished = reader->finished();
+    if (reader->published() > shown) {
+      if (const auto frame = reader->latestFrame()) {
+        missed += frame->frame - shown;
+        shown = frame->frame + 1;
+        outputWriter::VTUWriter::writeAppended(frame->particles.data(), frame->particles.size(), output);
+        SPDLOG_INFO("Iteration {}: {} particles", frame->iteration, frame->particles.size());
+      }
+    }
+    if (finished) {
+      break;
+    }
+    std::this_thread::sleep_for(interval);
+  }
+  SPDLOG_INFO("Simulation finished, showed {} frames and skipped {}", shown - missed, missed);
+  return 0;
+}